@@ -0,0 +1,117 @@
+/*
+MeetingMind Benchmark Handlers
+Runs the plugin's meeting event handlers against the libobs stub, with every
+feature enabled, for the benchmark and the trace replay driver
+*/
+
+#include "bench-handlers.hpp"
+
+#include "action-coalescer.hpp"
+#include "action-executor.hpp"
+#include "config-snapshot.hpp"
+#include "obs-stub.hpp"
+#include "plugin-config.hpp"
+#include "source-cache.hpp"
+
+namespace BenchHandlers {
+
+namespace {
+
+MeetingMindActions::ActionCoalescer coalescer;
+bool coalescing_enabled = false;
+
+void switch_to_scene(const char *scene)
+{
+    if (coalescing_enabled) {
+        coalescer.request_scene(scene);
+    } else {
+        MeetingMindActions::switch_scene(scene);
+    }
+}
+
+void set_source_mute(const char *source, bool muted)
+{
+    if (coalescing_enabled) {
+        coalescer.request_mute(source, muted);
+    } else {
+        MeetingMindActions::set_mute(source, muted);
+    }
+}
+
+// As in the plugin, outputs wait for the scene and audio requests before them
+void run_output_action(void (*action)())
+{
+    flush_coalesced();
+    action();
+}
+
+void publish_all_features()
+{
+    meetingmind_config config = {};
+    MeetingMindConfig::apply_default_config(&config);
+    config.auto_scene_switching = true;
+    config.auto_recording = true;
+    config.auto_start_streaming = true;
+    config.auto_stop_streaming = true;
+    config.audio_management = true;
+    config.meeting_notifications = true;
+    MeetingMindConfig::publish_snapshot(&config);
+    MeetingMindConfig::free_config_strings(&config);
+}
+
+} // namespace
+
+void setup_obs()
+{
+    for (const char *name : {SCENE_WELCOME, SCENE_PRESENTATION, SCENE_DISCUSSION, SCENE_SCREEN_SHARE, SCENE_BREAK,
+                             SCENE_ENDING, AUDIO_MICROPHONE, AUDIO_DESKTOP, AUDIO_MEETING}) {
+        MeetingMindObsStub::create_source(name);
+    }
+    obs_source_t *welcome = obs_get_source_by_name(SCENE_WELCOME);
+    obs_frontend_set_current_scene(welcome);
+    obs_source_release(welcome);
+
+    MeetingMindSourceCache::init();
+    MeetingMindActions::init_executor();
+    MeetingMindObsStub::emit_frontend_event(OBS_FRONTEND_EVENT_FINISHED_LOADING);
+
+    publish_all_features();
+    MeetingMindEvents::set_callbacks({switch_to_scene, set_source_mute, run_output_action, nullptr});
+}
+
+void shutdown_obs()
+{
+    MeetingMindActions::shutdown_executor();
+    MeetingMindSourceCache::shutdown();
+    MeetingMindObsStub::reset();
+}
+
+bool dispatch(std::string_view type, const MeetingMindJson::ObjectView &data)
+{
+    const MeetingMindEvents::Handler *handler = MeetingMindEvents::registry.find(type);
+    if (!handler) return false;
+    (*handler)(data);
+    return true;
+}
+
+void set_coalescing(bool enabled)
+{
+    coalescing_enabled = enabled;
+}
+
+bool coalescing()
+{
+    return coalescing_enabled;
+}
+
+void flush_coalesced()
+{
+    static const MeetingMindActions::ActionCoalescer::Callbacks callbacks = {
+        MeetingMindActions::switch_scene,
+        MeetingMindActions::set_mute,
+        MeetingMindActions::set_visibility,
+    };
+    coalescer.flush(callbacks);
+}
+
+} // namespace BenchHandlers
@@ -0,0 +1,42 @@
+/*
+MeetingMind Benchmark Handlers
+Runs the plugin's meeting event handlers against the libobs stub, with every
+feature enabled, for the benchmark and the trace replay driver
+*/
+
+#pragma once
+
+#include "event-parser.hpp"
+#include "meeting-handlers.hpp"
+
+#include <string_view>
+
+namespace BenchHandlers {
+
+using MeetingMindEvents::SCENE_WELCOME;
+using MeetingMindEvents::SCENE_PRESENTATION;
+using MeetingMindEvents::SCENE_DISCUSSION;
+using MeetingMindEvents::SCENE_SCREEN_SHARE;
+using MeetingMindEvents::SCENE_BREAK;
+using MeetingMindEvents::SCENE_ENDING;
+
+using MeetingMindEvents::AUDIO_MICROPHONE;
+using MeetingMindEvents::AUDIO_DESKTOP;
+using MeetingMindEvents::AUDIO_MEETING;
+
+// Creates the plugin's scenes and audio sources in the libobs stub, makes
+// the welcome scene current, starts the source cache and executor and
+// publishes a config with every handler feature turned on
+void setup_obs();
+void shutdown_obs();
+
+// Runs the handler registered for type. Returns false for unknown types.
+bool dispatch(std::string_view type, const MeetingMindJson::ObjectView &data);
+
+// While coalescing, scene and audio requests are collected until
+// flush_coalesced(), as in the plugin with a coalescing window configured
+void set_coalescing(bool enabled);
+bool coalescing();
+void flush_coalesced();
+
+} // namespace BenchHandlers
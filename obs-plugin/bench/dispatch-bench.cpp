@@ -0,0 +1,86 @@
+/*
+MeetingMind Dispatch Benchmark
+Compares perfect-hash event dispatch against a linear chain of string
+comparisons as the number of registered event types grows
+*/
+
+#include "event-registry.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace MeetingMindDispatch;
+
+static volatile uint64_t sink = 0;
+
+static void count_event(uint64_t id)
+{
+    sink = sink + id;
+}
+
+using BenchHandler = void (*)(uint64_t);
+
+static constexpr int LOOKUPS = 1 << 22;
+
+template <std::size_t N>
+static void run_size()
+{
+    // Realistic event names share a long common prefix, which is the worst
+    // case for the linear chain
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < N; i++) {
+        names.push_back("meeting_event_type_" + std::to_string(i));
+    }
+
+    HashEntry<BenchHandler> entries[N];
+    for (std::size_t i = 0; i < N; i++) {
+        entries[i] = {names[i], &count_event};
+    }
+    const auto table = make_perfect_hash_map(entries);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> pick(0, N - 1);
+    std::vector<std::string_view> workload(4096);
+    for (auto &name : workload) name = names[pick(rng)];
+
+    using clock = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        std::string_view name = workload[i & 4095];
+        if (const BenchHandler *handler = table.find(name)) (*handler)(i);
+    }
+    const double hash_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / LOOKUPS;
+
+    start = clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        std::string_view name = workload[i & 4095];
+        for (std::size_t e = 0; e < N; e++) {
+            if (entries[e].key == name) {
+                entries[e].value(i);
+                break;
+            }
+        }
+    }
+    const double linear_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / LOOKUPS;
+
+    printf("%6zu event types   perfect-hash %7.2f ns/event   linear %8.2f ns/event\n",
+           N, hash_ns, linear_ns);
+}
+
+template <std::size_t... Sizes>
+static void run_sizes(std::index_sequence<Sizes...>)
+{
+    (run_size<(std::size_t(8) << Sizes)>(), ...);
+}
+
+int main()
+{
+    printf("MeetingMind dispatch benchmark (%d lookups per size)\n", LOOKUPS);
+    run_sizes(std::make_index_sequence<8>());
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+MeetingMind Fake Backend
+Command-line runner: serves a schedule to whichever plugin connects, then
+summarizes what the plugin sent back
+*/
+
+#include "fake-backend.hpp"
+
+#include "latency-histogram.hpp"
+
+#include <QCoreApplication>
+#include <QTimer>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+using MeetingMindLatency::LatencyHistogram;
+
+struct Options {
+    MeetingMindFakeBackend::Options backend;
+    const char *schedule_path = nullptr;
+    const char *record_path = nullptr;
+    int linger_ms = 2000;
+};
+
+static bool parse_options(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (!strcmp(arg, "--msgpack")) {
+            options.backend.offer_msgpack = true;
+            continue;
+        }
+        if (!strcmp(arg, "--no-resume")) {
+            options.backend.resume_sessions = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        const char *value = argv[++i];
+
+        if (!strcmp(arg, "--port")) options.backend.port = (quint16)strtoul(value, nullptr, 10);
+        else if (!strcmp(arg, "--api-key")) options.backend.api_key = value;
+        else if (!strcmp(arg, "--schedule")) options.schedule_path = value;
+        else if (!strcmp(arg, "--record")) options.record_path = value;
+        else if (!strcmp(arg, "--linger-ms")) options.linger_ms = atoi(value);
+        else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void print_summary(const MeetingMindFakeBackend &backend)
+{
+    // Replies are timed from the last event the backend sent, which is the
+    // round trip for the event that caused them
+    std::map<std::string, LatencyHistogram> replies;
+    std::map<std::string, size_t> counts;
+    for (const FakeBackendMessage &received : backend.received()) {
+        QString type = received.message["type"].toString();
+        if (type == "obs_event") type += "/" + received.message["data"].toObject()["event"].toString();
+        const std::string key = type.toStdString();
+        counts[key]++;
+        if (received.since_event_ns >= 0) replies[key].record((uint64_t)received.since_event_ns);
+    }
+
+    printf("%d connections, %llu events sent, %zu messages received\n", backend.connections(),
+           (unsigned long long)backend.events_sent(), backend.received().size());
+    for (const auto &entry : counts) {
+        printf("  %-34s %6zu", entry.first.c_str(), entry.second);
+        auto reply = replies.find(entry.first);
+        if (reply != replies.end()) {
+            printf("  after event p50 %8.2f ms  p99 %8.2f ms", reply->second.percentile(0.50) / 1e6,
+                   reply->second.percentile(0.99) / 1e6);
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        fprintf(stderr,
+                "usage: %s [--port N] [--api-key KEY] [--schedule FILE] [--record FILE]\n"
+                "          [--msgpack] [--no-resume] [--linger-ms N]\n",
+                argv[0]);
+        return 2;
+    }
+
+    MeetingMindFakeBackend backend(options.backend);
+
+    if (options.schedule_path) {
+        std::vector<FakeBackendStep> steps;
+        QString error;
+        if (!MeetingMindFakeBackend::load_schedule(options.schedule_path, steps, &error)) {
+            fprintf(stderr, "%s\n", error.toUtf8().constData());
+            return 1;
+        }
+        backend.set_schedule(std::move(steps));
+
+        // Leave time for the plugin's last replies, then stop
+        QObject::connect(&backend, &MeetingMindFakeBackend::schedule_finished, &app,
+                         [&]() { QTimer::singleShot(options.linger_ms, &app, &QCoreApplication::quit); });
+    }
+
+    if (options.record_path && !backend.record_to(options.record_path)) {
+        fprintf(stderr, "Cannot write %s\n", options.record_path);
+        return 1;
+    }
+    if (!backend.listen()) {
+        fprintf(stderr, "Cannot listen on port %u\n", options.backend.port);
+        return 1;
+    }
+    printf("MeetingMind fake backend on ws://127.0.0.1:%u/ws\n", backend.port());
+    fflush(stdout);
+
+    QObject::connect(&backend, &MeetingMindFakeBackend::client_subscribed, &app, [](bool resumed) {
+        printf("plugin subscribed%s\n", resumed ? " (resumed)" : "");
+        fflush(stdout);
+    });
+
+    app.exec();
+    print_summary(backend);
+    return 0;
+}
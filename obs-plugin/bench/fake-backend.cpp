@@ -0,0 +1,410 @@
+/*
+MeetingMind Fake Backend
+Local stand-in for the MeetingMind server: serves /api/health and the /ws
+event protocol on one port, plays a scripted event schedule and records
+what the plugin sends back, and when
+*/
+
+#include "fake-backend.hpp"
+
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Largest request head accepted before the connection is dropped
+const qint64 MAX_HTTP_HEAD = 16 * 1024;
+
+void put_be(QByteArray &out, uint64_t value, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; i--) out.append((char)(value >> (8 * i)));
+}
+
+// Encodes a JSON value as MessagePack, in the subset PROTOCOL.md allows
+void encode_msgpack(QByteArray &out, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        out.append((char)0xc0);
+        break;
+    case QJsonValue::Bool:
+        out.append((char)(value.toBool() ? 0xc3 : 0xc2));
+        break;
+    case QJsonValue::Double: {
+        const double number = value.toDouble();
+        if (number == std::floor(number) && std::fabs(number) < 9.0e15) {
+            const int64_t integer = (int64_t)number;
+            if (integer >= 0 && integer < 128) {
+                out.append((char)integer);
+            } else {
+                out.append((char)0xd3);
+                put_be(out, (uint64_t)integer, 8);
+            }
+        } else {
+            uint64_t bits;
+            memcpy(&bits, &number, sizeof(bits));
+            out.append((char)0xcb);
+            put_be(out, bits, 8);
+        }
+        break;
+    }
+    case QJsonValue::String: {
+        const QByteArray text = value.toString().toUtf8();
+        out.append((char)0xdb);
+        put_be(out, (uint64_t)text.size(), 4);
+        out.append(text);
+        break;
+    }
+    case QJsonValue::Array: {
+        const QJsonArray array = value.toArray();
+        out.append((char)0xdd);
+        put_be(out, (uint64_t)array.size(), 4);
+        for (const QJsonValue &item : array) encode_msgpack(out, item);
+        break;
+    }
+    case QJsonValue::Object: {
+        const QJsonObject object = value.toObject();
+        out.append((char)0xdf);
+        put_be(out, (uint64_t)object.size(), 4);
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            encode_msgpack(out, it.key());
+            encode_msgpack(out, it.value());
+        }
+        break;
+    }
+    }
+}
+
+// Returns the value of a request header, matched case-insensitively
+QByteArray header_value(const QByteArray &head, const QByteArray &name)
+{
+    for (const QByteArray &line : head.split('\n')) {
+        const int colon = line.indexOf(':');
+        if (colon > 0 && line.left(colon).trimmed().toLower() == name) {
+            return line.mid(colon + 1).trimmed();
+        }
+    }
+    return QByteArray();
+}
+
+void reply_http(QTcpSocket *socket, const char *status, const QByteArray &body)
+{
+    QByteArray response = QByteArray("HTTP/1.1 ") + status + "\r\n";
+    response += "Content-Type: application/json\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+} // namespace
+
+MeetingMindFakeBackend::MeetingMindFakeBackend(const Options &options, QObject *parent)
+    : QObject(parent),
+      options(options),
+      tcp_server(new QTcpServer(this)),
+      websocket_server(new QWebSocketServer("MeetingMind fake backend", QWebSocketServer::NonSecureMode, this)),
+      client(nullptr),
+      schedule_timer(new QTimer(this)),
+      session_count(0),
+      subscribed(false),
+      use_msgpack(false),
+      next_seq(1),
+      schedule_index(0),
+      schedule_start_ns(-1),
+      refuse_until_ns(0),
+      last_event_ns(-1),
+      sent_count(0),
+      connection_count(0)
+{
+    schedule_timer->setSingleShot(true);
+    schedule_timer->setTimerType(Qt::PreciseTimer);
+    connect(schedule_timer, &QTimer::timeout, this, &MeetingMindFakeBackend::run_schedule);
+    connect(tcp_server, &QTcpServer::newConnection, this, &MeetingMindFakeBackend::on_tcp_connection);
+    connect(websocket_server, &QWebSocketServer::newConnection, this,
+            &MeetingMindFakeBackend::on_websocket_connection);
+}
+
+MeetingMindFakeBackend::~MeetingMindFakeBackend()
+{
+    if (client) client->abort();
+}
+
+bool MeetingMindFakeBackend::listen()
+{
+    clock.start();
+    return tcp_server->listen(QHostAddress::LocalHost, options.port);
+}
+
+quint16 MeetingMindFakeBackend::port() const
+{
+    return tcp_server->serverPort();
+}
+
+bool MeetingMindFakeBackend::load_schedule(const QString &path, std::vector<FakeBackendStep> &steps, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = QString("Cannot open %1").arg(path);
+        return false;
+    }
+
+    int line_number = 0;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        line_number++;
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        const QJsonObject obj = QJsonDocument::fromJson(line).object();
+        FakeBackendStep step;
+        step.at_ms = obj["at_ms"].toVariant().toLongLong();
+        step.disconnect = obj["disconnect"].toBool();
+        step.refuse_ms = obj["refuse_ms"].toVariant().toLongLong();
+        step.message = obj["send"].toObject();
+        if (!step.disconnect && !step.message["type"].isString()) {
+            if (error) *error = QString("%1:%2: expected \"send\" with a type, or \"disconnect\"").arg(path).arg(line_number);
+            return false;
+        }
+        steps.push_back(step);
+    }
+
+    std::stable_sort(steps.begin(), steps.end(),
+                     [](const FakeBackendStep &a, const FakeBackendStep &b) { return a.at_ms < b.at_ms; });
+    return true;
+}
+
+void MeetingMindFakeBackend::set_schedule(std::vector<FakeBackendStep> steps)
+{
+    schedule = std::move(steps);
+    schedule_index = 0;
+    schedule_start_ns = -1;
+    schedule_timer->stop();
+}
+
+bool MeetingMindFakeBackend::record_to(const QString &path)
+{
+    record_file.setFileName(path);
+    return record_file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+}
+
+void MeetingMindFakeBackend::send_event(QJsonObject message)
+{
+    if (message["seq"].isDouble()) {
+        next_seq = std::max<uint64_t>(next_seq, (uint64_t)message["seq"].toDouble() + 1);
+    } else {
+        message["seq"] = (qint64)next_seq++;
+    }
+    history.push_back(message);
+
+    if (client && subscribed) deliver(message);
+}
+
+void MeetingMindFakeBackend::drop_connection(int64_t refuse_ms)
+{
+    refuse_until_ns = now_ns() + refuse_ms * 1000000;
+    if (client) client->abort();
+}
+
+void MeetingMindFakeBackend::on_tcp_connection()
+{
+    while (QTcpSocket *socket = tcp_server->nextPendingConnection()) {
+        if (now_ns() < refuse_until_ns) {
+            socket->abort();
+            socket->deleteLater();
+            continue;
+        }
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { on_http_data(socket); });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void MeetingMindFakeBackend::on_http_data(QTcpSocket *socket)
+{
+    // Peek so that a WebSocket upgrade can be handed over with its request
+    // still unread
+    const QByteArray head = socket->peek(MAX_HTTP_HEAD);
+    const int end = head.indexOf("\r\n\r\n");
+    if (end < 0) {
+        if (head.size() >= MAX_HTTP_HEAD) socket->abort();
+        return;
+    }
+
+    const QList<QByteArray> request_line = head.left(head.indexOf("\r\n")).split(' ');
+    const QByteArray path = request_line.size() >= 2 ? request_line[1] : QByteArray();
+
+    if (!options.api_key.isEmpty() && header_value(head, "authorization") != "Bearer " + options.api_key) {
+        socket->read(end + 4);
+        reply_http(socket, "401 Unauthorized", "{\"detail\":\"invalid api key\"}");
+        return;
+    }
+
+    if (path == "/ws" && header_value(head, "upgrade").toLower() == "websocket") {
+        disconnect(socket, nullptr, this, nullptr);
+        disconnect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        websocket_server->handleConnection(socket);
+        return;
+    }
+
+    socket->read(end + 4);
+    if (path == "/api/health") {
+        reply_http(socket, "200 OK", "{\"status\":\"healthy\"}");
+    } else {
+        reply_http(socket, "404 Not Found", "{\"detail\":\"not found\"}");
+    }
+}
+
+void MeetingMindFakeBackend::on_websocket_connection()
+{
+    while (QWebSocket *socket = websocket_server->nextPendingConnection()) {
+        // One plugin at a time; a reconnect may beat the old socket's close
+        if (client) {
+            client->disconnect(this);
+            client->abort();
+            client->deleteLater();
+        }
+        client = socket;
+        subscribed = false;
+        connection_count++;
+
+        connect(client, &QWebSocket::textMessageReceived, this, &MeetingMindFakeBackend::on_text_message);
+        connect(client, &QWebSocket::disconnected, this, &MeetingMindFakeBackend::on_client_disconnected);
+
+        QJsonObject entry;
+        entry["connection"] = "opened";
+        record(entry);
+    }
+}
+
+void MeetingMindFakeBackend::on_client_disconnected()
+{
+    QWebSocket *socket = qobject_cast<QWebSocket *>(sender());
+    if (socket != client) return;
+
+    client->deleteLater();
+    client = nullptr;
+    subscribed = false;
+
+    QJsonObject entry;
+    entry["connection"] = "closed";
+    record(entry);
+}
+
+void MeetingMindFakeBackend::on_text_message(const QString &text)
+{
+    const QJsonObject message = QJsonDocument::fromJson(text.toUtf8()).object();
+
+    FakeBackendMessage received;
+    received.received_ns = now_ns();
+    received.since_event_ns = last_event_ns >= 0 ? received.received_ns - last_event_ns : -1;
+    received.last_seq = next_seq - 1;
+    received.message = message;
+    received_messages.push_back(received);
+
+    QJsonObject entry;
+    entry["since_event_ms"] = received.since_event_ns >= 0 ? received.since_event_ns / 1e6 : QJsonValue();
+    entry["last_seq"] = (qint64)received.last_seq;
+    entry["message"] = message;
+    record(entry);
+
+    if (message["type"].toString() == "subscribe") {
+        handle_subscribe(message);
+    }
+    emit message_received(message);
+}
+
+void MeetingMindFakeBackend::handle_subscribe(const QJsonObject &message)
+{
+    const QString requested_session = message["session_id"].toString();
+    const bool resumed = options.resume_sessions && !requested_session.isEmpty() && requested_session == session_id;
+
+    if (!resumed) {
+        session_id = QString("s_%1").arg(++session_count);
+        history.clear();
+        next_seq = 1;
+    }
+
+    use_msgpack = false;
+    if (options.offer_msgpack) {
+        for (const QJsonValue &encoding : message["encodings"].toArray()) {
+            if (encoding.toString() == "msgpack") use_msgpack = true;
+        }
+    }
+
+    QJsonObject data;
+    data["encoding"] = use_msgpack ? "msgpack" : "json";
+    data["session_id"] = session_id;
+    data["resumed"] = resumed;
+    QJsonObject reply;
+    reply["type"] = "subscribed";
+    reply["data"] = data;
+    client->sendTextMessage(QString::fromUtf8(QJsonDocument(reply).toJson(QJsonDocument::Compact)));
+    subscribed = true;
+
+    // Replay whatever the plugin missed while it was away
+    if (resumed) {
+        const uint64_t last_seq = (uint64_t)message["last_seq"].toVariant().toULongLong();
+        for (const QJsonObject &event : history) {
+            if ((uint64_t)event["seq"].toDouble() > last_seq) deliver(event);
+        }
+    }
+
+    emit client_subscribed(resumed);
+
+    if (schedule_start_ns < 0 && !schedule.empty()) {
+        schedule_start_ns = now_ns();
+        run_schedule();
+    }
+}
+
+void MeetingMindFakeBackend::deliver(const QJsonObject &event)
+{
+    if (use_msgpack) {
+        QByteArray frame;
+        encode_msgpack(frame, event);
+        client->sendBinaryMessage(frame);
+    } else {
+        client->sendTextMessage(QString::fromUtf8(QJsonDocument(event).toJson(QJsonDocument::Compact)));
+    }
+    last_event_ns = now_ns();
+    sent_count++;
+}
+
+void MeetingMindFakeBackend::run_schedule()
+{
+    const int64_t elapsed_ms = (now_ns() - schedule_start_ns) / 1000000;
+    while (schedule_index < schedule.size() && schedule[schedule_index].at_ms <= elapsed_ms) {
+        const FakeBackendStep &step = schedule[schedule_index++];
+        if (step.disconnect) {
+            drop_connection(step.refuse_ms);
+        } else {
+            send_event(step.message);
+        }
+    }
+
+    if (schedule_index < schedule.size()) {
+        schedule_timer->start((int)(schedule[schedule_index].at_ms - elapsed_ms));
+    } else {
+        emit schedule_finished();
+    }
+}
+
+void MeetingMindFakeBackend::record(QJsonObject entry)
+{
+    if (!record_file.isOpen()) return;
+    entry["t_ms"] = now_ns() / 1e6;
+    record_file.write(QJsonDocument(entry).toJson(QJsonDocument::Compact));
+    record_file.write("\n");
+    record_file.flush();
+}
@@ -0,0 +1,126 @@
+/*
+MeetingMind Fake Backend
+Local stand-in for the MeetingMind server: serves /api/health and the /ws
+event protocol on one port, plays a scripted event schedule and records
+what the plugin sends back, and when
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <cstdint>
+#include <vector>
+
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+class QWebSocket;
+class QWebSocketServer;
+
+// One line of a schedule file. Times count from the first subscribe.
+//   {"at_ms": 250, "send": {"type": "presentation_started", "data": {}}}
+//   {"at_ms": 900, "disconnect": true, "refuse_ms": 3000}
+// Sent events are numbered with "seq" unless they carry one already.
+struct FakeBackendStep {
+    int64_t at_ms = 0;
+    bool disconnect = false;
+    int64_t refuse_ms = 0;
+    QJsonObject message;
+};
+
+// A message from the plugin. Times are nanoseconds since listen();
+// since_event_ns is measured from the last event the backend sent, or -1
+// if none has been sent yet.
+struct FakeBackendMessage {
+    int64_t received_ns = 0;
+    int64_t since_event_ns = -1;
+    uint64_t last_seq = 0;
+    QJsonObject message;
+};
+
+class MeetingMindFakeBackend : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        quint16 port = 8080;
+        QByteArray api_key;        // Required as a bearer token when set
+        bool offer_msgpack = false; // Accept the plugin's msgpack encoding
+        bool resume_sessions = true;
+    };
+
+    explicit MeetingMindFakeBackend(const Options &options, QObject *parent = nullptr);
+    ~MeetingMindFakeBackend();
+
+    // Listens on the loopback interface only
+    bool listen();
+    quint16 port() const;
+
+    static bool load_schedule(const QString &path, std::vector<FakeBackendStep> &steps, QString *error);
+    void set_schedule(std::vector<FakeBackendStep> steps);
+
+    // Appends every connection change and plugin message as a JSON line
+    bool record_to(const QString &path);
+
+    // Numbers the event, keeps it for resumes and sends it if a subscribed
+    // client is connected
+    void send_event(QJsonObject message);
+
+    // Drops the client without a close handshake, as a network failure
+    // would, and refuses new connections for refuse_ms
+    void drop_connection(int64_t refuse_ms);
+
+    const std::vector<FakeBackendMessage> &received() const { return received_messages; }
+    uint64_t events_sent() const { return sent_count; }
+    int connections() const { return connection_count; }
+
+signals:
+    void client_subscribed(bool resumed);
+    void message_received(const QJsonObject &message);
+    void schedule_finished();
+
+private:
+    void on_tcp_connection();
+    void on_http_data(QTcpSocket *socket);
+    void on_websocket_connection();
+    void on_text_message(const QString &message);
+    void on_client_disconnected();
+    void handle_subscribe(const QJsonObject &message);
+    void deliver(const QJsonObject &event);
+    void run_schedule();
+    void record(QJsonObject entry);
+    int64_t now_ns() const { return clock.nsecsElapsed(); }
+
+    Options options;
+    QTcpServer *tcp_server;
+    QWebSocketServer *websocket_server;
+    QWebSocket *client;
+    QTimer *schedule_timer;
+    QElapsedTimer clock;
+    QFile record_file;
+
+    // Session state. history holds every numbered event of the session so
+    // that a resume can replay the ones the plugin missed.
+    QString session_id;
+    int session_count;
+    bool subscribed;
+    bool use_msgpack;
+    uint64_t next_seq;
+    std::vector<QJsonObject> history;
+
+    std::vector<FakeBackendStep> schedule;
+    size_t schedule_index;
+    int64_t schedule_start_ns;
+    int64_t refuse_until_ns;
+
+    std::vector<FakeBackendMessage> received_messages;
+    int64_t last_event_ns;
+    uint64_t sent_count;
+    int connection_count;
+};
@@ -0,0 +1,940 @@
+/*
+MeetingMind Headless Benchmark
+Drives the plugin's event dispatch, action and configuration paths against
+the libobs stub, reports throughput and latency, and fails when a behaviour
+the numbers stand for no longer holds
+*/
+
+#include "bench-handlers.hpp"
+
+#include "action-executor.hpp"
+#include "audio-meter.hpp"
+#include "audio-tap.hpp"
+#include "auto-director.hpp"
+#include "config-writer.hpp"
+#include "event-parser.hpp"
+#include "jitter-buffer.hpp"
+#include "latency-histogram.hpp"
+#include "obs-stub.hpp"
+#include "plugin-config.hpp"
+#include "recording-index.hpp"
+#include "source-cache.hpp"
+#include "trace-file.hpp"
+#include "voice-activity.hpp"
+
+#include <util/config-file.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using MeetingMindLatency::LatencyHistogram;
+
+using namespace BenchHandlers;
+
+struct Options {
+    size_t events = 200000;
+    size_t coalesce_every = 0;
+    size_t config_iterations = 2000;
+    const char *trace_path = nullptr;
+    MeetingMindObsStub::Costs costs;
+};
+
+// Behaviours each section must show; any failure fails the run
+static size_t failed_checks = 0;
+
+static void check(bool ok, const char *claim)
+{
+    printf("  %s %s\n", ok ? "ok    " : "FAILED", claim);
+    if (!ok) failed_checks++;
+}
+
+// A meeting-shaped mix: mostly participant churn and scene/audio requests,
+// with the occasional lifecycle event
+static std::vector<std::string> make_frames(size_t count)
+{
+    static const char *const templates[] = {
+        R"({"type":"participant_joined","seq":%zu,"data":{"name":"Participant %zu"}})",
+        R"({"type":"participant_left","seq":%zu,"data":{"name":"Participant %zu"}})",
+        R"({"type":"scene_change_requested","seq":%zu,"data":{"scene":"Meeting - Discussion","n":%zu}})",
+        R"({"type":"scene_change_requested","seq":%zu,"data":{"scene":"Meeting - Presentation","n":%zu}})",
+        R"({"type":"audio_mute_requested","seq":%zu,"data":{"source":"Meeting Audio","n":%zu}})",
+        R"({"type":"audio_unmute_requested","seq":%zu,"data":{"source":"Meeting Audio","n":%zu}})",
+        R"({"type":"presentation_started","seq":%zu,"data":{"slide":%zu}})",
+        R"({"type":"presentation_ended","seq":%zu,"data":{"slide":%zu}})",
+        R"({"type":"screen_share_started","seq":%zu,"data":{"n":%zu}})",
+        R"({"type":"screen_share_ended","seq":%zu,"data":{"n":%zu}})",
+        R"({"type":"break_started","seq":%zu,"data":{"n":%zu}})",
+        R"({"type":"break_ended","seq":%zu,"data":{"n":%zu}})",
+        R"({"type":"recording_requested","seq":%zu,"data":{"n":%zu}})",
+        R"({"type":"meeting_started","seq":%zu,"data":{"n":%zu}})",
+    };
+    static const unsigned weights[] = {20, 18, 12, 12, 8, 8, 5, 5, 3, 3, 2, 2, 1, 1};
+
+    std::mt19937 rng(7);
+    std::discrete_distribution<size_t> pick(std::begin(weights), std::end(weights));
+
+    std::vector<std::string> frames;
+    frames.reserve(count);
+    char buffer[256];
+    for (size_t i = 0; i < count; i++) {
+        snprintf(buffer, sizeof(buffer), templates[pick(rng)], i + 1, i % 97);
+        frames.emplace_back(buffer);
+    }
+    return frames;
+}
+
+// Writes the frames as a trace for meetingmind-trace-replay, arriving at
+// random with a mean gap of 10 ms
+static bool write_trace(const char *path, const std::vector<std::string> &frames)
+{
+    MeetingMindTrace::TraceWriter writer;
+    if (!writer.open(path)) return false;
+
+    std::mt19937 rng(11);
+    std::exponential_distribution<double> gap_ms(1.0 / 10.0);
+    uint64_t arrival_ns = 0;
+    for (const std::string &frame : frames) {
+        if (!writer.append(arrival_ns, false, frame.data(), frame.size())) return false;
+        arrival_ns += (uint64_t)(gap_ms(rng) * 1e6);
+    }
+    writer.close();
+    printf("wrote %zu frames to %s\n", frames.size(), path);
+    return true;
+}
+
+static void print_latency(const char *label, const LatencyHistogram &histogram)
+{
+    printf("  %-22s p50 %8.2f us  p99 %8.2f us  max %9.2f us\n", label,
+           histogram.percentile(0.50) / 1000.0, histogram.percentile(0.99) / 1000.0, histogram.max() / 1000.0);
+}
+
+// Frames the parser must accept and reject; the escaped one sits across a
+// 64-byte block boundary so the carried escape state is covered too
+static void run_parser()
+{
+    static const char *const accepted[] = {
+        "{}",
+        "{\"a\":0}",
+        "{\"a\":-0.5e+10}",
+        "{\"a\":12.25E-3,\"b\":[1,{\"c\":\"\\u00e9\"}]}",
+        "{\"a\":\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"}",
+        "{\"padding\":\"...........................................\",\"a\":\"x\\ny\"}",
+    };
+    static const char *const rejected[] = {
+        "{\"a\":-}",
+        "{\"a\":1-2}",
+        "{\"a\":1e}",
+        "{\"a\":01}",
+        "{\"a\":1.}",
+        "{\"a\":.5}",
+        "{\"a\":\"\\q\"}",
+        "{\"a\":\"\\u12g4\"}",
+        "{\"a\":\"tab\there\"}",
+        "{\"a\":[\"\\x\"]}",
+        "{\"a\":[\"new\nline\"]}",
+        "{\"a\":[1,\\2]}",
+    };
+
+    size_t accepted_ok = 0;
+    for (const char *frame : accepted) {
+        MeetingMindJson::ObjectView view;
+        if (view.parse(frame)) accepted_ok++;
+    }
+    size_t rejected_ok = 0;
+    for (const char *frame : rejected) {
+        MeetingMindJson::ObjectView view;
+        if (!view.parse(frame)) rejected_ok++;
+    }
+
+    printf("parser:\n");
+    printf("  %zu/%zu well-formed frames accepted, %zu/%zu malformed frames rejected\n", accepted_ok,
+           std::size(accepted), rejected_ok, std::size(rejected));
+    check(accepted_ok == std::size(accepted), "well-formed numbers, escapes and nesting are accepted");
+    check(rejected_ok == std::size(rejected), "malformed numbers, bad escapes and raw control bytes are rejected");
+}
+
+static void run_dispatch(const std::vector<std::string> &frames, size_t coalesce_every)
+{
+    set_coalescing(coalesce_every > 0);
+
+    MeetingMindObsStub::reset_call_counts();
+    const MeetingMindActions::ExecutorStats before = MeetingMindActions::get_executor_stats();
+    const MeetingMindSourceCache::Stats cache_before = MeetingMindSourceCache::get_stats();
+
+    LatencyHistogram latency;
+    size_t rejected = 0;
+    const uint64_t start = os_gettime_ns();
+    for (size_t i = 0; i < frames.size(); i++) {
+        const uint64_t t0 = os_gettime_ns();
+
+        MeetingMindJson::ObjectView envelope;
+        MeetingMindJson::ObjectView data;
+        if (!envelope.parse(frames[i]) || !data.parse(envelope.value(envelope.find("data")))) {
+            rejected++;
+            continue;
+        }
+        dispatch(envelope.raw_string("type"), data);
+        if (coalescing() && (i + 1) % coalesce_every == 0) {
+            flush_coalesced();
+        }
+
+        latency.record(os_gettime_ns() - t0);
+    }
+    if (coalescing()) flush_coalesced();
+    const double seconds = (os_gettime_ns() - start) / 1e9;
+
+    const MeetingMindActions::ExecutorStats after = MeetingMindActions::get_executor_stats();
+    const MeetingMindSourceCache::Stats cache = MeetingMindSourceCache::get_stats();
+    const MeetingMindObsStub::CallCounts calls = MeetingMindObsStub::get_call_counts();
+    const uint64_t lookups = cache.lookups - cache_before.lookups;
+
+    printf("dispatch (%s):\n", coalescing() ? "coalesced" : "immediate");
+    printf("  %zu events in %.3f s, %.0f events/s, %zu rejected\n", frames.size(), seconds,
+           frames.size() / seconds, rejected);
+    print_latency("event -> actions done", latency);
+    printf("  actions %llu applied, %llu redundant skipped; OBS calls: %llu scene, %llu source, %llu lookups\n",
+           (unsigned long long)(after.applied - before.applied),
+           (unsigned long long)(after.skipped - before.skipped), (unsigned long long)calls.scene_switches,
+           (unsigned long long)calls.source_updates, (unsigned long long)calls.source_lookups);
+    printf("  source cache %.1f%% hits over %llu lookups\n",
+           lookups ? 100.0 * (cache.hits - cache_before.hits) / lookups : 0.0, (unsigned long long)lookups);
+}
+
+template <typename Action>
+static void time_action(const char *label, size_t iterations, Action action)
+{
+    LatencyHistogram latency;
+    const uint64_t start = os_gettime_ns();
+    for (size_t i = 0; i < iterations; i++) {
+        const uint64_t t0 = os_gettime_ns();
+        action(i);
+        latency.record(os_gettime_ns() - t0);
+    }
+    const double seconds = (os_gettime_ns() - start) / 1e9;
+    printf("  %-22s %10.0f calls/s\n", label, iterations / seconds);
+    print_latency("", latency);
+}
+
+static void run_actions(const Options &options)
+{
+    const size_t iterations = options.events / 4;
+    printf("actions:\n");
+    time_action("scene switch", iterations, [](size_t i) {
+        MeetingMindActions::switch_scene(i & 1 ? SCENE_PRESENTATION : SCENE_DISCUSSION);
+    });
+    time_action("scene switch (same)", iterations, [](size_t) {
+        MeetingMindActions::switch_scene(SCENE_DISCUSSION);
+    });
+    time_action("mute toggle", iterations, [](size_t i) {
+        MeetingMindActions::set_mute(AUDIO_MEETING, i & 1);
+    });
+    time_action("mute (unchanged)", iterations, [](size_t) {
+        MeetingMindActions::set_mute(AUDIO_MEETING, true);
+    });
+    time_action("missing scene", iterations, [](size_t) {
+        MeetingMindActions::switch_scene("Meeting - Missing");
+    });
+}
+
+// Feeds 48 kHz stereo blocks of 1024 frames through the taps on all three
+// audio sources and reports the callback cost as a share of one core
+static void run_audio(const Options &options)
+{
+    static const char *const tapped[] = {AUDIO_MICROPHONE, AUDIO_DESKTOP, AUDIO_MEETING};
+    const uint32_t frames = 1024;
+    const uint32_t sample_rate = 48000;
+    const size_t blocks = std::max<size_t>(options.events / 100, 100);
+
+    MeetingMindObsStub::set_audio_format(2, sample_rate);
+    MeetingMindAudio::init_taps(tapped, 3, 100);
+
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    std::vector<float> left(frames), right(frames);
+    const float *planes[2] = {left.data(), right.data()};
+
+    LatencyHistogram latency;
+    for (size_t i = 0; i < blocks; i++) {
+        for (uint32_t f = 0; f < frames; f++) {
+            left[f] = noise(rng);
+            right[f] = std::max(-1.0f, std::min(1.0f, 4.0f * noise(rng)));
+        }
+        const uint64_t timestamp = i * frames * 1000000000ull / sample_rate;
+        for (const char *name : tapped) {
+            const uint64_t t0 = os_gettime_ns();
+            MeetingMindObsStub::emit_audio(name, planes, frames, timestamp);
+            latency.record(os_gettime_ns() - t0);
+        }
+    }
+
+    const MeetingMindAudio::TapStats stats = MeetingMindAudio::get_tap_stats();
+    const double audio_seconds = (double)blocks * frames / sample_rate;
+    MeetingMindAudio::SourceLevels levels;
+    MeetingMindAudio::read_levels(0, levels);
+    MeetingMindAudio::shutdown_taps();
+
+    printf("audio taps (%s kernel, %zu blocks x 3 sources, %.1f s of audio):\n",
+           MeetingMindAudio::kernel_name(), blocks, audio_seconds);
+    print_latency("capture callback", latency);
+    printf("  %.4f%% of a core in real time; last window L %.1f dB / R %.1f dB rms, R peak %.1f dB, %u clipped\n",
+           100.0 * stats.busy_ns / (audio_seconds * 1e9), levels.channel[0].rms_db, levels.channel[1].rms_db,
+           levels.channel[1].peak_db, levels.channel[1].clipped);
+}
+
+// Voice activity on a synthetic microphone. The first script has a quiet
+// noise floor, a loud white noise burst that must not count as speech, then
+// talk spurts of a harmonic voice with a syllable-rate envelope. The second
+// starts with a mains hum well above the initial floor, which may only hold
+// speech until it is recognised as background, and then talks over it.
+struct VoiceTransition {
+    bool active;
+    uint64_t timestamp;
+};
+
+struct VoiceSegment {
+    const char *kind; // Any of "hiss", "hum" and "voice" over the noise floor
+    double seconds;
+};
+
+struct VoiceResult {
+    size_t spurts = 0;
+    size_t prompt_onsets = 0;   // Spurts detected in their first block
+    size_t timely_releases = 0; // Spurts released one hangover after they end, give or take a block
+    size_t stray = 0;           // Transitions more than a second from any spurt
+    uint64_t last_stray_ns = 0;
+};
+
+static void on_voice(void *param, size_t, uint32_t, bool active, uint64_t timestamp)
+{
+    ((std::vector<VoiceTransition> *)param)->push_back({active, timestamp});
+}
+
+static VoiceResult run_voice_script(const char *title, const VoiceSegment *script, size_t segments)
+{
+    static const char *const tapped[] = {AUDIO_MICROPHONE};
+    const uint32_t frames = 1024;
+    const uint32_t sample_rate = 48000;
+    const double pi = 3.14159265358979323846;
+
+    std::vector<VoiceTransition> transitions;
+    MeetingMindAudio::set_voice_callback(on_voice, &transitions);
+    MeetingMindObsStub::set_audio_format(1, sample_rate);
+    MeetingMindAudio::init_taps(tapped, 1, 100);
+
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<float> block(frames);
+    const float *planes[1] = {block.data()};
+
+    std::vector<uint64_t> voice_starts;
+    std::vector<uint64_t> voice_ends;
+    LatencyHistogram latency;
+    uint64_t sample = 0;
+    for (size_t s = 0; s < segments; s++) {
+        const VoiceSegment &segment = script[s];
+        const uint64_t segment_start = sample * 1000000000ull / sample_rate;
+        const uint64_t segment_samples = (uint64_t)(segment.seconds * sample_rate);
+        const bool voice = strstr(segment.kind, "voice") != nullptr;
+        const bool hiss = strstr(segment.kind, "hiss") != nullptr;
+        const bool hum = strstr(segment.kind, "hum") != nullptr;
+        if (voice) voice_starts.push_back(segment_start);
+
+        for (uint64_t done = 0; done < segment_samples; done += frames) {
+            for (uint32_t f = 0; f < frames; f++) {
+                const double t = (double)(sample + f) / sample_rate;
+                float value = 0.003f * noise(rng); // About -50 dBFS
+                if (hiss) value += 0.1f * noise(rng);
+                if (hum) value += (float)(0.01 * std::sin(2.0 * pi * 120.0 * t)); // About -43 dBFS
+                if (voice) {
+                    const double envelope = 0.6 + 0.4 * std::sin(2.0 * pi * 4.0 * t);
+                    double harmonics = 0.0;
+                    for (int h = 1; h <= 6; h++) harmonics += std::sin(2.0 * pi * 140.0 * h * t) / h;
+                    value += (float)(0.08 * envelope * harmonics);
+                }
+                block[f] = value;
+            }
+            const uint64_t timestamp = sample * 1000000000ull / sample_rate;
+            const uint64_t t0 = os_gettime_ns();
+            MeetingMindObsStub::emit_audio(AUDIO_MICROPHONE, planes, frames, timestamp);
+            latency.record(os_gettime_ns() - t0);
+            sample += frames;
+        }
+        if (voice) voice_ends.push_back(sample * 1000000000ull / sample_rate);
+    }
+
+    MeetingMindAudio::shutdown_taps();
+    MeetingMindAudio::set_voice_callback(nullptr, nullptr);
+
+    printf("voice activity (%s, %.1f s script):\n", title, (double)sample / sample_rate);
+    print_latency("capture callback", latency);
+    printf("  %zu transitions for %zu talk spurts\n", transitions.size(), voice_starts.size());
+
+    const int64_t block_ns = (int64_t)frames * 1000000000 / sample_rate;
+    const int64_t hangover_ns = (int64_t)(MeetingMindAudio::VoiceParams().hangover_ms * 1e6);
+    VoiceResult result;
+    result.spurts = voice_starts.size();
+    for (const VoiceTransition &transition : transitions) {
+        // Relative to the nearest spurt edge of the same direction
+        const std::vector<uint64_t> &edges = transition.active ? voice_starts : voice_ends;
+        int64_t best = INT64_MAX;
+        for (uint64_t edge : edges) {
+            const int64_t delta = (int64_t)transition.timestamp - (int64_t)edge;
+            if (std::llabs(delta) < std::llabs(best)) best = delta;
+        }
+        if (std::llabs(best) > 1000000000) {
+            printf("  %-8s at %6.3f s, away from any spurt\n", transition.active ? "speech" : "silence",
+                   transition.timestamp / 1e9);
+            result.stray++;
+            result.last_stray_ns = transition.timestamp;
+            continue;
+        }
+        if (transition.active && best >= 0 && best < block_ns) result.prompt_onsets++;
+        if (!transition.active && std::llabs(best - hangover_ns) <= block_ns) result.timely_releases++;
+        printf("  %-8s at %6.3f s, %+7.1f ms from the spurt %s\n", transition.active ? "speech" : "silence",
+               transition.timestamp / 1e9, best / 1e6, transition.active ? "start" : "end");
+    }
+    return result;
+}
+
+static void run_voice()
+{
+    static const VoiceSegment quiet_room[] = {
+        {"floor", 2.0}, {"hiss", 1.0}, {"floor", 1.0}, {"voice", 2.0},
+        {"floor", 1.5}, {"voice", 0.5}, {"floor", 1.0},
+    };
+    static const VoiceSegment humming_room[] = {
+        {"hum", 6.0}, {"hum voice", 2.0}, {"hum", 2.0},
+    };
+    const VoiceResult quiet =
+        run_voice_script("quiet room", quiet_room, sizeof(quiet_room) / sizeof(quiet_room[0]));
+    check(quiet.prompt_onsets == quiet.spurts, "speech detected in the first block of each spurt");
+    check(quiet.timely_releases == quiet.spurts, "speech released one hangover after each spurt");
+    check(quiet.stray == 0, "white noise burst not taken for speech");
+
+    const VoiceResult hum =
+        run_voice_script("120 Hz hum", humming_room, sizeof(humming_room) / sizeof(humming_room[0]));
+    check(hum.prompt_onsets == hum.spurts, "speech over the hum detected in its first block");
+    check(hum.timely_releases == hum.spurts, "speech over the hum released one hangover after it ends");
+    check(hum.stray <= 2 && hum.last_stray_ns <= 2500000000ull, "hum taken as background within 2.5 s");
+}
+
+// A scripted three-way conversation: turns of 2 to 15 s with breaths in
+// them, "mm-hm"s from the listeners, interruptions that overlap the end of a
+// turn, and now and then a long silence
+struct VoiceEvent {
+    uint64_t time_ns;
+    size_t camera;
+    bool active;
+};
+
+static std::vector<VoiceEvent> make_conversation(size_t cameras, double seconds)
+{
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    auto between = [&](double low, double high) { return low + (high - low) * uniform(rng); };
+
+    std::vector<VoiceEvent> events;
+    auto talk = [&](size_t camera, double start, double end) {
+        events.push_back({(uint64_t)(start * 1e9), camera, true});
+        events.push_back({(uint64_t)(end * 1e9), camera, false});
+    };
+
+    double t = 1.0;
+    size_t speaker = 0;
+    while (t < seconds) {
+        const double turn_end = t + between(2.0, 15.0);
+        for (double spurt = t; spurt < turn_end;) {
+            const double spurt_end = std::min(spurt + between(0.8, 3.0), turn_end);
+            talk(speaker, spurt, spurt_end);
+            spurt = spurt_end + between(0.15, 0.6);
+        }
+        for (size_t listener = 0; listener < cameras; listener++) {
+            if (listener != speaker && uniform(rng) < 0.5) {
+                const double at = between(t + 0.5, turn_end);
+                talk(listener, at, at + between(0.2, 0.5));
+            }
+        }
+
+        const size_t next = (speaker + 1 + (size_t)(uniform(rng) * (cameras - 1))) % cameras;
+        const double roll = uniform(rng);
+        if (roll < 0.2) {
+            t = turn_end - between(0.5, 3.0); // Interrupts
+        } else if (roll < 0.25) {
+            t = turn_end + between(8.0, 15.0); // Goes quiet
+        } else {
+            t = turn_end + between(0.2, 1.2);
+        }
+        speaker = next;
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const VoiceEvent &a, const VoiceEvent &b) { return a.time_ns < b.time_ns; });
+
+    // Overlapping spurts of one speaker merge into one
+    std::vector<VoiceEvent> merged;
+    std::vector<int> depth(cameras, 0);
+    for (const VoiceEvent &event : events) {
+        const int before = depth[event.camera];
+        depth[event.camera] += event.active ? 1 : -1;
+        if ((before == 0) != (depth[event.camera] == 0)) merged.push_back(event);
+    }
+    return merged;
+}
+
+struct ShotLog {
+    size_t cuts = 0;
+    size_t flashes = 0; // Shots under two seconds
+    uint64_t shortest_ns = UINT64_MAX;
+    uint64_t on_speaker_ns = 0; // Speech time with the speaker, or the wide shot, on program
+    uint64_t speech_ns = 0;
+    int shot = MeetingMindDirector::NO_SHOT;
+    uint64_t shot_start_ns = 0;
+
+    void cut(int next, uint64_t now_ns)
+    {
+        if (next == shot) return;
+        if (shot != MeetingMindDirector::NO_SHOT) {
+            shortest_ns = std::min(shortest_ns, now_ns - shot_start_ns);
+            if (now_ns - shot_start_ns < 2000000000ull) flashes++;
+        }
+        shot = next;
+        shot_start_ns = now_ns;
+        cuts++;
+    }
+
+    void account(const std::vector<bool> &talking, uint64_t elapsed_ns)
+    {
+        const size_t count = (size_t)std::count(talking.begin(), talking.end(), true);
+        if (!count) return;
+        speech_ns += elapsed_ns;
+        if (shot == MeetingMindDirector::WIDE_SHOT || (shot >= 0 && talking[shot])) on_speaker_ns += elapsed_ns;
+    }
+
+    void print(const char *label, double seconds) const
+    {
+        printf("  %-20s %4zu cuts (%.1f/min), %3zu under 2 s, shortest %5.2f s, speaker on program %5.1f%% of speech\n",
+               label, cuts, cuts * 60.0 / seconds, flashes, shortest_ns == UINT64_MAX ? 0.0 : shortest_ns / 1e9,
+               speech_ns ? 100.0 * on_speaker_ns / speech_ns : 0.0);
+    }
+};
+
+static void run_director()
+{
+    using MeetingMindDirector::Director;
+    const size_t cameras = 3;
+    const double seconds = 600.0;
+    const std::vector<VoiceEvent> events = make_conversation(cameras, seconds);
+    const uint64_t end_ns = (uint64_t)(seconds * 1e9) + 20000000000ull;
+
+    // The director, woken by each voice change and at each next_ns, as the
+    // plugin's timer does
+    Director director;
+    director.configure(cameras, true);
+    LatencyHistogram decide_latency;
+    ShotLog directed;
+    std::vector<bool> talking(cameras, false);
+    uint64_t now = 0;
+    uint64_t wake_ns = 0;
+    size_t next = 0;
+    while (next < events.size() || (wake_ns && wake_ns < end_ns)) {
+        const bool timer = wake_ns && (next == events.size() || wake_ns < events[next].time_ns);
+        const uint64_t at = timer ? wake_ns : events[next].time_ns;
+        directed.account(talking, at - now);
+        now = at;
+        if (!timer) {
+            director.voice(events[next].camera, events[next].active, now);
+            talking[events[next].camera] = events[next].active;
+            next++;
+        }
+        const uint64_t t0 = os_gettime_ns();
+        const MeetingMindDirector::Decision decision = director.decide(now);
+        decide_latency.record(os_gettime_ns() - t0);
+        if (decision.cut) directed.cut(decision.shot, now);
+        wake_ns = decision.next_ns;
+    }
+    directed.account(talking, end_ns - now);
+
+    // The rule it replaces: whoever starts talking while the camera's
+    // speaker is quiet gets the camera at once
+    ShotLog naive;
+    std::fill(talking.begin(), talking.end(), false);
+    now = 0;
+    for (const VoiceEvent &event : events) {
+        naive.account(talking, event.time_ns - now);
+        now = event.time_ns;
+        talking[event.camera] = event.active;
+        if (event.active && (naive.shot < 0 || !talking[naive.shot])) {
+            naive.cut((int)event.camera, now);
+        } else if (!event.active && (int)event.camera == naive.shot) {
+            for (size_t i = 0; i < cameras; i++) {
+                if (talking[i]) {
+                    naive.cut((int)i, now);
+                    break;
+                }
+            }
+        }
+    }
+    naive.account(talking, end_ns - now);
+
+    printf("auto-director (%zu cameras and a wide shot, %.0f s conversation, %zu voice changes):\n", cameras,
+           seconds, events.size());
+    print_latency("decide", decide_latency);
+    naive.print("cut on first voice", seconds);
+    directed.print("director", seconds);
+    check(directed.shortest_ns >= 3000000000ull, "no shot held under 3 s");
+    check(directed.cuts < naive.cuts, "fewer cuts than cutting on first voice");
+}
+
+static void print_jitter_stats(const char *label, const MeetingMindAudio::JitterStats &stats)
+{
+    printf("  %-10s %llu packets, %llu lost, %llu late, %llu duplicate, %llu skipped, %llu underruns, "
+           "%.0f ms concealed; jitter %.1f ms, target %.1f ms, depth %.1f ms\n",
+           label, (unsigned long long)stats.packets, (unsigned long long)stats.lost, (unsigned long long)stats.late,
+           (unsigned long long)stats.duplicates, (unsigned long long)stats.discarded,
+           (unsigned long long)stats.underruns, stats.concealed_frames / 48.0, stats.jitter_ms, stats.target_ms,
+           stats.depth_ms);
+}
+
+static void run_jitter()
+{
+    using MeetingMindAudio::JitterBuffer;
+    const uint32_t sample_rate = 48000;
+    const size_t channels = 2;
+    const size_t packet_frames = 960; // 20 ms
+    const size_t read_frames = sample_rate / 100;
+    const uint64_t packet_ns = 20000000;
+    const uint64_t tick_ns = 10000000;
+    const uint32_t packets = 3000; // One minute
+    const double mean_jitter_ms = 6.0;
+    const double loss = 0.01;
+    const double duplicates = 0.005;
+    const uint64_t stall_start = 30000000000ull;
+    const uint64_t stall_end = stall_start + 300000000ull;
+
+    // Network delay is 30 ms plus exponential jitter, which also reorders;
+    // everything sent during the stall arrives together when it ends
+    struct Arrival {
+        uint64_t arrival_ns;
+        uint32_t sequence;
+    };
+    std::mt19937 rng(11);
+    std::exponential_distribution<double> jitter(1.0 / mean_jitter_ms);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::vector<Arrival> arrivals;
+    uint64_t duplicated = 0;
+    for (uint32_t sequence = 0; sequence < packets; sequence++) {
+        if (chance(rng) < loss) continue;
+        const uint64_t sent = sequence * packet_ns;
+        uint64_t arrival = sent + 30000000ull + (uint64_t)(jitter(rng) * 1e6);
+        if (sent >= stall_start && sent < stall_end) arrival = std::max<uint64_t>(arrival, stall_end + 30000000ull);
+        arrivals.push_back({arrival, sequence});
+        if (chance(rng) < duplicates) {
+            arrivals.push_back({arrival + 5000000ull, sequence});
+            duplicated++;
+        }
+    }
+    std::stable_sort(arrivals.begin(), arrivals.end(),
+                     [](const Arrival &a, const Arrival &b) { return a.arrival_ns < b.arrival_ns; });
+
+    JitterBuffer buffer;
+    std::vector<int16_t> pcm(packet_frames * channels);
+    std::vector<float> out[JitterBuffer::MAX_CHANNELS];
+    float *planes[JitterBuffer::MAX_CHANNELS];
+    for (size_t c = 0; c < JitterBuffer::MAX_CHANNELS; c++) {
+        out[c].resize(read_frames);
+        planes[c] = out[c].data();
+    }
+
+    LatencyHistogram insert_latency;
+    LatencyHistogram read_latency;
+    MeetingMindAudio::JitterStats before_stall;
+    size_t next = 0;
+    size_t played_ticks = 0;
+    size_t longest_gap_ticks = 0; // Silent ticks in a row once playout has started
+    size_t gap_ticks = 0;
+    const uint64_t end = packets * packet_ns + 1000000000ull;
+    for (uint64_t now = tick_ns; now < end; now += tick_ns) {
+        for (; next < arrivals.size() && arrivals[next].arrival_ns <= now; next++) {
+            const uint32_t sequence = arrivals[next].sequence;
+            const uint64_t pts = (uint64_t)sequence * packet_frames;
+            for (size_t f = 0; f < packet_frames; f++) {
+                const int16_t value = (int16_t)(8000.0 * std::sin(2.0 * M_PI * 440.0 * (pts + f) / sample_rate));
+                pcm[f * channels] = value;
+                pcm[f * channels + 1] = value;
+            }
+            const uint64_t t0 = os_gettime_ns();
+            buffer.insert(sequence, pts, sample_rate, channels, pcm.data(), packet_frames, arrivals[next].arrival_ns);
+            insert_latency.record(os_gettime_ns() - t0);
+        }
+        const uint64_t t0 = os_gettime_ns();
+        const bool played = buffer.read(planes, read_frames, now);
+        read_latency.record(os_gettime_ns() - t0);
+        if (played) {
+            played_ticks++;
+            gap_ticks = 0;
+        } else if (played_ticks && now < packets * packet_ns) {
+            longest_gap_ticks = std::max(longest_gap_ticks, ++gap_ticks);
+        }
+        if (now == stall_start) before_stall = buffer.stats();
+    }
+
+    printf("jitter buffer (48 kHz stereo, 20 ms packets, %u packets, %.0f ms mean jitter, %.1f%% loss, "
+           "300 ms stall at %.0f s):\n",
+           packets, mean_jitter_ms, loss * 100.0, stall_start / 1e9);
+    print_latency("insert 20 ms packet", insert_latency);
+    print_latency("read 10 ms", read_latency);
+    print_jitter_stats("pre-stall", before_stall);
+    print_jitter_stats("end", buffer.stats());
+    printf("  %zu of %llu ticks played, longest gap %zu ms\n", played_ticks, (unsigned long long)(end / tick_ns - 1),
+           longest_gap_ticks * (size_t)(tick_ns / 1000000));
+
+    const MeetingMindAudio::JitterStats stats = buffer.stats();
+    check(stats.packets + stats.lost == packets, "every packet played or counted lost");
+    check(stats.duplicates == duplicated, "every duplicate discarded");
+    check(stats.target_ms >= 40.0 && stats.target_ms <= 500.0, "target depth within 40 to 500 ms");
+    check(longest_gap_ticks * tick_ns <= stall_end - stall_start, "no playout gap longer than the stall");
+}
+
+static void run_config(const Options &options)
+{
+    meetingmind_config config = {};
+    MeetingMindConfig::apply_default_config(&config);
+
+    LatencyHistogram save_latency;
+    LatencyHistogram load_latency;
+    for (size_t i = 0; i < options.config_iterations; i++) {
+        config.coalesce_window_ms = (int)(i % 20) * 50;
+
+        uint64_t t0 = os_gettime_ns();
+        MeetingMindConfig::save_config(&config);
+        save_latency.record(os_gettime_ns() - t0);
+
+        t0 = os_gettime_ns();
+        MeetingMindConfig::load_config(&config);
+        load_latency.record(os_gettime_ns() - t0);
+    }
+
+    printf("config (%zu save/load cycles):\n", options.config_iterations);
+    print_latency("save", save_latency);
+    print_latency("load", load_latency);
+
+    // A hand-edited file with one bad value keeps the rest of its settings
+    bfree(config.meeting_id);
+    config.meeting_id = bstrdup("weekly-sync");
+    config.voice_switching = true;
+    MeetingMindConfig::save_config(&config);
+    char *config_path = obs_module_config_path("meetingmind.ini");
+    config_t *file = nullptr;
+    if (config_open(&file, config_path, CONFIG_OPEN_EXISTING) == CONFIG_SUCCESS) {
+        config_set_int(file, "connection", "server_port", 0);
+        config_save(file);
+        config_close(file);
+    }
+    bfree(config_path);
+    MeetingMindConfig::load_config(&config);
+    check(config.server_port == 8080 && strcmp(config.meeting_id, "weekly-sync") == 0 && config.voice_switching,
+          "an invalid port is reset without losing the other settings");
+
+    // Typing a server URL: one async save per keystroke, written once the
+    // edits pause
+    MeetingMindConfig::start_config_writer(&config, 20);
+    const MeetingMindObsStub::CallCounts calls_before = MeetingMindObsStub::get_call_counts();
+    LatencyHistogram async_latency;
+    std::string url;
+    for (size_t i = 0; i < options.config_iterations; i++) {
+        url += (char)('a' + i % 26);
+        if (url.size() > 40) url.clear();
+        bfree(config.server_url);
+        config.server_url = bstrdup(url.empty() ? "localhost" : url.c_str());
+
+        const uint64_t t0 = os_gettime_ns();
+        MeetingMindConfig::save_config_async(&config);
+        async_latency.record(os_gettime_ns() - t0);
+    }
+    MeetingMindConfig::flush_config_writer();
+    MeetingMindConfig::stop_config_writer();
+    const MeetingMindConfig::WriterStats stats = MeetingMindConfig::get_config_writer_stats();
+    const MeetingMindObsStub::CallCounts calls = MeetingMindObsStub::get_call_counts();
+    MeetingMindConfig::free_config_strings(&config);
+
+    print_latency("save_config_async", async_latency);
+    printf("  %llu requests, %llu written, %llu unchanged, %llu config file ops\n",
+           (unsigned long long)stats.requested, (unsigned long long)stats.written,
+           (unsigned long long)stats.unchanged, (unsigned long long)(calls.config_ios - calls_before.config_ios));
+}
+
+// A long recording's index: every frame as an event a few seconds apart,
+// with a pause, then read back as a mapped file would be and searched
+static void run_index(const std::vector<std::string> &frames, const char *dir)
+{
+    using MeetingMindIndex::IndexView;
+    using MeetingMindIndex::IndexWriter;
+    const std::string recording = std::string(dir) + "/bench-recording.mkv";
+    const uint64_t start_ns = 1000000000ull;
+
+    IndexWriter writer;
+    if (!writer.open(recording.c_str(), start_ns, 1760000000000ull, 30, 1)) {
+        printf("recording index: cannot write %s\n", recording.c_str());
+        check(false, "index written");
+        return;
+    }
+    std::mt19937 rng(11);
+    LatencyHistogram append_latency;
+    uint64_t now = start_ns;
+    for (size_t i = 0; i < frames.size(); i++) {
+        now += 100000000ull + rng() % 5000000000ull;
+        if (i == frames.size() / 2) writer.pause(now);
+        if (i == frames.size() / 2 + 10) writer.resume(now);
+        const char *type = i % 2 ? "participant_joined" : "scene_change_requested";
+        const uint64_t t0 = os_gettime_ns();
+        writer.append(now, 0, type, frames[i].data(), frames[i].size(), 0);
+        append_latency.record(os_gettime_ns() - t0);
+    }
+    const std::string index_path = writer.index_path();
+    writer.close();
+
+    std::ifstream file(index_path, std::ios::binary);
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    IndexView view;
+    if (!view.open(data.data(), data.size()) || view.size() != frames.size()) {
+        printf("recording index: cannot read back %s\n", index_path.c_str());
+        check(false, "every event read back from the index");
+        unlink(index_path.c_str());
+        unlink((recording + ".mmevents").c_str());
+        return;
+    }
+    const uint64_t duration_ns = view.time_ns(view.size() - 1);
+
+    // Seeking relies on times never going back, and the pause must show in
+    // the events that arrived during it
+    bool ordered = true;
+    size_t paused = 0;
+    for (size_t i = 0; i < view.size(); i++) {
+        if (i && view.time_ns(i) < view.time_ns(i - 1)) ordered = false;
+        if (view.record(i).flags & MeetingMindIndex::FLAG_PAUSED) paused++;
+    }
+
+    // Binary search against a scan from the start, which is what finding a
+    // moment costs without the index
+    const size_t seeks = 100000;
+    const size_t scans = 200;
+    std::vector<uint64_t> targets(seeks);
+    for (uint64_t &target : targets) target = (uint64_t)(rng() / 4294967296.0 * duration_ns);
+    size_t checksum = 0;
+    uint64_t t0 = os_gettime_ns();
+    for (uint64_t target : targets) checksum += view.seek(target);
+    const double seek_ns = (double)(os_gettime_ns() - t0) / seeks;
+
+    size_t mismatches = 0;
+    t0 = os_gettime_ns();
+    for (size_t i = 0; i < scans; i++) {
+        size_t found = 0;
+        while (found < view.size() && view.time_ns(found) < targets[i]) found++;
+        if (found != view.seek(targets[i])) mismatches++;
+    }
+    const double scan_ns = (double)(os_gettime_ns() - t0) / scans;
+
+    printf("recording index (%zu events over %.1f h, %zu KB index):\n", view.size(), duration_ns / 3.6e12,
+           data.size() / 1024);
+    print_latency("append", append_latency);
+    printf("  seek %.2f us, linear scan %.1f us (%.0fx)  [%zu]\n", seek_ns / 1000.0, scan_ns / 1000.0,
+           scan_ns / seek_ns, checksum & 0xff);
+    check(ordered, "record times never go back");
+    check(paused == 10, "events during the pause flagged as paused");
+    check(mismatches == 0, "seek finds the same record as a linear scan");
+
+    unlink(index_path.c_str());
+    unlink((recording + ".mmevents").c_str());
+}
+
+static bool parse_options(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        const uint64_t value = strtoull(argv[++i], nullptr, 10);
+
+        if (!strcmp(arg, "--events")) options.events = value;
+        else if (!strcmp(arg, "--coalesce-every")) options.coalesce_every = value;
+        else if (!strcmp(arg, "--config-iterations")) options.config_iterations = value;
+        else if (!strcmp(arg, "--write-trace")) options.trace_path = argv[i];
+        else if (!strcmp(arg, "--lookup-ns")) options.costs.source_lookup_ns = value;
+        else if (!strcmp(arg, "--update-ns")) options.costs.source_update_ns = value;
+        else if (!strcmp(arg, "--switch-ns")) options.costs.scene_switch_ns = value;
+        else if (!strcmp(arg, "--query-ns")) options.costs.frontend_query_ns = value;
+        else if (!strcmp(arg, "--toggle-ns")) options.costs.output_toggle_ns = value;
+        else if (!strcmp(arg, "--config-ns")) options.costs.config_io_ns = value;
+        else if (!strcmp(arg, "--log-ns")) options.costs.log_ns = value;
+        else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        fprintf(stderr,
+                "usage: %s [--events N] [--coalesce-every N] [--config-iterations N]\n"
+                "          [--lookup-ns N] [--update-ns N] [--switch-ns N] [--query-ns N]\n"
+                "          [--toggle-ns N] [--config-ns N] [--log-ns N] [--write-trace PATH]\n",
+                argv[0]);
+        return 2;
+    }
+
+    char config_dir[] = "/tmp/meetingmind-bench-XXXXXX";
+    if (!mkdtemp(config_dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    MeetingMindObsStub::set_config_dir(config_dir);
+    MeetingMindObsStub::set_costs(options.costs);
+
+    setup_obs();
+
+    printf("MeetingMind headless benchmark: %zu events, scanner %s\n", options.events,
+           MeetingMindJson::scanner_name());
+
+    const std::vector<std::string> frames = make_frames(options.events);
+    if (options.trace_path && !write_trace(options.trace_path, frames)) {
+        fprintf(stderr, "Cannot write trace %s\n", options.trace_path);
+    }
+    run_parser();
+    run_dispatch(frames, 0);
+    if (options.coalesce_every) run_dispatch(frames, options.coalesce_every);
+    run_actions(options);
+    run_audio(options);
+    run_voice();
+    run_director();
+    run_jitter();
+    run_config(options);
+    run_index(frames, config_dir);
+
+    shutdown_obs();
+
+    char config_path[sizeof(config_dir) + 32];
+    snprintf(config_path, sizeof(config_path), "%s/meetingmind.ini", config_dir);
+    unlink(config_path);
+    rmdir(config_dir);
+
+    if (failed_checks) {
+        fprintf(stderr, "%zu checks failed\n", failed_checks);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+MeetingMind libobs Stub
+The subset of the libobs and obs-frontend-api interfaces used by the plugin's
+Qt-free sources, declared with the same signatures as OBS so that those
+sources build unmodified against the stub
+*/
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MODULE_EXPORT
+
+// util/base.h
+
+enum {
+    LOG_ERROR = 100,
+    LOG_WARNING = 200,
+    LOG_INFO = 300,
+    LOG_DEBUG = 400,
+};
+
+void blog(int log_level, const char *format, ...);
+
+// util/bmem.h
+
+void *bmalloc(size_t size);
+void *bzalloc(size_t size);
+void bfree(void *ptr);
+char *bstrdup(const char *str);
+
+// util/platform.h
+
+uint64_t os_gettime_ns(void);
+
+// callback/calldata.h, callback/signal.h
+
+typedef struct calldata calldata_t;
+typedef struct signal_handler signal_handler_t;
+typedef void (*signal_callback_t)(void *data, calldata_t *cd);
+
+void *calldata_ptr(const calldata_t *data, const char *name);
+const char *calldata_string(const calldata_t *data, const char *name);
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data);
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+                               void *data);
+
+// obs.h
+
+typedef struct obs_module obs_module_t;
+typedef struct obs_source obs_source_t;
+typedef struct obs_weak_source obs_weak_source_t;
+
+signal_handler_t *obs_get_signal_handler(void);
+
+obs_source_t *obs_get_source_by_name(const char *name);
+const char *obs_source_get_name(const obs_source_t *source);
+void obs_source_release(obs_source_t *source);
+
+obs_weak_source_t *obs_source_get_weak_source(obs_source_t *source);
+obs_source_t *obs_weak_source_get_source(obs_weak_source_t *weak);
+void obs_weak_source_release(obs_weak_source_t *weak);
+bool obs_weak_source_references_source(obs_weak_source_t *weak, obs_source_t *source);
+
+bool obs_source_muted(const obs_source_t *source);
+void obs_source_set_muted(obs_source_t *source, bool muted);
+bool obs_source_enabled(const obs_source_t *source);
+void obs_source_set_enabled(obs_source_t *source, bool enabled);
+
+// media-io/audio-io.h
+
+#define MAX_AV_PLANES 8
+
+typedef struct audio_output audio_t;
+
+struct audio_data {
+    uint8_t *data[MAX_AV_PLANES];
+    uint32_t frames;
+    uint64_t timestamp;
+};
+
+audio_t *obs_get_audio(void);
+size_t audio_output_get_channels(const audio_t *audio);
+uint32_t audio_output_get_sample_rate(const audio_t *audio);
+
+typedef void (*obs_audio_capture_cb)(void *param, obs_source_t *source, const struct audio_data *audio_data,
+                                     bool muted);
+void obs_source_add_audio_capture_callback(obs_source_t *source, obs_audio_capture_cb callback, void *param);
+void obs_source_remove_audio_capture_callback(obs_source_t *source, obs_audio_capture_cb callback, void *param);
+
+// obs-module.h
+
+obs_module_t *obs_current_module(void);
+char *obs_module_get_config_path(obs_module_t *module, const char *file);
+
+#define obs_module_config_path(file) obs_module_get_config_path(obs_current_module(), file)
+
+// util/config-file.h
+
+typedef struct config_data config_t;
+
+#define CONFIG_SUCCESS 0
+#define CONFIG_FILENOTFOUND -1
+#define CONFIG_ERROR -2
+
+enum config_open_type {
+    CONFIG_OPEN_EXISTING,
+    CONFIG_OPEN_ALWAYS,
+};
+
+config_t *config_create(const char *file);
+int config_open(config_t **config, const char *file, enum config_open_type open_type);
+int config_save(config_t *config);
+int config_save_safe(config_t *config, const char *temp_ext, const char *backup_ext);
+void config_close(config_t *config);
+
+bool config_has_user_value(config_t *config, const char *section, const char *name);
+const char *config_get_string(config_t *config, const char *section, const char *name);
+int64_t config_get_int(config_t *config, const char *section, const char *name);
+bool config_get_bool(config_t *config, const char *section, const char *name);
+void config_set_string(config_t *config, const char *section, const char *name, const char *value);
+void config_set_int(config_t *config, const char *section, const char *name, int64_t value);
+void config_set_bool(config_t *config, const char *section, const char *name, bool value);
+
+// obs-frontend-api.h
+
+enum obs_frontend_event {
+    OBS_FRONTEND_EVENT_STREAMING_STARTING,
+    OBS_FRONTEND_EVENT_STREAMING_STARTED,
+    OBS_FRONTEND_EVENT_STREAMING_STOPPING,
+    OBS_FRONTEND_EVENT_STREAMING_STOPPED,
+    OBS_FRONTEND_EVENT_RECORDING_STARTING,
+    OBS_FRONTEND_EVENT_RECORDING_STARTED,
+    OBS_FRONTEND_EVENT_RECORDING_STOPPING,
+    OBS_FRONTEND_EVENT_RECORDING_STOPPED,
+    OBS_FRONTEND_EVENT_SCENE_CHANGED,
+    OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED,
+    OBS_FRONTEND_EVENT_TRANSITION_CHANGED,
+    OBS_FRONTEND_EVENT_TRANSITION_STOPPED,
+    OBS_FRONTEND_EVENT_TRANSITION_LIST_CHANGED,
+    OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED,
+    OBS_FRONTEND_EVENT_SCENE_COLLECTION_LIST_CHANGED,
+    OBS_FRONTEND_EVENT_PROFILE_CHANGED,
+    OBS_FRONTEND_EVENT_PROFILE_LIST_CHANGED,
+    OBS_FRONTEND_EVENT_EXIT,
+    OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTING,
+    OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTED,
+    OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPING,
+    OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPED,
+    OBS_FRONTEND_EVENT_STUDIO_MODE_ENABLED,
+    OBS_FRONTEND_EVENT_STUDIO_MODE_DISABLED,
+    OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED,
+    OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP,
+    OBS_FRONTEND_EVENT_FINISHED_LOADING,
+    OBS_FRONTEND_EVENT_RECORDING_PAUSED,
+    OBS_FRONTEND_EVENT_RECORDING_UNPAUSED,
+    OBS_FRONTEND_EVENT_TRANSITION_DURATION_CHANGED,
+    OBS_FRONTEND_EVENT_REPLAY_BUFFER_SAVED,
+};
+
+typedef void (*obs_frontend_event_cb)(enum obs_frontend_event event, void *private_data);
+
+void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void *private_data);
+void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void *private_data);
+
+obs_source_t *obs_frontend_get_current_scene(void);
+void obs_frontend_set_current_scene(obs_source_t *scene);
+
+bool obs_frontend_recording_active(void);
+bool obs_frontend_recording_paused(void);
+void obs_frontend_recording_start(void);
+void obs_frontend_recording_stop(void);
+bool obs_frontend_streaming_active(void);
+void obs_frontend_streaming_start(void);
+void obs_frontend_streaming_stop(void);
+bool obs_frontend_replay_buffer_active(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,677 @@
+/*
+MeetingMind libobs Stub
+Headless stand-in for the libobs and OBS frontend calls the plugin makes,
+with configurable simulated costs
+*/
+
+#include "obs-stub.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct obs_source {
+    std::string name;
+    std::atomic<long> refs{1};
+    std::atomic<bool> muted{false};
+    std::atomic<bool> enabled{true};
+    std::atomic<bool> destroyed{false};
+
+    struct AudioCallback {
+        obs_audio_capture_cb callback;
+        void *param;
+    };
+    std::mutex audio_cb_mutex;
+    std::vector<AudioCallback> audio_callbacks;
+};
+
+struct audio_output {
+    size_t channels = 2;
+    uint32_t sample_rate = 48000;
+};
+
+struct obs_weak_source {
+    obs_source_t *source;
+};
+
+struct calldata {
+    std::unordered_map<std::string, void *> ptrs;
+    std::unordered_map<std::string, std::string> strings;
+};
+
+struct signal_handler {
+    struct Connection {
+        std::string signal;
+        signal_callback_t callback;
+        void *data;
+    };
+    std::vector<Connection> connections;
+};
+
+struct config_data {
+    std::string path;
+    std::map<std::string, std::map<std::string, std::string>> sections;
+};
+
+namespace MeetingMindObsStub {
+
+namespace {
+
+struct FrontendCallback {
+    obs_frontend_event_cb callback;
+    void *data;
+};
+
+std::mutex stub_mutex;
+std::vector<std::unique_ptr<obs_source>> sources;
+std::unordered_map<std::string, obs_source_t *> sources_by_name;
+signal_handler global_signals;
+std::vector<FrontendCallback> frontend_callbacks;
+obs_source_t *current_scene = nullptr;
+bool recording = false;
+bool streaming = false;
+audio_output audio_format;
+
+Costs costs;
+bool log_output = false;
+std::string config_dir = ".";
+
+std::atomic<uint64_t> source_lookups{0};
+std::atomic<uint64_t> source_updates{0};
+std::atomic<uint64_t> scene_switches{0};
+std::atomic<uint64_t> frontend_queries{0};
+std::atomic<uint64_t> output_toggles{0};
+std::atomic<uint64_t> config_ios{0};
+std::atomic<uint64_t> log_lines{0};
+
+// Busy-waits rather than sleeping: the costs stand in for CPU work done on
+// the calling thread, and sleeps are far too coarse at this scale
+void simulate(uint64_t ns)
+{
+    if (!ns) return;
+    const uint64_t until = os_gettime_ns() + ns;
+    while (os_gettime_ns() < until) {
+    }
+}
+
+void emit_signal(const char *signal, obs_source_t *source)
+{
+    calldata cd;
+    cd.ptrs["source"] = source;
+
+    std::vector<signal_handler::Connection> targets;
+    {
+        std::lock_guard<std::mutex> lock(stub_mutex);
+        for (const auto &connection : global_signals.connections) {
+            if (connection.signal == signal) targets.push_back(connection);
+        }
+    }
+    for (const auto &target : targets) target.callback(target.data, &cd);
+}
+
+void emit_frontend(obs_frontend_event event)
+{
+    std::vector<FrontendCallback> targets;
+    {
+        std::lock_guard<std::mutex> lock(stub_mutex);
+        targets = frontend_callbacks;
+    }
+    for (const auto &target : targets) target.callback(event, target.data);
+}
+
+void toggle_output(bool &active, bool start, obs_frontend_event starting, obs_frontend_event started,
+                   obs_frontend_event stopping, obs_frontend_event stopped)
+{
+    output_toggles.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.output_toggle_ns);
+    if (active == start) return;
+
+    emit_frontend(start ? starting : stopping);
+    active = start;
+    emit_frontend(start ? started : stopped);
+}
+
+} // namespace
+
+void set_costs(const Costs &new_costs)
+{
+    costs = new_costs;
+}
+
+const Costs &get_costs()
+{
+    return costs;
+}
+
+void set_log_output(bool enabled)
+{
+    log_output = enabled;
+}
+
+void set_config_dir(const std::string &dir)
+{
+    config_dir = dir;
+}
+
+obs_source_t *create_source(const char *name)
+{
+    obs_source_t *source;
+    {
+        std::lock_guard<std::mutex> lock(stub_mutex);
+        sources.push_back(std::make_unique<obs_source>());
+        source = sources.back().get();
+        source->name = name;
+        sources_by_name[name] = source;
+    }
+    emit_signal("source_create", source);
+    return source;
+}
+
+void remove_source(const char *name)
+{
+    obs_source_t *source;
+    {
+        std::lock_guard<std::mutex> lock(stub_mutex);
+        auto it = sources_by_name.find(name);
+        if (it == sources_by_name.end()) return;
+        source = it->second;
+        sources_by_name.erase(it);
+    }
+    emit_signal("source_remove", source);
+    source->destroyed = true;
+    emit_signal("source_destroy", source);
+}
+
+void emit_frontend_event(obs_frontend_event event)
+{
+    emit_frontend(event);
+}
+
+void set_audio_format(size_t channels, uint32_t sample_rate)
+{
+    audio_format.channels = channels;
+    audio_format.sample_rate = sample_rate;
+}
+
+void emit_audio(const char *name, const float *const *planes, uint32_t frames, uint64_t timestamp)
+{
+    obs_source_t *source;
+    {
+        std::lock_guard<std::mutex> lock(stub_mutex);
+        auto it = sources_by_name.find(name);
+        if (it == sources_by_name.end()) return;
+        source = it->second;
+    }
+
+    struct audio_data audio = {};
+    for (size_t ch = 0; ch < audio_format.channels && ch < MAX_AV_PLANES; ch++) {
+        audio.data[ch] = (uint8_t *)planes[ch];
+    }
+    audio.frames = frames;
+    audio.timestamp = timestamp;
+
+    std::lock_guard<std::mutex> lock(source->audio_cb_mutex);
+    for (const obs_source::AudioCallback &entry : source->audio_callbacks) {
+        entry.callback(entry.param, source, &audio, source->muted);
+    }
+}
+
+CallCounts get_call_counts()
+{
+    CallCounts counts;
+    counts.source_lookups = source_lookups.load(std::memory_order_relaxed);
+    counts.source_updates = source_updates.load(std::memory_order_relaxed);
+    counts.scene_switches = scene_switches.load(std::memory_order_relaxed);
+    counts.frontend_queries = frontend_queries.load(std::memory_order_relaxed);
+    counts.output_toggles = output_toggles.load(std::memory_order_relaxed);
+    counts.config_ios = config_ios.load(std::memory_order_relaxed);
+    counts.log_lines = log_lines.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void reset_call_counts()
+{
+    for (auto *counter : {&source_lookups, &source_updates, &scene_switches, &frontend_queries,
+                          &output_toggles, &config_ios, &log_lines}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+}
+
+void reset()
+{
+    std::lock_guard<std::mutex> lock(stub_mutex);
+    global_signals.connections.clear();
+    frontend_callbacks.clear();
+    sources_by_name.clear();
+    sources.clear();
+    current_scene = nullptr;
+    recording = false;
+    streaming = false;
+}
+
+} // namespace MeetingMindObsStub
+
+using namespace MeetingMindObsStub;
+
+extern "C" {
+
+// util/base.h
+
+void blog(int log_level, const char *format, ...)
+{
+    log_lines.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.log_ns);
+
+    char buffer[4096];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (log_output) {
+        fprintf(stderr, "[%d] %s\n", log_level, buffer);
+    }
+}
+
+// util/bmem.h
+
+void *bmalloc(size_t size)
+{
+    return malloc(size ? size : 1);
+}
+
+void *bzalloc(size_t size)
+{
+    return calloc(1, size ? size : 1);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+char *bstrdup(const char *str)
+{
+    if (!str) return nullptr;
+    const size_t size = strlen(str) + 1;
+    char *copy = (char *)bmalloc(size);
+    memcpy(copy, str, size);
+    return copy;
+}
+
+// util/platform.h
+
+uint64_t os_gettime_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// callback
+
+void *calldata_ptr(const calldata_t *data, const char *name)
+{
+    auto it = data->ptrs.find(name);
+    return it == data->ptrs.end() ? nullptr : it->second;
+}
+
+const char *calldata_string(const calldata_t *data, const char *name)
+{
+    auto it = data->strings.find(name);
+    return it == data->strings.end() ? nullptr : it->second.c_str();
+}
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data)
+{
+    std::lock_guard<std::mutex> lock(stub_mutex);
+    handler->connections.push_back({signal, callback, data});
+}
+
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+                               void *data)
+{
+    std::lock_guard<std::mutex> lock(stub_mutex);
+    auto &connections = handler->connections;
+    connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                     [&](const signal_handler::Connection &c) {
+                                         return c.signal == signal && c.callback == callback && c.data == data;
+                                     }),
+                      connections.end());
+}
+
+// obs.h
+
+signal_handler_t *obs_get_signal_handler(void)
+{
+    return &global_signals;
+}
+
+obs_source_t *obs_get_source_by_name(const char *name)
+{
+    source_lookups.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.source_lookup_ns);
+
+    std::lock_guard<std::mutex> lock(stub_mutex);
+    auto it = sources_by_name.find(name);
+    if (it == sources_by_name.end()) return nullptr;
+    it->second->refs++;
+    return it->second;
+}
+
+const char *obs_source_get_name(const obs_source_t *source)
+{
+    return source ? source->name.c_str() : nullptr;
+}
+
+void obs_source_release(obs_source_t *source)
+{
+    // Sources are owned by the stub until reset(), so this only balances
+    if (source) source->refs--;
+}
+
+obs_weak_source_t *obs_source_get_weak_source(obs_source_t *source)
+{
+    return source ? new obs_weak_source{source} : nullptr;
+}
+
+obs_source_t *obs_weak_source_get_source(obs_weak_source_t *weak)
+{
+    if (!weak || weak->source->destroyed) return nullptr;
+    weak->source->refs++;
+    return weak->source;
+}
+
+void obs_weak_source_release(obs_weak_source_t *weak)
+{
+    delete weak;
+}
+
+bool obs_weak_source_references_source(obs_weak_source_t *weak, obs_source_t *source)
+{
+    return weak && weak->source == source;
+}
+
+bool obs_source_muted(const obs_source_t *source)
+{
+    return source->muted;
+}
+
+void obs_source_set_muted(obs_source_t *source, bool muted)
+{
+    source_updates.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.source_update_ns);
+    source->muted = muted;
+}
+
+bool obs_source_enabled(const obs_source_t *source)
+{
+    return source->enabled;
+}
+
+void obs_source_set_enabled(obs_source_t *source, bool enabled)
+{
+    source_updates.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.source_update_ns);
+    source->enabled = enabled;
+}
+
+// media-io/audio-io.h
+
+audio_t *obs_get_audio(void)
+{
+    return &audio_format;
+}
+
+size_t audio_output_get_channels(const audio_t *audio)
+{
+    return audio->channels;
+}
+
+uint32_t audio_output_get_sample_rate(const audio_t *audio)
+{
+    return audio->sample_rate;
+}
+
+void obs_source_add_audio_capture_callback(obs_source_t *source, obs_audio_capture_cb callback, void *param)
+{
+    std::lock_guard<std::mutex> lock(source->audio_cb_mutex);
+    source->audio_callbacks.push_back({callback, param});
+}
+
+void obs_source_remove_audio_capture_callback(obs_source_t *source, obs_audio_capture_cb callback, void *param)
+{
+    std::lock_guard<std::mutex> lock(source->audio_cb_mutex);
+    auto &callbacks = source->audio_callbacks;
+    callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                   [&](const obs_source::AudioCallback &entry) {
+                                       return entry.callback == callback && entry.param == param;
+                                   }),
+                    callbacks.end());
+}
+
+// obs-module.h
+
+obs_module_t *obs_current_module(void)
+{
+    return nullptr;
+}
+
+char *obs_module_get_config_path(obs_module_t *, const char *file)
+{
+    return bstrdup((config_dir + "/" + file).c_str());
+}
+
+// util/config-file.h
+
+config_t *config_create(const char *file)
+{
+    config_t *config = new config_data;
+    config->path = file;
+    return config;
+}
+
+int config_open(config_t **config, const char *file, enum config_open_type open_type)
+{
+    config_ios.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.config_io_ns);
+
+    *config = nullptr;
+    std::ifstream in(file);
+    if (!in) {
+        if (open_type != CONFIG_OPEN_ALWAYS) return CONFIG_FILENOTFOUND;
+        *config = config_create(file);
+        return CONFIG_SUCCESS;
+    }
+
+    config_t *result = config_create(file);
+    std::string line;
+    std::string section;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+        if (line[0] == '[') {
+            section = line.substr(1, line.find(']') - 1);
+            continue;
+        }
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        result->sections[section][line.substr(0, eq)] = line.substr(eq + 1);
+    }
+    *config = result;
+    return CONFIG_SUCCESS;
+}
+
+static int write_config(const config_t *config, const std::string &path)
+{
+    config_ios.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.config_io_ns);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return CONFIG_ERROR;
+    for (const auto &section : config->sections) {
+        out << '[' << section.first << "]\n";
+        for (const auto &item : section.second) {
+            out << item.first << '=' << item.second << '\n';
+        }
+        out << '\n';
+    }
+    out.close();
+    return out ? CONFIG_SUCCESS : CONFIG_ERROR;
+}
+
+int config_save(config_t *config)
+{
+    return write_config(config, config->path);
+}
+
+int config_save_safe(config_t *config, const char *temp_ext, const char *backup_ext)
+{
+    const std::string temp_path = config->path + "." + temp_ext;
+    const int result = write_config(config, temp_path);
+    if (result != CONFIG_SUCCESS) return result;
+
+    if (backup_ext && *backup_ext) {
+        rename(config->path.c_str(), (config->path + "." + backup_ext).c_str());
+    }
+    return rename(temp_path.c_str(), config->path.c_str()) == 0 ? CONFIG_SUCCESS : CONFIG_ERROR;
+}
+
+void config_close(config_t *config)
+{
+    delete config;
+}
+
+bool config_has_user_value(config_t *config, const char *section, const char *name)
+{
+    auto it = config->sections.find(section);
+    return it != config->sections.end() && it->second.count(name) != 0;
+}
+
+const char *config_get_string(config_t *config, const char *section, const char *name)
+{
+    auto it = config->sections.find(section);
+    if (it == config->sections.end()) return nullptr;
+    auto item = it->second.find(name);
+    return item == it->second.end() ? nullptr : item->second.c_str();
+}
+
+int64_t config_get_int(config_t *config, const char *section, const char *name)
+{
+    const char *value = config_get_string(config, section, name);
+    return value ? strtoll(value, nullptr, 10) : 0;
+}
+
+bool config_get_bool(config_t *config, const char *section, const char *name)
+{
+    const char *value = config_get_string(config, section, name);
+    return value && (strcmp(value, "true") == 0 || strtoll(value, nullptr, 10) != 0);
+}
+
+void config_set_string(config_t *config, const char *section, const char *name, const char *value)
+{
+    config->sections[section][name] = value ? value : "";
+}
+
+void config_set_int(config_t *config, const char *section, const char *name, int64_t value)
+{
+    config->sections[section][name] = std::to_string(value);
+}
+
+void config_set_bool(config_t *config, const char *section, const char *name, bool value)
+{
+    config->sections[section][name] = value ? "true" : "false";
+}
+
+// obs-frontend-api.h
+
+void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void *private_data)
+{
+    std::lock_guard<std::mutex> lock(stub_mutex);
+    frontend_callbacks.push_back({callback, private_data});
+}
+
+void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void *private_data)
+{
+    std::lock_guard<std::mutex> lock(stub_mutex);
+    frontend_callbacks.erase(std::remove_if(frontend_callbacks.begin(), frontend_callbacks.end(),
+                                            [&](const FrontendCallback &c) {
+                                                return c.callback == callback && c.data == private_data;
+                                            }),
+                             frontend_callbacks.end());
+}
+
+obs_source_t *obs_frontend_get_current_scene(void)
+{
+    frontend_queries.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.frontend_query_ns);
+    if (current_scene) current_scene->refs++;
+    return current_scene;
+}
+
+void obs_frontend_set_current_scene(obs_source_t *scene)
+{
+    scene_switches.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.scene_switch_ns);
+    current_scene = scene;
+    emit_frontend(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+}
+
+bool obs_frontend_recording_active(void)
+{
+    frontend_queries.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.frontend_query_ns);
+    return recording;
+}
+
+bool obs_frontend_recording_paused(void)
+{
+    return false;
+}
+
+void obs_frontend_recording_start(void)
+{
+    toggle_output(recording, true, OBS_FRONTEND_EVENT_RECORDING_STARTING, OBS_FRONTEND_EVENT_RECORDING_STARTED,
+                  OBS_FRONTEND_EVENT_RECORDING_STOPPING, OBS_FRONTEND_EVENT_RECORDING_STOPPED);
+}
+
+void obs_frontend_recording_stop(void)
+{
+    toggle_output(recording, false, OBS_FRONTEND_EVENT_RECORDING_STARTING, OBS_FRONTEND_EVENT_RECORDING_STARTED,
+                  OBS_FRONTEND_EVENT_RECORDING_STOPPING, OBS_FRONTEND_EVENT_RECORDING_STOPPED);
+}
+
+bool obs_frontend_streaming_active(void)
+{
+    frontend_queries.fetch_add(1, std::memory_order_relaxed);
+    simulate(costs.frontend_query_ns);
+    return streaming;
+}
+
+void obs_frontend_streaming_start(void)
+{
+    toggle_output(streaming, true, OBS_FRONTEND_EVENT_STREAMING_STARTING, OBS_FRONTEND_EVENT_STREAMING_STARTED,
+                  OBS_FRONTEND_EVENT_STREAMING_STOPPING, OBS_FRONTEND_EVENT_STREAMING_STOPPED);
+}
+
+void obs_frontend_streaming_stop(void)
+{
+    toggle_output(streaming, false, OBS_FRONTEND_EVENT_STREAMING_STARTING, OBS_FRONTEND_EVENT_STREAMING_STARTED,
+                  OBS_FRONTEND_EVENT_STREAMING_STOPPING, OBS_FRONTEND_EVENT_STREAMING_STOPPED);
+}
+
+bool obs_frontend_replay_buffer_active(void)
+{
+    return false;
+}
+
+} // extern "C"
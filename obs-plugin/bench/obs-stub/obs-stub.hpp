@@ -0,0 +1,72 @@
+/*
+MeetingMind libobs Stub
+Control interface for the headless stand-in of libobs and the OBS frontend:
+populate sources, set simulated per-call costs and read call counts
+*/
+
+#pragma once
+
+#include <obs.h>
+
+#include <cstdint>
+#include <string>
+
+namespace MeetingMindObsStub {
+
+// CPU time each stubbed call burns before returning, to approximate what
+// the real call costs on the OBS UI thread. All zero by default.
+struct Costs {
+    uint64_t source_lookup_ns = 0;   // obs_get_source_by_name
+    uint64_t source_update_ns = 0;   // obs_source_set_muted, obs_source_set_enabled
+    uint64_t scene_switch_ns = 0;    // obs_frontend_set_current_scene
+    uint64_t frontend_query_ns = 0;  // obs_frontend_get_current_scene, *_active
+    uint64_t output_toggle_ns = 0;   // obs_frontend_recording_*, obs_frontend_streaming_*
+    uint64_t config_io_ns = 0;       // config_open, config_save
+    uint64_t log_ns = 0;             // blog
+};
+
+struct CallCounts {
+    uint64_t source_lookups = 0;
+    uint64_t source_updates = 0;
+    uint64_t scene_switches = 0;
+    uint64_t frontend_queries = 0;
+    uint64_t output_toggles = 0;
+    uint64_t config_ios = 0;
+    uint64_t log_lines = 0;
+};
+
+void set_costs(const Costs &costs);
+const Costs &get_costs();
+
+// blog() output goes to stderr when enabled; otherwise it is formatted and
+// discarded so that logging still costs what it would
+void set_log_output(bool enabled);
+
+// Directory obs_module_config_path() resolves into
+void set_config_dir(const std::string &dir);
+
+// Creates a source (or scene; the stub does not distinguish) and fires
+// source_create. The stub keeps the source until reset().
+obs_source_t *create_source(const char *name);
+
+// Fires source_remove and source_destroy; weak references stop resolving
+void remove_source(const char *name);
+
+// Delivers a frontend event to the registered callbacks
+void emit_frontend_event(obs_frontend_event event);
+
+// Output audio format reported by audio_output_get_*; 48 kHz stereo by
+// default
+void set_audio_format(size_t channels, uint32_t sample_rate);
+
+// Runs the source's audio capture callbacks on the calling thread with one
+// planar float block, as the OBS audio thread would
+void emit_audio(const char *name, const float *const *planes, uint32_t frames, uint64_t timestamp);
+
+CallCounts get_call_counts();
+void reset_call_counts();
+
+// Drops every source, callback and signal connection
+void reset();
+
+} // namespace MeetingMindObsStub
@@ -0,0 +1,132 @@
+/*
+MeetingMind Parser Benchmark
+Compares the SIMD event parser against the QJsonDocument path on a recorded
+event trace (one JSON frame per line)
+*/
+
+#include "event-parser.hpp"
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifndef MEETINGMIND_BENCH_TRACE_DIR
+#define MEETINGMIND_BENCH_TRACE_DIR "bench/traces"
+#endif
+
+// Count every heap allocation so the report can show allocations per frame
+static std::atomic<uint64_t> allocation_count{0};
+
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static volatile size_t sink = 0;
+
+// The parse the network worker did before the SIMD parser
+static bool parse_qjson(const QByteArray &frame)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(frame);
+    if (!doc.isObject()) return false;
+
+    QJsonObject obj = doc.object();
+    QJsonValue type = obj["type"];
+    QJsonValue data = obj["data"];
+    if (!type.isString() || (!data.isUndefined() && !data.isNull() && !data.isObject())) return false;
+
+    const QByteArray event_type = type.toString().toUtf8();
+    const QJsonObject event_data = data.toObject();
+    sink = sink + (size_t)event_type.size() + (size_t)event_data.size();
+    return true;
+}
+
+static bool parse_simd(const QByteArray &frame)
+{
+    MeetingMindJson::ObjectView obj;
+    if (!obj.parse(std::string_view(frame.constData(), (size_t)frame.size()))) return false;
+    if (!obj.is_string("type")) return false;
+
+    MeetingMindJson::ObjectView data;
+    const int data_index = obj.find("data");
+    if (data_index >= 0 && obj.kind(data_index) != MeetingMindJson::ValueKind::Null) {
+        if (obj.kind(data_index) != MeetingMindJson::ValueKind::Object || !data.parse(obj.value(data_index))) {
+            return false;
+        }
+    }
+
+    sink = sink + obj.raw_string("type").size() + data.size();
+    return true;
+}
+
+template <typename Parser>
+static void run(const char *name, const std::vector<QByteArray> &frames, size_t bytes, int iterations, Parser parse)
+{
+    size_t failures = 0;
+    const uint64_t allocations_before = allocation_count.load();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++) {
+        for (const QByteArray &frame : frames) {
+            if (!parse(frame)) failures++;
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double total_frames = (double)frames.size() * iterations;
+    const double allocations = (double)(allocation_count.load() - allocations_before);
+
+    printf("%-8s %8.1f ns/frame %9.1f MB/s %7.2f allocs/frame %zu rejected\n",
+           name, seconds * 1e9 / total_frames, (double)bytes * iterations / seconds / 1e6,
+           allocations / total_frames, failures / (size_t)iterations);
+}
+
+int main(int argc, char **argv)
+{
+    const std::string path = argc > 1 ? argv[1] : MEETINGMIND_BENCH_TRACE_DIR "/meeting-burst.jsonl";
+    const int iterations = argc > 2 ? atoi(argv[2]) : 2000;
+
+    std::ifstream trace(path);
+    if (!trace) {
+        fprintf(stderr, "Cannot open trace '%s'\n", path.c_str());
+        return 1;
+    }
+
+    std::vector<QByteArray> frames;
+    size_t bytes = 0;
+    std::string line;
+    while (std::getline(trace, line)) {
+        if (line.empty()) continue;
+        frames.push_back(QByteArray(line.data(), (int)line.size()));
+        bytes += line.size();
+    }
+
+    printf("MeetingMind parser benchmark: %zu frames, %zu bytes, %d iterations, scanner %s\n",
+           frames.size(), bytes, iterations, MeetingMindJson::scanner_name());
+
+    run("qjson", frames, bytes, iterations, parse_qjson);
+    run("simd", frames, bytes, iterations, parse_simd);
+    return 0;
+}
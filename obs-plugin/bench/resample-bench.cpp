@@ -0,0 +1,165 @@
+/*
+MeetingMind Resampler Benchmark
+Measures single-core throughput of each resampler kernel converting 48 kHz
+stereo to 16 kHz mono, and checks its response, its agreement with the
+scalar kernel and that streaming allocates nothing
+*/
+
+#include "resampler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using MeetingMindAudio::Resampler;
+using MeetingMindAudio::ResamplerKernel;
+
+static constexpr uint32_t INPUT_RATE = 48000;
+static constexpr uint32_t OUTPUT_RATE = 16000;
+static constexpr size_t CHANNELS = 2;
+static constexpr size_t BLOCK_FRAMES = 1024; // One OBS audio block
+static constexpr size_t TIMED_SECONDS = 600;
+
+static std::atomic<uint64_t> allocations{0};
+
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+static const ResamplerKernel KERNELS[] = {ResamplerKernel::Scalar, ResamplerKernel::Sse2, ResamplerKernel::Avx2,
+                                          ResamplerKernel::Neon};
+
+// Deterministic noise, so every kernel sees the same input
+static void fill_noise(std::vector<float> *planes, size_t frames)
+{
+    uint32_t state = 12345;
+    for (size_t c = 0; c < CHANNELS; c++) {
+        planes[c].resize(frames);
+        for (size_t i = 0; i < frames; i++) {
+            state = state * 1664525u + 1013904223u;
+            planes[c][i] = (float)((int32_t)state >> 8) / 8388608.0f * 0.5f;
+        }
+    }
+}
+
+// Runs the whole input through in blocks; returns the output
+static std::vector<float> convert(Resampler &resampler, const std::vector<float> *planes, size_t frames)
+{
+    std::vector<float> out(resampler.max_output(frames) + frames / BLOCK_FRAMES + 1);
+    size_t produced = 0;
+    for (size_t done = 0; done < frames; done += BLOCK_FRAMES) {
+        const size_t count = std::min(BLOCK_FRAMES, frames - done);
+        const float *block[CHANNELS] = {planes[0].data() + done, planes[1].data() + done};
+        produced += resampler.process(block, count, out.data() + produced);
+    }
+    out.resize(produced);
+    return out;
+}
+
+// Output level of a full-scale tone on both channels, in dB
+static double tone_gain_db(uint32_t input_rate, double frequency)
+{
+    const size_t frames = input_rate; // One second
+    std::vector<float> planes[CHANNELS];
+    for (auto &plane : planes) {
+        plane.resize(frames);
+        for (size_t i = 0; i < frames; i++) plane[i] = (float)std::sin(2.0 * M_PI * frequency * i / input_rate);
+    }
+    Resampler resampler(input_rate, OUTPUT_RATE, CHANNELS);
+    const std::vector<float> out = convert(resampler, planes, frames);
+
+    // Skip the filter's start-up
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = out.size() / 4; i < out.size(); i++, count++) sum += (double)out[i] * out[i];
+    return 10.0 * std::log10(sum / count / 0.5);
+}
+
+int main()
+{
+    printf("MeetingMind resampler benchmark (%u Hz stereo to %u Hz mono, %zu taps per phase, %zu-frame blocks)\n",
+           INPUT_RATE, OUTPUT_RATE, Resampler::TAPS_PER_PHASE, BLOCK_FRAMES);
+    {
+        Resampler resampler(INPUT_RATE, OUTPUT_RATE, CHANNELS);
+        printf("  best kernel %s, latency %.3f ms\n", Resampler::kernel_name(resampler.kernel()),
+               resampler.latency_ns() / 1e6);
+    }
+
+    bool failed = false;
+
+    printf("  response:");
+    for (double frequency : {1000.0, 5000.0, 6900.0, 9000.0, 12000.0, 20000.0}) {
+        printf("  %.1f kHz %.1f dB", frequency / 1000.0, tone_gain_db(INPUT_RATE, frequency));
+    }
+    printf("\n  at 44.1 kHz:");
+    for (double frequency : {1000.0, 9000.0, 20000.0}) {
+        printf("  %.1f kHz %.1f dB", frequency / 1000.0, tone_gain_db(44100, frequency));
+    }
+    printf("\n");
+    if (std::fabs(tone_gain_db(INPUT_RATE, 1000.0)) > 0.1 || tone_gain_db(INPUT_RATE, 9000.0) > -60.0) {
+        printf("  FAIL: response outside 0.1 dB passband or 60 dB stopband\n");
+        failed = true;
+    }
+
+    std::vector<float> planes[CHANNELS];
+    fill_noise(planes, INPUT_RATE * 10);
+    Resampler reference_resampler(INPUT_RATE, OUTPUT_RATE, CHANNELS, ResamplerKernel::Scalar);
+    const std::vector<float> reference = convert(reference_resampler, planes, planes[0].size());
+
+    std::vector<float> timed[CHANNELS];
+    fill_noise(timed, INPUT_RATE);
+    const size_t timed_frames = (size_t)INPUT_RATE * TIMED_SECONDS;
+    std::vector<float> out(BLOCK_FRAMES);
+
+    for (ResamplerKernel kernel : KERNELS) {
+        if (!Resampler::kernel_supported(kernel)) continue;
+
+        Resampler checked(INPUT_RATE, OUTPUT_RATE, CHANNELS, kernel);
+        const std::vector<float> result = convert(checked, planes, planes[0].size());
+        double max_error = result.size() == reference.size() ? 0.0 : 1.0;
+        for (size_t i = 0; i < std::min(result.size(), reference.size()); i++) {
+            max_error = std::max(max_error, (double)std::fabs(result[i] - reference[i]));
+        }
+
+        // Loops one second of noise so the input stays in cache, as the
+        // block from an audio callback would be
+        Resampler resampler(INPUT_RATE, OUTPUT_RATE, CHANNELS, kernel);
+        const uint64_t allocations_before = allocations.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        size_t produced = 0;
+        for (size_t done = 0; done < timed_frames; done += BLOCK_FRAMES) {
+            const size_t offset = done % (INPUT_RATE - BLOCK_FRAMES);
+            const float *block[CHANNELS] = {timed[0].data() + offset, timed[1].data() + offset};
+            produced += resampler.process(block, BLOCK_FRAMES, out.data());
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t block_allocations = allocations.load(std::memory_order_relaxed) - allocations_before;
+
+        const double frames_per_s = timed_frames / seconds;
+        printf("  %-7s %8.1f M frames/s  %8.1f M samples/s in  %7.1f M samples/s out  %6.0fx real time  "
+               "max diff %.2e  %llu allocations\n",
+               Resampler::kernel_name(kernel), frames_per_s / 1e6, frames_per_s * CHANNELS / 1e6,
+               produced / seconds / 1e6, frames_per_s / INPUT_RATE, max_error,
+               (unsigned long long)block_allocations);
+        if (max_error > 1e-5 || block_allocations) failed = true;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+/*
+MeetingMind Audio Ring Benchmark
+Measures producer-to-consumer throughput of the lock-free audio ring against
+a mutex-guarded ring, checking every sample and timestamp on the way
+*/
+
+#include "audio-ring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using MeetingMindAudio::AudioRing;
+
+static constexpr uint32_t SAMPLE_RATE = 48000;
+static constexpr size_t PLANES = 2;
+static constexpr size_t WRITE_FRAMES = 1024; // One OBS audio block
+static constexpr size_t READ_FRAMES = 480;   // 10 ms, as an encoder would take
+static constexpr size_t RING_FRAMES = 8192;
+static constexpr uint64_t TOTAL_FRAMES = 1ull << 27;
+
+static uint64_t frame_timestamp(uint64_t frame)
+{
+    return 1000000000ull + frame * 1000000000ull / SAMPLE_RATE;
+}
+
+// Sample values encode their frame number so the consumer can check them
+static float sample_value(uint64_t frame, size_t plane)
+{
+    return (float)((frame * 2 + plane) & 0xffffff);
+}
+
+// The ring that audio-stream used before, with a lock on each side
+class MutexRing {
+public:
+    MutexRing() : samples_(RING_FRAMES * PLANES) {}
+
+    size_t write(const float *const *planes, size_t frames, uint64_t)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t count = std::min(frames, RING_FRAMES - fill_);
+        for (size_t p = 0; p < PLANES; p++) {
+            for (size_t i = 0; i < count; i++) {
+                samples_[p * RING_FRAMES + (read_ + fill_ + i) % RING_FRAMES] = planes[p][i];
+            }
+        }
+        fill_ += count;
+        return count;
+    }
+
+    size_t read(float *const *planes, size_t frames, uint64_t *)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const size_t count = std::min(frames, fill_);
+        for (size_t p = 0; p < PLANES; p++) {
+            for (size_t i = 0; i < count; i++) {
+                planes[p][i] = samples_[p * RING_FRAMES + (read_ + i) % RING_FRAMES];
+            }
+        }
+        read_ = (read_ + count) % RING_FRAMES;
+        fill_ -= count;
+        return count;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<float> samples_;
+    size_t read_ = 0;
+    size_t fill_ = 0;
+};
+
+struct Result {
+    double seconds = 0.0;
+    uint64_t sample_errors = 0;
+    uint64_t timestamp_errors = 0;
+};
+
+// With verify, the producer numbers every sample and the consumer checks
+// them; without it both sides only move data, which is what gets timed
+template <typename Ring>
+static Result run(Ring &ring, bool verify, bool check_timestamps)
+{
+    Result result;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&ring, verify]() {
+        std::vector<float> block[PLANES];
+        for (auto &plane : block) plane.resize(WRITE_FRAMES);
+        const float *planes[PLANES] = {block[0].data(), block[1].data()};
+
+        for (uint64_t frame = 0; frame < TOTAL_FRAMES; frame += WRITE_FRAMES) {
+            for (size_t p = 0; verify && p < PLANES; p++) {
+                for (size_t i = 0; i < WRITE_FRAMES; i++) block[p][i] = sample_value(frame + i, p);
+            }
+            // A real producer would drop the rest; here it waits for room so
+            // that every frame arrives
+            size_t written = 0;
+            while (written < WRITE_FRAMES) {
+                const float *rest[PLANES] = {planes[0] + written, planes[1] + written};
+                const size_t count = ring.write(rest, WRITE_FRAMES - written, frame_timestamp(frame + written));
+                if (!count) std::this_thread::yield();
+                written += count;
+            }
+        }
+    });
+
+    std::vector<float> block[PLANES];
+    for (auto &plane : block) plane.resize(READ_FRAMES);
+    for (uint64_t frame = 0; frame < TOTAL_FRAMES;) {
+        float *planes[PLANES] = {block[0].data(), block[1].data()};
+        uint64_t timestamp = 0;
+        const size_t count = ring.read(planes, (size_t)std::min<uint64_t>(READ_FRAMES, TOTAL_FRAMES - frame),
+                                       &timestamp);
+        if (!count) {
+            std::this_thread::yield();
+            continue;
+        }
+        // Dates inside a write are extrapolated, so allow the nanosecond
+        // that integer rounding can cost
+        const int64_t timestamp_error = (int64_t)(timestamp - frame_timestamp(frame));
+        if (check_timestamps && (timestamp_error > 1 || timestamp_error < -1)) result.timestamp_errors++;
+        for (size_t p = 0; verify && p < PLANES; p++) {
+            for (size_t i = 0; i < count; i++) {
+                if (block[p][i] != sample_value(frame + i, p)) result.sample_errors++;
+            }
+        }
+        frame += count;
+    }
+
+    producer.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static void report(const char *name, const Result &checked, const Result &timed)
+{
+    const double frames_per_s = TOTAL_FRAMES / timed.seconds;
+    printf("  %-10s %8.1f M frames/s  %6.2f GB/s  %7.0fx real time  %llu sample errors, %llu timestamp errors\n",
+           name, frames_per_s / 1e6, frames_per_s * PLANES * sizeof(float) / 1e9, frames_per_s / SAMPLE_RATE,
+           (unsigned long long)checked.sample_errors, (unsigned long long)checked.timestamp_errors);
+}
+
+int main()
+{
+    printf("MeetingMind audio ring benchmark (%llu stereo frames, %zu-frame writes, %zu-frame reads, "
+           "%zu-frame ring)\n",
+           (unsigned long long)TOTAL_FRAMES, WRITE_FRAMES, READ_FRAMES, RING_FRAMES);
+
+    AudioRing ring(RING_FRAMES, PLANES, SAMPLE_RATE);
+    const Result checked = run(ring, true, true);
+    ring.reset();
+    report("lock-free", checked, run(ring, false, true));
+    printf("  %-10s %llu overrun frames, %llu underrun frames while the sides waited on each other\n", "",
+           (unsigned long long)ring.overrun_frames(), (unsigned long long)ring.underrun_frames());
+
+    MutexRing mutex_ring;
+    const Result mutex_checked = run(mutex_ring, true, false);
+    report("mutex", mutex_checked, run(mutex_ring, false, false));
+
+    return checked.sample_errors || checked.timestamp_errors ? 1 : 0;
+}
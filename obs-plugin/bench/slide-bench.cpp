@@ -0,0 +1,276 @@
+/*
+MeetingMind Slide Detector Benchmark
+Measures each slide kernel on captured-size frames, checks it against the
+scalar kernel, and plays a synthetic presentation through the detector to
+check where it finds slide changes
+*/
+
+#include "slide-detector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using MeetingMindVideo::SlideDetector;
+using MeetingMindVideo::SlideEvent;
+using MeetingMindVideo::SlideEventType;
+using MeetingMindVideo::SlideKernel;
+using MeetingMindVideo::CAPTURE_HEIGHT;
+using MeetingMindVideo::CAPTURE_WIDTH;
+using MeetingMindVideo::THUMB_SIZE;
+using MeetingMindVideo::BLOCK_COUNT;
+
+static const SlideKernel KERNELS[] = {SlideKernel::Scalar, SlideKernel::Sse2, SlideKernel::Neon};
+
+// Rows padded as a GPU staging surface would be
+static constexpr uint32_t LINESIZE = CAPTURE_WIDTH * 4 + 64;
+static constexpr size_t TIMED_FRAMES = 20000;
+
+class Frame {
+public:
+    Frame() : pixels(LINESIZE * CAPTURE_HEIGHT) {}
+
+    void fill(uint8_t r, uint8_t g, uint8_t b) { rect(0, 0, CAPTURE_WIDTH, CAPTURE_HEIGHT, r, g, b); }
+
+    void rect(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, uint8_t r, uint8_t g, uint8_t b)
+    {
+        for (uint32_t y = y0; y < std::min(y1, CAPTURE_HEIGHT); y++) {
+            for (uint32_t x = x0; x < std::min(x1, CAPTURE_WIDTH); x++) {
+                uint8_t *pixel = &pixels[(size_t)y * LINESIZE + x * 4];
+                pixel[0] = r;
+                pixel[1] = g;
+                pixel[2] = b;
+                pixel[3] = 255;
+            }
+        }
+    }
+
+    void noise(std::mt19937 &rng, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+    {
+        for (uint32_t y = y0; y < y1; y++) {
+            for (uint32_t x = x0; x < x1; x++) {
+                const uint32_t value = rng();
+                memcpy(&pixels[(size_t)y * LINESIZE + x * 4], &value, 4);
+            }
+        }
+    }
+
+    // Cross-fade: a proportion t of other
+    void blend(const Frame &from, const Frame &to, float t)
+    {
+        for (size_t i = 0; i < pixels.size(); i++) {
+            pixels[i] = (uint8_t)(from.pixels[i] * (1.0f - t) + to.pixels[i] * t + 0.5f);
+        }
+    }
+
+    const uint8_t *data() const { return pixels.data(); }
+
+private:
+    std::vector<uint8_t> pixels;
+};
+
+// A slide: a title bar and lines of "text", each line a run of word-sized
+// bars; build shows only the first lines
+static void draw_slide(Frame &frame, uint32_t seed, uint32_t lines)
+{
+    std::mt19937 rng(seed);
+    frame.fill(245, 245, 240);
+    frame.rect(0, 0, CAPTURE_WIDTH, 44, 30, 60, 120);
+    frame.rect(24, 14, 24 + 120 + rng() % 200, 30, 250, 250, 250);
+    for (uint32_t line = 0; line < lines; line++) {
+        const uint32_t y = 70 + line * 34;
+        uint32_t x = 40;
+        const uint32_t end = 200 + rng() % 260;
+        frame.rect(28, y + 3, 34, y + 9, 30, 60, 120);
+        while (x < end) {
+            const uint32_t word = 12 + rng() % 40;
+            frame.rect(x, y, std::min(x + word, end), y + 12, 40, 40, 40);
+            x += word + 6;
+        }
+    }
+}
+
+static void check_kernels()
+{
+    std::mt19937 rng(3);
+    Frame frame;
+    frame.noise(rng, 0, 0, CAPTURE_WIDTH, CAPTURE_HEIGHT);
+
+    const SlideDetector scalar(MeetingMindVideo::SlideParams(), SlideKernel::Scalar);
+    std::vector<uint8_t> expected(THUMB_SIZE);
+    std::vector<uint8_t> other(THUMB_SIZE);
+    scalar.reduce(frame.data(), LINESIZE, expected.data());
+    for (uint8_t &value : other) value = (uint8_t)rng();
+    uint16_t expected_sums[BLOCK_COUNT];
+    scalar.block_differences(expected.data(), other.data(), expected_sums);
+
+    for (SlideKernel kernel : KERNELS) {
+        if (!SlideDetector::kernel_supported(kernel) || kernel == SlideKernel::Scalar) continue;
+        const SlideDetector detector(MeetingMindVideo::SlideParams(), kernel);
+        std::vector<uint8_t> thumbnail(THUMB_SIZE);
+        detector.reduce(frame.data(), LINESIZE, thumbnail.data());
+        uint16_t sums[BLOCK_COUNT];
+        detector.block_differences(expected.data(), other.data(), sums);
+        const bool same = thumbnail == expected && memcmp(sums, expected_sums, sizeof(sums)) == 0;
+        printf("  %-6s matches scalar: %s\n", SlideDetector::kernel_name(kernel), same ? "yes" : "NO");
+        if (!same) exit(1);
+    }
+}
+
+static void time_kernels()
+{
+    std::mt19937 rng(4);
+    Frame frame;
+    frame.noise(rng, 0, 0, CAPTURE_WIDTH, CAPTURE_HEIGHT);
+    std::vector<uint8_t> a(THUMB_SIZE);
+    std::vector<uint8_t> b(THUMB_SIZE);
+    for (uint8_t &value : b) value = (uint8_t)rng();
+
+    for (SlideKernel kernel : KERNELS) {
+        if (!SlideDetector::kernel_supported(kernel)) continue;
+        const SlideDetector detector(MeetingMindVideo::SlideParams(), kernel);
+        uint16_t sums[BLOCK_COUNT];
+        uint32_t checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < TIMED_FRAMES; i++) {
+            detector.reduce(frame.data(), LINESIZE, a.data());
+            checksum += a[i % THUMB_SIZE];
+        }
+        const double reduce_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < TIMED_FRAMES; i++) {
+            detector.block_differences(a.data(), b.data(), sums);
+            checksum += sums[i % BLOCK_COUNT];
+        }
+        const double diff_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("  %-6s reduce %ux%u RGBA %6.1f us (%5.0f Mpixel/s), block differences %5.2f us  [%u]\n",
+               SlideDetector::kernel_name(kernel), CAPTURE_WIDTH, CAPTURE_HEIGHT, reduce_s * 1e6 / TIMED_FRAMES,
+               (double)CAPTURE_WIDTH * CAPTURE_HEIGHT * TIMED_FRAMES / reduce_s / 1e6, diff_s * 1e6 / TIMED_FRAMES,
+               checksum & 0xff);
+    }
+}
+
+static const char *event_name(SlideEventType type)
+{
+    switch (type) {
+    case SlideEventType::PresentationStarted:
+        return "presentation_started";
+    case SlideEventType::SlideChanged:
+        return "slide_changed";
+    case SlideEventType::PresentationEnded:
+        return "presentation_ended";
+    case SlideEventType::None:
+        break;
+    }
+    return "none";
+}
+
+// Four frames a second of: a black screen, four slides and a build, a
+// pointer wandering, a cross-fade, a slide playing a video clip, which only
+// counts once the clip stops, and black at the end. Expected events are at
+// the times marked.
+static int run_presentation()
+{
+    const uint64_t interval_ns = MeetingMindVideo::SlideParams().interval_ms * 1000000ull;
+    struct Segment {
+        const char *what;
+        double seconds;
+        uint32_t seed;       // 0 for black
+        uint32_t lines;
+        bool pointer;
+        bool video;
+        bool fade_in;        // Cross-fades from the previous segment over its first second
+        const char *expects; // Event at the segment's start, or nullptr
+    };
+    static const Segment script[] = {
+        {"black", 3.0, 0, 0, false, false, false, nullptr},
+        {"slide 1", 8.0, 11, 4, true, false, false, "presentation_started"},
+        {"slide 1 build", 6.0, 11, 5, true, false, false, "slide_changed"},
+        {"slide 2", 10.0, 12, 3, true, false, true, "slide_changed"},
+        {"slide 3 video", 8.0, 13, 2, false, true, false, nullptr},
+        {"slide 3", 6.0, 13, 2, false, false, false, "slide_changed"},
+        {"slide 4", 7.0, 14, 5, true, false, false, "slide_changed"},
+        {"black", 4.0, 0, 0, false, false, false, "presentation_ended"},
+    };
+
+    SlideDetector detector;
+    Frame previous;
+    Frame slide;
+    Frame frame;
+    std::vector<uint8_t> thumbnail(THUMB_SIZE);
+    std::mt19937 rng(9);
+
+    struct Mark {
+        const char *expects;
+        uint64_t at_ns;
+    };
+    std::vector<Mark> marks;
+    std::vector<SlideEvent> events;
+    uint64_t now = 0;
+    size_t samples = 0;
+    for (const Segment &segment : script) {
+        if (segment.expects) marks.push_back({segment.expects, now});
+        if (segment.seed) {
+            draw_slide(slide, segment.seed, segment.lines);
+        } else {
+            slide.fill(0, 0, 0);
+        }
+        const uint64_t start = now;
+        const uint64_t end = now + (uint64_t)(segment.seconds * 1e9);
+        for (; now < end; now += interval_ns, samples++) {
+            const double t = (now - start) / 1e9;
+            if (segment.fade_in && t < 1.0) {
+                frame.blend(previous, slide, (float)t);
+            } else {
+                frame = slide;
+            }
+            if (segment.pointer) {
+                const uint32_t x = 60 + (uint32_t)(t * 37.0) % 380;
+                const uint32_t y = 80 + (uint32_t)(t * 23.0) % 180;
+                frame.rect(x, y, x + 6, y + 9, 0, 0, 0);
+            }
+            if (segment.video) frame.noise(rng, 300, 150, 460, 240);
+            detector.reduce(frame.data(), LINESIZE, thumbnail.data());
+            const SlideEvent event = detector.process(thumbnail.data(), now);
+            if (event.type != SlideEventType::None) {
+                events.push_back(event);
+                printf("  %6.2f s  %-20s slide %u, %3u blocks changed, hash %016llx, content from %.2f s\n",
+                       now / 1e9, event_name(event.type), event.slide, event.changed_blocks,
+                       (unsigned long long)event.hash, event.timestamp_ns / 1e9);
+            }
+        }
+        previous = frame;
+    }
+
+    // Each mark should have its event, with the content dated to within a
+    // frame of the change and nothing else reported
+    int failures = events.size() == marks.size() ? 0 : 1;
+    for (size_t i = 0; i < std::min(events.size(), marks.size()); i++) {
+        const bool type_ok = strcmp(event_name(events[i].type), marks[i].expects) == 0;
+        const int64_t error_ns = (int64_t)events[i].timestamp_ns - (int64_t)marks[i].at_ns;
+        // A cross-fade settles at its end
+        const bool time_ok = error_ns >= -(int64_t)interval_ns && error_ns <= 1000000000ll + (int64_t)interval_ns;
+        if (!type_ok || !time_ok) failures++;
+    }
+    printf("  %zu frames, %zu events for %zu expected: %s\n", samples, events.size(), marks.size(),
+           failures ? "MISMATCH" : "ok");
+    return failures;
+}
+
+int main()
+{
+    printf("MeetingMind slide detector: %ux%u capture to %ux%u luma, best kernel %s\n", CAPTURE_WIDTH,
+           CAPTURE_HEIGHT, MeetingMindVideo::THUMB_WIDTH, MeetingMindVideo::THUMB_HEIGHT,
+           SlideDetector::kernel_name(SlideDetector::best_kernel()));
+    check_kernels();
+    time_kernels();
+    printf("synthetic presentation:\n");
+    return run_presentation() ? 1 : 0;
+}
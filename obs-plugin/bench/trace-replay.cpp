@@ -0,0 +1,194 @@
+/*
+MeetingMind Trace Replay
+Feeds a recorded event trace back through the network worker's frame
+handlers, at recorded speed, a multiple of it or as fast as possible, and
+dispatches the resulting events against the libobs stub
+*/
+
+#include "bench-handlers.hpp"
+
+#include "action-executor.hpp"
+#include "latency-histogram.hpp"
+#include "network-worker.hpp"
+#include "obs-stub.hpp"
+#include "trace-file.hpp"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QString>
+#include <QThread>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using MeetingMindLatency::LatencyHistogram;
+
+struct Options {
+    const char *trace_path = nullptr;
+    double speed = 1.0; // 0 replays as fast as the worker accepts frames
+    size_t coalesce_every = 0;
+};
+
+static void print_latency(const char *label, const LatencyHistogram &histogram)
+{
+    printf("  %-22s p50 %8.2f us  p99 %8.2f us  max %9.2f us\n", label,
+           histogram.percentile(0.50) / 1000.0, histogram.percentile(0.99) / 1000.0, histogram.max() / 1000.0);
+}
+
+static bool parse_options(int argc, char **argv, Options &options)
+{
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (arg[0] != '-') {
+            if (options.trace_path) return false;
+            options.trace_path = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        const char *value = argv[++i];
+
+        if (!strcmp(arg, "--speed")) {
+            options.speed = strcmp(value, "max") ? strtod(value, nullptr) : 0.0;
+            if (strcmp(value, "max") && options.speed <= 0.0) {
+                fprintf(stderr, "Invalid speed %s\n", value);
+                return false;
+            }
+        } else if (!strcmp(arg, "--coalesce-every")) {
+            options.coalesce_every = strtoull(value, nullptr, 10);
+        } else {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+    }
+    return options.trace_path != nullptr;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        fprintf(stderr, "usage: %s TRACE [--speed 1|10|max] [--coalesce-every N]\n", argv[0]);
+        return 2;
+    }
+
+    // The whole trace is loaded up front so that file reads do not disturb
+    // the replay schedule
+    std::vector<MeetingMindTrace::TraceRecord> records;
+    MeetingMindTrace::TraceReader reader;
+    if (!reader.open(options.trace_path)) {
+        fprintf(stderr, "%s is not a MeetingMind trace\n", options.trace_path);
+        return 1;
+    }
+    MeetingMindTrace::TraceRecord record;
+    while (reader.next(record)) records.push_back(record);
+    reader.close();
+
+    BenchHandlers::setup_obs();
+    BenchHandlers::set_coalescing(options.coalesce_every > 0);
+
+    QThread network_thread;
+    MeetingMindNetworkWorker *worker = new MeetingMindNetworkWorker();
+    worker->moveToThread(&network_thread);
+    QObject::connect(&network_thread, &QThread::finished, worker, &QObject::deleteLater);
+    network_thread.start();
+
+    // Same drain as the plugin's UI thread: dispatch everything queued, and
+    // measure from the frame reaching the worker to its actions being done
+    LatencyHistogram latency;
+    size_t dispatched = 0;
+    size_t unknown = 0;
+    auto drain = [&]() {
+        worker->begin_drain();
+        MeetingEvent event;
+        while (worker->pop_event(event)) {
+            if (!BenchHandlers::dispatch(event.type, event.data)) unknown++;
+            dispatched++;
+            if (BenchHandlers::coalescing() && dispatched % options.coalesce_every == 0) {
+                BenchHandlers::flush_coalesced();
+            }
+            latency.record(os_gettime_ns() - event.received_ns);
+        }
+    };
+    QObject::connect(worker, &MeetingMindNetworkWorker::events_ready, &app, drain, Qt::QueuedConnection);
+
+    // How late each frame was handed to the worker against its schedule
+    LatencyHistogram slip;
+    const MeetingMindActions::ExecutorStats before = MeetingMindActions::get_executor_stats();
+    const uint64_t start = os_gettime_ns();
+
+    std::thread feeder([&]() {
+        for (const MeetingMindTrace::TraceRecord &frame : records) {
+            if (options.speed > 0.0) {
+                const uint64_t due = start + (uint64_t)(frame.arrival_ns / options.speed);
+                uint64_t now = os_gettime_ns();
+                if (now < due) {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+                    now = os_gettime_ns();
+                }
+                slip.record(now > due ? now - due : 0);
+            }
+
+            const QByteArray payload(frame.payload.data(), (int)frame.payload.size());
+            if (frame.binary) {
+                QMetaObject::invokeMethod(worker, "on_websocket_binary_message", Qt::QueuedConnection,
+                                          Q_ARG(QByteArray, payload));
+            } else {
+                QMetaObject::invokeMethod(worker, "on_websocket_message", Qt::QueuedConnection,
+                                          Q_ARG(QString, QString::fromUtf8(payload)));
+            }
+        }
+
+        // Queued behind the last frame: once the worker reaches it, every
+        // event has been published, so a final drain on the main thread sees
+        // them all
+        QMetaObject::invokeMethod(worker, [&]() {
+            QMetaObject::invokeMethod(&app, [&]() {
+                drain();
+                if (BenchHandlers::coalescing()) BenchHandlers::flush_coalesced();
+                app.quit();
+            }, Qt::QueuedConnection);
+        }, Qt::QueuedConnection);
+    });
+
+    app.exec();
+    feeder.join();
+    const double seconds = (os_gettime_ns() - start) / 1e9;
+
+    const MeetingMindActions::ExecutorStats after = MeetingMindActions::get_executor_stats();
+    const uint64_t dropped = worker->dropped_events();
+    const uint64_t invalid = worker->invalid_messages();
+    const uint64_t duplicates = worker->duplicate_events();
+
+    network_thread.quit();
+    network_thread.wait();
+
+    char speed[32];
+    if (options.speed > 0.0) {
+        snprintf(speed, sizeof(speed), "%gx", options.speed);
+    } else {
+        snprintf(speed, sizeof(speed), "max");
+    }
+    printf("replay %s at %s speed%s:\n", options.trace_path, speed,
+           BenchHandlers::coalescing() ? ", coalesced" : "");
+    printf("  %zu frames in %.3f s, %.0f frames/s\n", records.size(), seconds, records.size() / seconds);
+    printf("  %zu events dispatched, %zu unknown; %llu dropped, %llu invalid, %llu duplicates\n", dispatched,
+           unknown, (unsigned long long)dropped, (unsigned long long)invalid, (unsigned long long)duplicates);
+    print_latency("frame -> actions done", latency);
+    if (options.speed > 0.0) print_latency("schedule slip", slip);
+    printf("  actions %llu applied, %llu redundant skipped\n",
+           (unsigned long long)(after.applied - before.applied),
+           (unsigned long long)(after.skipped - before.skipped));
+
+    BenchHandlers::shutdown_obs();
+    return 0;
+}
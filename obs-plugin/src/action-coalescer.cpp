@@ -0,0 +1,86 @@
+/*
+MeetingMind Action Coalescer
+Collapses bursts of scene, mute and visibility requests into the final
+target state
+*/
+
+#include "action-coalescer.hpp"
+
+namespace MeetingMindActions {
+
+void ActionCoalescer::request_scene(const char *scene_name)
+{
+    if (scene_pending) {
+        coalesced_count++;
+    } else {
+        scene_pending = true;
+        pending_count++;
+    }
+    scene.assign(scene_name);
+}
+
+void ActionCoalescer::request_mute(const char *source_name, bool muted)
+{
+    request_source(mute_targets, source_name, muted);
+}
+
+void ActionCoalescer::request_visibility(const char *source_name, bool visible)
+{
+    request_source(visibility_targets, source_name, visible);
+}
+
+void ActionCoalescer::request_source(std::vector<SourceTarget> &targets, const char *source_name, bool value)
+{
+    for (SourceTarget &target : targets) {
+        if (target.name == source_name) {
+            if (target.pending) {
+                coalesced_count++;
+            } else {
+                target.pending = true;
+                pending_count++;
+            }
+            target.value = value;
+            return;
+        }
+    }
+
+    targets.push_back(SourceTarget{source_name, value, true});
+    pending_count++;
+}
+
+size_t ActionCoalescer::flush(const Callbacks &callbacks)
+{
+    size_t calls = 0;
+
+    // Audio first so that a scene change never exposes a stale mute state
+    for (SourceTarget &target : mute_targets) {
+        if (!target.pending) continue;
+        target.pending = false;
+        callbacks.set_mute(target.name.c_str(), target.value);
+        calls++;
+    }
+    for (SourceTarget &target : visibility_targets) {
+        if (!target.pending) continue;
+        target.pending = false;
+        callbacks.set_visibility(target.name.c_str(), target.value);
+        calls++;
+    }
+    if (scene_pending) {
+        scene_pending = false;
+        callbacks.switch_scene(scene.c_str());
+        calls++;
+    }
+
+    pending_count = 0;
+    return calls;
+}
+
+void ActionCoalescer::clear()
+{
+    scene_pending = false;
+    for (SourceTarget &target : mute_targets) target.pending = false;
+    for (SourceTarget &target : visibility_targets) target.pending = false;
+    pending_count = 0;
+}
+
+} // namespace MeetingMindActions
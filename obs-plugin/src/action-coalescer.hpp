@@ -0,0 +1,61 @@
+/*
+MeetingMind Action Coalescer
+Collapses bursts of scene, mute and visibility requests into the final
+target state so that each burst reaches OBS as at most one change per target
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MeetingMindActions {
+
+class ActionCoalescer {
+public:
+    struct Callbacks {
+        void (*switch_scene)(const char *scene_name);
+        void (*set_mute)(const char *source_name, bool muted);
+        void (*set_visibility)(const char *source_name, bool visible);
+    };
+
+    // Record the latest requested state; earlier requests for the same
+    // target are superseded
+    void request_scene(const char *scene_name);
+    void request_mute(const char *source_name, bool muted);
+    void request_visibility(const char *source_name, bool visible);
+
+    bool empty() const { return pending_count == 0; }
+
+    // Applies the final state of every target and clears the pending set.
+    // Returns the number of OBS calls made.
+    size_t flush(const Callbacks &callbacks);
+
+    void clear();
+
+    // Requests absorbed by a later request for the same target
+    uint64_t coalesced_requests() const { return coalesced_count; }
+
+private:
+    struct SourceTarget {
+        std::string name;
+        bool value;
+        bool pending;
+    };
+
+    void request_source(std::vector<SourceTarget> &targets, const char *source_name, bool value);
+
+    // Entries are kept across flushes so that steady-state requests reuse
+    // their string storage instead of allocating
+    std::string scene;
+    bool scene_pending = false;
+    std::vector<SourceTarget> mute_targets;
+    std::vector<SourceTarget> visibility_targets;
+
+    size_t pending_count = 0;
+    uint64_t coalesced_count = 0;
+};
+
+} // namespace MeetingMindActions
@@ -0,0 +1,210 @@
+/*
+MeetingMind Action Executor
+Applies scene, audio and output actions to OBS, skipping calls that would
+not change anything
+*/
+
+#include "action-executor.hpp"
+#include "source-cache.hpp"
+
+#include <obs-module.h>
+#include <obs-frontend-api.h>
+
+namespace MeetingMindActions {
+
+namespace {
+
+enum class OutputState {
+    Stopped,
+    Starting,
+    Active,
+    Stopping,
+};
+
+// Cached view of frontend state, updated from frontend events. Mute and
+// enabled state are read from the source itself, which is a plain atomic
+// read on a handle the source cache already gives us.
+obs_weak_source_t *current_scene = nullptr;
+OutputState recording_state = OutputState::Stopped;
+OutputState streaming_state = OutputState::Stopped;
+
+uint64_t applied_count = 0;
+uint64_t skipped_count = 0;
+
+void refresh_current_scene()
+{
+    obs_source_t *scene = obs_frontend_get_current_scene();
+    obs_weak_source_release(current_scene);
+    current_scene = scene ? obs_source_get_weak_source(scene) : nullptr;
+    obs_source_release(scene);
+}
+
+void refresh_output_state()
+{
+    recording_state = obs_frontend_recording_active() ? OutputState::Active : OutputState::Stopped;
+    streaming_state = obs_frontend_streaming_active() ? OutputState::Active : OutputState::Stopped;
+}
+
+void on_frontend_event(enum obs_frontend_event event, void *)
+{
+    switch (event) {
+    case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+        refresh_current_scene();
+        refresh_output_state();
+        break;
+    case OBS_FRONTEND_EVENT_SCENE_CHANGED:
+    case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+        refresh_current_scene();
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_STARTING:
+        recording_state = OutputState::Starting;
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_STARTED:
+        recording_state = OutputState::Active;
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_STOPPING:
+        recording_state = OutputState::Stopping;
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
+        recording_state = OutputState::Stopped;
+        break;
+    case OBS_FRONTEND_EVENT_STREAMING_STARTING:
+        streaming_state = OutputState::Starting;
+        break;
+    case OBS_FRONTEND_EVENT_STREAMING_STARTED:
+        streaming_state = OutputState::Active;
+        break;
+    case OBS_FRONTEND_EVENT_STREAMING_STOPPING:
+        streaming_state = OutputState::Stopping;
+        break;
+    case OBS_FRONTEND_EVENT_STREAMING_STOPPED:
+        streaming_state = OutputState::Stopped;
+        break;
+    case OBS_FRONTEND_EVENT_EXIT:
+        obs_weak_source_release(current_scene);
+        current_scene = nullptr;
+        break;
+    default:
+        break;
+    }
+}
+
+bool is_running(OutputState state)
+{
+    return state == OutputState::Starting || state == OutputState::Active;
+}
+
+} // namespace
+
+void init_executor()
+{
+    obs_frontend_add_event_callback(on_frontend_event, nullptr);
+}
+
+void shutdown_executor()
+{
+    obs_frontend_remove_event_callback(on_frontend_event, nullptr);
+    obs_weak_source_release(current_scene);
+    current_scene = nullptr;
+}
+
+void switch_scene(const char *scene_name)
+{
+    obs_source_t *scene = MeetingMindSourceCache::acquire(scene_name);
+    if (!scene) {
+        blog(LOG_WARNING, "MeetingMind: Scene '%s' not found", scene_name);
+        return;
+    }
+
+    if (current_scene && obs_weak_source_references_source(current_scene, scene)) {
+        skipped_count++;
+    } else {
+        obs_frontend_set_current_scene(scene);
+        applied_count++;
+        blog(LOG_INFO, "MeetingMind: Switched to scene '%s'", scene_name);
+    }
+    obs_source_release(scene);
+}
+
+void set_mute(const char *source_name, bool muted)
+{
+    obs_source_t *source = MeetingMindSourceCache::acquire(source_name);
+    if (!source) return;
+
+    if (obs_source_muted(source) == muted) {
+        skipped_count++;
+    } else {
+        obs_source_set_muted(source, muted);
+        applied_count++;
+        blog(LOG_INFO, "MeetingMind: Set source '%s' mute to %s",
+             source_name, muted ? "muted" : "unmuted");
+    }
+    obs_source_release(source);
+}
+
+void set_visibility(const char *source_name, bool visible)
+{
+    obs_source_t *source = MeetingMindSourceCache::acquire(source_name);
+    if (!source) return;
+
+    if (obs_source_enabled(source) == visible) {
+        skipped_count++;
+    } else {
+        obs_source_set_enabled(source, visible);
+        applied_count++;
+        blog(LOG_INFO, "MeetingMind: Set source '%s' visibility to %s",
+             source_name, visible ? "visible" : "hidden");
+    }
+    obs_source_release(source);
+}
+
+void start_recording()
+{
+    if (is_running(recording_state)) {
+        skipped_count++;
+        return;
+    }
+    obs_frontend_recording_start();
+    applied_count++;
+    blog(LOG_INFO, "MeetingMind: Started recording");
+}
+
+void stop_recording()
+{
+    if (!is_running(recording_state)) {
+        skipped_count++;
+        return;
+    }
+    obs_frontend_recording_stop();
+    applied_count++;
+    blog(LOG_INFO, "MeetingMind: Stopped recording");
+}
+
+void start_streaming()
+{
+    if (is_running(streaming_state)) {
+        skipped_count++;
+        return;
+    }
+    obs_frontend_streaming_start();
+    applied_count++;
+    blog(LOG_INFO, "MeetingMind: Started streaming");
+}
+
+void stop_streaming()
+{
+    if (!is_running(streaming_state)) {
+        skipped_count++;
+        return;
+    }
+    obs_frontend_streaming_stop();
+    applied_count++;
+    blog(LOG_INFO, "MeetingMind: Stopped streaming");
+}
+
+ExecutorStats get_executor_stats()
+{
+    return ExecutorStats{applied_count, skipped_count};
+}
+
+} // namespace MeetingMindActions
@@ -0,0 +1,31 @@
+/*
+MeetingMind Action Executor
+Applies scene, audio and output actions to OBS, skipping calls that would
+not change anything
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace MeetingMindActions {
+    struct ExecutorStats {
+        uint64_t applied;
+        uint64_t skipped;
+    };
+
+    // Registers the frontend callback that keeps the cached scene and
+    // output state current. UI thread only, like every action below.
+    void init_executor();
+    void shutdown_executor();
+
+    void switch_scene(const char *scene_name);
+    void set_mute(const char *source_name, bool muted);
+    void set_visibility(const char *source_name, bool visible);
+    void start_recording();
+    void stop_recording();
+    void start_streaming();
+    void stop_streaming();
+
+    ExecutorStats get_executor_stats();
+}
@@ -0,0 +1,72 @@
+/*
+MeetingMind Activity Log Model
+List model over the activity log for the dock's log view. Rows are only
+formatted when the view asks for them, so the view stays cheap at tens of
+thousands of lines.
+*/
+
+#include "activity-log-model.hpp"
+
+#include <QDateTime>
+#include <algorithm>
+
+MeetingMindActivityLogModel::MeetingMindActivityLogModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    pending.reserve(MeetingMindActivityLog::RING_CAPACITY);
+}
+
+int MeetingMindActivityLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : (int)rows.size();
+}
+
+QVariant MeetingMindActivityLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= (int)rows.size()) return QVariant();
+
+    const Row &row = rows[(size_t)index.row()];
+    const QDateTime time = QDateTime::fromMSecsSinceEpoch(row.time_ms);
+    switch (role) {
+    case Qt::DisplayRole:
+        return QString("[%1] %2").arg(time.toString("hh:mm:ss"), row.text);
+    case Qt::ToolTipRole:
+        return QString("%1\n%2").arg(time.toString("yyyy-MM-dd hh:mm:ss.zzz"), row.text);
+    default:
+        return QVariant();
+    }
+}
+
+bool MeetingMindActivityLogModel::refresh()
+{
+    pending.clear();
+    const uint64_t lost = MeetingMindActivityLog::drain(pending);
+
+    std::vector<Row> incoming;
+    incoming.reserve(pending.size() + 1);
+    if (lost > 0) {
+        incoming.push_back({pending.empty() ? QDateTime::currentMSecsSinceEpoch() : pending.front().time_ms,
+                            QString("(%1 log lines dropped)").arg(lost)});
+    }
+    for (const MeetingMindActivityLog::Entry &entry : pending) {
+        incoming.push_back({entry.time_ms, QString::fromUtf8(entry.text, (int)entry.length)});
+    }
+    if (incoming.empty()) return false;
+
+    if (incoming.size() > MAX_ROWS) {
+        incoming.erase(incoming.begin(), incoming.end() - MAX_ROWS);
+    }
+
+    // Drop the oldest rows first so the view never holds more than MAX_ROWS
+    const size_t overflow = rows.size() + incoming.size() > MAX_ROWS ? rows.size() + incoming.size() - MAX_ROWS : 0;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, (int)overflow - 1);
+        rows.erase(rows.begin(), rows.begin() + (std::ptrdiff_t)overflow);
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), (int)rows.size(), (int)(rows.size() + incoming.size()) - 1);
+    for (Row &row : incoming) rows.push_back(std::move(row));
+    endInsertRows();
+    return true;
+}
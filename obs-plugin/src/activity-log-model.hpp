@@ -0,0 +1,42 @@
+/*
+MeetingMind Activity Log Model
+List model over the activity log for the dock's log view. Rows are only
+formatted when the view asks for them, so the view stays cheap at tens of
+thousands of lines.
+*/
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QString>
+#include <deque>
+#include <vector>
+
+#include "activity-log.hpp"
+
+class MeetingMindActivityLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    // Oldest rows are dropped beyond this
+    static constexpr size_t MAX_ROWS = 50000;
+
+    explicit MeetingMindActivityLogModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // Moves lines logged since the last call into the model. Returns true if
+    // any rows were added.
+    bool refresh();
+
+private:
+    struct Row {
+        qint64 time_ms;
+        QString text;
+    };
+
+    std::deque<Row> rows;
+    std::vector<MeetingMindActivityLog::Entry> pending;
+};
@@ -0,0 +1,123 @@
+/*
+MeetingMind Activity Log
+Fixed-size lock-free ring of log lines that any thread can append to; the
+dock drains it on a timer
+*/
+
+#include "activity-log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace MeetingMindActivityLog {
+
+namespace {
+
+// Each slot is a small seqlock. sequence is 2 * ticket + 1 while the line
+// for ticket is being written and 2 * ticket + 2 once it is complete, so the
+// reader can tell a finished line from one in progress or one that has
+// already been lapped.
+struct alignas(64) Slot {
+    std::atomic<uint64_t> sequence{0};
+    Entry entry;
+};
+
+Slot slots[RING_CAPACITY];
+std::atomic<uint64_t> next_ticket{0};
+
+// Consumer side only
+uint64_t read_ticket = 0;
+
+int64_t wall_clock_ms()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void append(const char *text, size_t length)
+{
+    length = std::min(length, MAX_LINE_LENGTH);
+
+    const uint64_t ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots[ticket % RING_CAPACITY];
+
+    // A writer stalled for a whole lap must not clobber the newer line in
+    // its slot, so claiming and publishing are both compare-and-swaps
+    uint64_t current = slot.sequence.load(std::memory_order_relaxed);
+    do {
+        if (current > 2 * ticket) return;
+    } while (!slot.sequence.compare_exchange_weak(current, 2 * ticket + 1, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.entry.time_ms = wall_clock_ms();
+    slot.entry.length = (uint32_t)length;
+    memcpy(slot.entry.text, text, length);
+    slot.entry.text[length] = '\0';
+
+    uint64_t writing = 2 * ticket + 1;
+    slot.sequence.compare_exchange_strong(writing, 2 * ticket + 2, std::memory_order_release,
+                                          std::memory_order_relaxed);
+}
+
+void append(const char *text)
+{
+    append(text, strlen(text));
+}
+
+void appendf(const char *format, ...)
+{
+    char line[MAX_LINE_LENGTH + 1];
+    va_list args;
+    va_start(args, format);
+    const int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length < 0) return;
+    append(line, std::min((size_t)length, MAX_LINE_LENGTH));
+}
+
+uint64_t drain(std::vector<Entry> &out)
+{
+    const uint64_t end = next_ticket.load(std::memory_order_acquire);
+    uint64_t lost = 0;
+
+    // Anything more than a ring behind has been overwritten already
+    if (end - read_ticket > RING_CAPACITY) {
+        lost += end - RING_CAPACITY - read_ticket;
+        read_ticket = end - RING_CAPACITY;
+    }
+
+    for (; read_ticket < end; read_ticket++) {
+        Slot &slot = slots[read_ticket % RING_CAPACITY];
+        const uint64_t expected = 2 * read_ticket + 2;
+
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before < expected) break; // Still being written; pick it up next time
+        if (before > expected) {
+            lost++;
+            continue;
+        }
+
+        Entry entry;
+        entry.time_ms = slot.entry.time_ms;
+        entry.length = std::min<uint32_t>(slot.entry.length, (uint32_t)MAX_LINE_LENGTH);
+        memcpy(entry.text, slot.entry.text, entry.length);
+        entry.text[entry.length] = '\0';
+
+        // A writer that lapped the reader mid-copy leaves a torn line
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+            lost++;
+            continue;
+        }
+        out.push_back(entry);
+    }
+    return lost;
+}
+
+} // namespace MeetingMindActivityLog
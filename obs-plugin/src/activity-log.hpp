@@ -0,0 +1,39 @@
+/*
+MeetingMind Activity Log
+Fixed-size lock-free ring of log lines that any thread can append to; the
+dock drains it on a timer
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MeetingMindActivityLog {
+
+// Lines waiting for the next drain. Writers never block: once the ring is
+// full, the oldest undrained lines are overwritten and counted as lost.
+static constexpr size_t RING_CAPACITY = 4096;
+
+// Longer lines are truncated
+static constexpr size_t MAX_LINE_LENGTH = 231;
+
+struct Entry {
+    int64_t time_ms = 0; // Wall-clock milliseconds since the Unix epoch
+    uint32_t length = 0;
+    char text[MAX_LINE_LENGTH + 1] = {};
+};
+
+// Thread-safe and wait-free; safe to call from OBS audio, video and network
+// threads
+void append(const char *text, size_t length);
+void append(const char *text);
+void appendf(const char *format, ...);
+
+// Single consumer. Appends every line written since the previous drain to
+// out, oldest first, and returns how many were overwritten before they
+// could be read.
+uint64_t drain(std::vector<Entry> &out);
+
+} // namespace MeetingMindActivityLog
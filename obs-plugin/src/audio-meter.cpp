@@ -0,0 +1,137 @@
+/*
+MeetingMind Audio Meter
+Vectorized level kernels for float audio blocks: sum of squares, peak and
+clipped sample count in a single pass
+*/
+
+#include "audio-meter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEETINGMIND_AUDIO_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MEETINGMIND_AUDIO_NEON 1
+#endif
+
+namespace MeetingMindAudio {
+
+namespace {
+
+void measure_scalar(const float *samples, size_t count, float clip_level, BlockStats &stats)
+{
+    for (size_t i = 0; i < count; i++) {
+        const float sample = samples[i];
+        const float magnitude = std::fabs(sample);
+        stats.sum_squares += sample * sample;
+        stats.peak = std::max(stats.peak, magnitude);
+        stats.clipped += magnitude >= clip_level ? 1 : 0;
+    }
+}
+
+} // namespace
+
+#if defined(MEETINGMIND_AUDIO_SSE2)
+
+BlockStats measure_block(const float *samples, size_t count, float clip_level)
+{
+    // Two independent accumulator sets per iteration hide the add latency
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 clip = _mm_set1_ps(clip_level);
+    __m128 squares0 = _mm_setzero_ps(), squares1 = _mm_setzero_ps();
+    __m128 peak0 = _mm_setzero_ps(), peak1 = _mm_setzero_ps();
+    __m128i clipped0 = _mm_setzero_si128(), clipped1 = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128 a = _mm_loadu_ps(samples + i);
+        const __m128 b = _mm_loadu_ps(samples + i + 4);
+        squares0 = _mm_add_ps(squares0, _mm_mul_ps(a, a));
+        squares1 = _mm_add_ps(squares1, _mm_mul_ps(b, b));
+        const __m128 abs_a = _mm_and_ps(a, abs_mask);
+        const __m128 abs_b = _mm_and_ps(b, abs_mask);
+        peak0 = _mm_max_ps(peak0, abs_a);
+        peak1 = _mm_max_ps(peak1, abs_b);
+        // Compare masks are all ones, i.e. -1, per clipped lane
+        clipped0 = _mm_sub_epi32(clipped0, _mm_castps_si128(_mm_cmpge_ps(abs_a, clip)));
+        clipped1 = _mm_sub_epi32(clipped1, _mm_castps_si128(_mm_cmpge_ps(abs_b, clip)));
+    }
+
+    alignas(16) float squares[4];
+    alignas(16) float peaks[4];
+    alignas(16) int32_t clipped[4];
+    _mm_store_ps(squares, _mm_add_ps(squares0, squares1));
+    _mm_store_ps(peaks, _mm_max_ps(peak0, peak1));
+    _mm_store_si128((__m128i *)clipped, _mm_add_epi32(clipped0, clipped1));
+
+    BlockStats stats;
+    stats.sum_squares = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+    stats.peak = std::max(std::max(peaks[0], peaks[1]), std::max(peaks[2], peaks[3]));
+    stats.clipped = (uint32_t)(clipped[0] + clipped[1] + clipped[2] + clipped[3]);
+    measure_scalar(samples + i, count - i, clip_level, stats);
+    return stats;
+}
+
+#elif defined(MEETINGMIND_AUDIO_NEON)
+
+BlockStats measure_block(const float *samples, size_t count, float clip_level)
+{
+    const float32x4_t clip = vdupq_n_f32(clip_level);
+    float32x4_t squares0 = vdupq_n_f32(0.0f), squares1 = vdupq_n_f32(0.0f);
+    float32x4_t peak0 = vdupq_n_f32(0.0f), peak1 = vdupq_n_f32(0.0f);
+    uint32x4_t clipped0 = vdupq_n_u32(0), clipped1 = vdupq_n_u32(0);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float32x4_t a = vld1q_f32(samples + i);
+        const float32x4_t b = vld1q_f32(samples + i + 4);
+        squares0 = vmlaq_f32(squares0, a, a);
+        squares1 = vmlaq_f32(squares1, b, b);
+        const float32x4_t abs_a = vabsq_f32(a);
+        const float32x4_t abs_b = vabsq_f32(b);
+        peak0 = vmaxq_f32(peak0, abs_a);
+        peak1 = vmaxq_f32(peak1, abs_b);
+        clipped0 = vsubq_u32(clipped0, vcgeq_f32(abs_a, clip));
+        clipped1 = vsubq_u32(clipped1, vcgeq_f32(abs_b, clip));
+    }
+
+    BlockStats stats;
+    stats.sum_squares = vaddvq_f32(vaddq_f32(squares0, squares1));
+    stats.peak = vmaxvq_f32(vmaxq_f32(peak0, peak1));
+    stats.clipped = vaddvq_u32(vaddq_u32(clipped0, clipped1));
+    measure_scalar(samples + i, count - i, clip_level, stats);
+    return stats;
+}
+
+#else
+
+BlockStats measure_block(const float *samples, size_t count, float clip_level)
+{
+    BlockStats stats;
+    measure_scalar(samples, count, clip_level, stats);
+    return stats;
+}
+
+#endif
+
+float amplitude_to_db(float amplitude)
+{
+    if (amplitude <= 0.0f) return SILENCE_DB;
+    return std::max(SILENCE_DB, 20.0f * std::log10(amplitude));
+}
+
+const char *kernel_name()
+{
+#if defined(MEETINGMIND_AUDIO_SSE2)
+    return "sse2";
+#elif defined(MEETINGMIND_AUDIO_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace MeetingMindAudio
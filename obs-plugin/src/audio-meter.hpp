@@ -0,0 +1,35 @@
+/*
+MeetingMind Audio Meter
+Vectorized level kernels for float audio blocks: sum of squares, peak and
+clipped sample count in a single pass
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MeetingMindAudio {
+
+// Samples at or above this magnitude count as clipped (-0.01 dBFS)
+static constexpr float CLIP_LEVEL = 0.999f;
+
+// Reported for silence instead of -infinity
+static constexpr float SILENCE_DB = -100.0f;
+
+struct BlockStats {
+    float sum_squares = 0.0f;
+    float peak = 0.0f;
+    uint32_t clipped = 0;
+};
+
+// One pass over count samples. Uses SSE2 or NEON where available.
+BlockStats measure_block(const float *samples, size_t count, float clip_level = CLIP_LEVEL);
+
+// Amplitude to dBFS, floored at SILENCE_DB
+float amplitude_to_db(float amplitude);
+
+// "sse2", "neon" or "scalar"
+const char *kernel_name();
+
+} // namespace MeetingMindAudio
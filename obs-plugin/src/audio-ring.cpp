@@ -0,0 +1,159 @@
+/*
+MeetingMind Audio Ring
+Lock-free single-producer/single-consumer ring of planar float audio with
+bulk reads and writes and capture timestamps
+*/
+
+#include "audio-ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MeetingMindAudio {
+
+namespace {
+
+size_t round_up_pow2(size_t value)
+{
+    size_t capacity = 1;
+    while (capacity < value) capacity <<= 1;
+    return capacity;
+}
+
+} // namespace
+
+AudioRing::AudioRing(size_t min_frames, size_t planes, uint32_t sample_rate)
+    : capacity_(round_up_pow2(std::max<size_t>(min_frames, 2))),
+      mask_(capacity_ - 1),
+      planes_(std::min(std::max<size_t>(planes, 1), MAX_PLANES)),
+      sample_rate_(sample_rate),
+      samples_(capacity_ * planes_)
+{
+}
+
+void AudioRing::copy_in(const float *const *planes, uint64_t position, size_t frames)
+{
+    // At most two runs: up to the end of the storage, then from its start
+    const size_t offset = (size_t)(position & mask_);
+    const size_t first = std::min(frames, capacity_ - offset);
+    for (size_t p = 0; p < planes_; p++) {
+        float *plane = samples_.data() + p * capacity_;
+        memcpy(plane + offset, planes[p], first * sizeof(float));
+        memcpy(plane, planes[p] + first, (frames - first) * sizeof(float));
+    }
+}
+
+void AudioRing::copy_out(float *const *planes, uint64_t position, size_t frames) const
+{
+    const size_t offset = (size_t)(position & mask_);
+    const size_t first = std::min(frames, capacity_ - offset);
+    for (size_t p = 0; p < planes_; p++) {
+        const float *plane = samples_.data() + p * capacity_;
+        memcpy(planes[p], plane + offset, first * sizeof(float));
+        memcpy(planes[p] + first, plane, (frames - first) * sizeof(float));
+    }
+}
+
+size_t AudioRing::write(const float *const *planes, size_t frames, uint64_t timestamp)
+{
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (capacity_ - (tail - cached_head_) < frames) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    const size_t count = std::min<size_t>(frames, capacity_ - (size_t)(tail - cached_head_));
+    if (count < frames) {
+        overruns_.fetch_add(frames - count, std::memory_order_relaxed);
+    }
+    if (count == 0) return 0;
+
+    copy_in(planes, tail, count);
+
+    // The mark goes out before the frames it describes. With the mark ring
+    // full the write goes unmarked and its time is extrapolated from the
+    // previous mark, which is exact for continuous audio.
+    const uint64_t mark_tail = mark_tail_.load(std::memory_order_relaxed);
+    if (mark_tail - cached_mark_head_ == MARK_CAPACITY) {
+        cached_mark_head_ = mark_head_.load(std::memory_order_acquire);
+    }
+    if (mark_tail - cached_mark_head_ < MARK_CAPACITY) {
+        marks_[mark_tail & (MARK_CAPACITY - 1)] = {tail, timestamp};
+        mark_tail_.store(mark_tail + 1, std::memory_order_release);
+    }
+
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+uint64_t AudioRing::timestamp_at(uint64_t position)
+{
+    // Take every mark at or before position; the last one taken dates it
+    uint64_t mark_head = mark_head_.load(std::memory_order_relaxed);
+    const uint64_t mark_tail = mark_tail_.load(std::memory_order_acquire);
+    while (mark_head != mark_tail) {
+        const Mark &mark = marks_[mark_head & (MARK_CAPACITY - 1)];
+        if (mark.frame > position) break;
+        current_mark_ = mark;
+        has_mark_ = true;
+        mark_head++;
+    }
+    mark_head_.store(mark_head, std::memory_order_release);
+
+    if (!has_mark_ || !sample_rate_) return 0;
+    return current_mark_.timestamp + (position - current_mark_.frame) * 1000000000ull / sample_rate_;
+}
+
+size_t AudioRing::read(float *const *planes, size_t frames, uint64_t *timestamp)
+{
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ - head < frames) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    const size_t count = std::min<size_t>(frames, (size_t)(cached_tail_ - head));
+    if (count < frames) {
+        underruns_.fetch_add(frames - count, std::memory_order_relaxed);
+    }
+    if (count == 0) {
+        if (timestamp) *timestamp = 0;
+        return 0;
+    }
+
+    // Retires marks even when the caller does not want the time, so that
+    // the producer keeps finding room for new ones
+    const uint64_t first_timestamp = timestamp_at(head);
+    if (timestamp) *timestamp = first_timestamp;
+
+    copy_out(planes, head, count);
+    head_.store(head + count, std::memory_order_release);
+    return count;
+}
+
+size_t AudioRing::skip(size_t frames)
+{
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    const size_t count = std::min<size_t>(frames, (size_t)(cached_tail_ - head));
+    timestamp_at(head + count);
+    head_.store(head + count, std::memory_order_release);
+    return count;
+}
+
+size_t AudioRing::available() const
+{
+    return (size_t)(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+}
+
+void AudioRing::reset()
+{
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    mark_head_.store(0, std::memory_order_relaxed);
+    mark_tail_.store(0, std::memory_order_relaxed);
+    overruns_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    cached_head_ = 0;
+    cached_tail_ = 0;
+    cached_mark_head_ = 0;
+    has_mark_ = false;
+}
+
+} // namespace MeetingMindAudio
@@ -0,0 +1,104 @@
+/*
+MeetingMind Audio Ring
+Lock-free single-producer/single-consumer ring of planar float audio with
+bulk reads and writes and capture timestamps
+*/
+
+#pragma once
+
+#include "spsc-queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MeetingMindAudio {
+
+// Moves audio from the thread that delivers it, typically an OBS audio
+// callback, to one consumer without either side blocking. The producer
+// drops what does not fit and the consumer gets what is there; both count
+// the shortfall. Every write is tagged with the timestamp of its first
+// frame, so a read can report when its first frame was captured.
+//
+// Like SpscQueue, the indices sit on their own cache lines and each side
+// keeps a private copy of the other's index, touching the shared one only
+// when that copy says the ring is full or empty.
+class AudioRing {
+public:
+    static constexpr size_t MAX_PLANES = 8;
+
+    // Holds at least min_frames frames of planes channels; the capacity is
+    // rounded up to a power of two. sample_rate is used to derive the
+    // timestamps of frames inside a write.
+    AudioRing(size_t min_frames, size_t planes, uint32_t sample_rate);
+
+    AudioRing(const AudioRing &) = delete;
+    AudioRing &operator=(const AudioRing &) = delete;
+
+    // Producer side. Copies up to frames frames, one pointer per plane,
+    // timestamp being the first frame's (audio_data::timestamp). Returns the
+    // frames written.
+    size_t write(const float *const *planes, size_t frames, uint64_t timestamp);
+
+    // Consumer side. Copies up to frames frames. If timestamp is not null it
+    // receives the first frame's capture time, or 0 if nothing has been
+    // read yet. Returns the frames read.
+    size_t read(float *const *planes, size_t frames, uint64_t *timestamp = nullptr);
+
+    // Consumer side. Discards up to frames frames; returns how many.
+    size_t skip(size_t frames);
+
+    // Approximate when called concurrently with either side
+    size_t available() const;
+
+    size_t capacity() const { return capacity_; }
+    size_t planes() const { return planes_; }
+
+    // Frames the producer could not fit, and frames the consumer asked for
+    // that were not there
+    uint64_t overrun_frames() const { return overruns_.load(std::memory_order_relaxed); }
+    uint64_t underrun_frames() const { return underruns_.load(std::memory_order_relaxed); }
+
+    // Empties the ring and clears the counters. Neither side may be running.
+    void reset();
+
+private:
+    static constexpr size_t MARK_CAPACITY = 64;
+
+    // Capture timestamp of the frame at position frame
+    struct Mark {
+        uint64_t frame = 0;
+        uint64_t timestamp = 0;
+    };
+
+    void copy_in(const float *const *planes, uint64_t position, size_t frames);
+    void copy_out(float *const *planes, uint64_t position, size_t frames) const;
+    uint64_t timestamp_at(uint64_t position);
+
+    const size_t capacity_;
+    const size_t mask_;
+    const size_t planes_;
+    const uint32_t sample_rate_;
+    std::vector<float> samples_; // Plane p at p * capacity_
+
+    // Consumer side. Frame positions only grow, so they never wrap in
+    // practice.
+    alignas(MEETINGMIND_CACHE_LINE) std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> mark_head_{0};
+    std::atomic<uint64_t> underruns_{0};
+    uint64_t cached_tail_ = 0;
+    Mark current_mark_;
+    bool has_mark_ = false;
+
+    // Producer side
+    alignas(MEETINGMIND_CACHE_LINE) std::atomic<uint64_t> tail_{0};
+    std::atomic<uint64_t> mark_tail_{0};
+    std::atomic<uint64_t> overruns_{0};
+    uint64_t cached_head_ = 0;
+    uint64_t cached_mark_head_ = 0;
+
+    alignas(MEETINGMIND_CACHE_LINE) Mark marks_[MARK_CAPACITY];
+};
+
+} // namespace MeetingMindAudio
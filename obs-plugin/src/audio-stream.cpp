@@ -0,0 +1,322 @@
+/*
+MeetingMind Audio Stream
+Captures one OBS source, converts it to 16 kHz mono, encodes it with OBS's
+Opus encoder and hands out framed packets for the backend
+*/
+
+#include "audio-stream.hpp"
+
+#include "audio-ring.hpp"
+#include "resampler.hpp"
+
+#include <obs-module.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MeetingMindStream {
+
+namespace {
+
+const char *OUTPUT_ID = "meetingmind_audio_stream";
+const char *ENCODER_ID = "ffmpeg_opus";
+
+// Converted audio waits in a ring between the source's thread and the
+// stream's audio output thread, which pulls AUDIO_OUTPUT_FRAMES at a time
+const size_t BUFFER_SAMPLES = SAMPLE_RATE / 2;
+
+struct Stream {
+    std::string source_name;
+    obs_weak_source_t *weak = nullptr;
+    std::unique_ptr<MeetingMindAudio::Resampler> resampler;
+    audio_t *audio = nullptr;
+    obs_encoder_t *encoder = nullptr;
+    obs_output_t *output = nullptr;
+
+    PacketCallback callback = nullptr;
+    void *param = nullptr;
+    int64_t start_wall_ms = 0;
+
+    // Source audio thread only
+    size_t channels = 0;
+    uint32_t input_rate = 0;
+    uint64_t resampler_latency_ns = 0;
+    std::vector<float> converted;
+
+    // Encoder thread only
+    uint32_t sequence = 0;
+    std::vector<uint8_t> frame;
+};
+
+Stream stream;
+std::atomic<bool> active{false};
+
+MeetingMindAudio::AudioRing ring(BUFFER_SAMPLES, CHANNELS, SAMPLE_RATE);
+
+std::atomic<uint64_t> packet_count{0};
+std::atomic<uint64_t> byte_count{0};
+std::atomic<uint64_t> input_count{0};
+
+void store_u32(uint8_t *out, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+void store_u64(uint8_t *out, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+void push_samples(const float *samples, size_t count, uint64_t timestamp)
+{
+    input_count.fetch_add(ring.write(&samples, count, timestamp), std::memory_order_relaxed);
+}
+
+// Source's audio thread: downmix and resample to 16 kHz mono
+void on_source_audio(void *, obs_source_t *, const struct audio_data *audio, bool muted)
+{
+    MeetingMindAudio::Resampler *resampler = stream.resampler.get();
+    if (!resampler || !audio->frames) return;
+
+    // A muted source is silent on program, so it is silent here too; it
+    // still goes through the filter to keep the stream's timing
+    static const float silence[MeetingMindAudio::Resampler::MAX_BLOCK_FRAMES] = {};
+    for (uint32_t done = 0; done < audio->frames;) {
+        const uint32_t count =
+            std::min<uint32_t>(audio->frames - done, (uint32_t)MeetingMindAudio::Resampler::MAX_BLOCK_FRAMES);
+        const float *planes[MAX_AV_PLANES];
+        for (size_t c = 0; c < stream.channels; c++) {
+            planes[c] = muted ? silence : (const float *)audio->data[c] + done;
+        }
+        const size_t converted = resampler->process(planes, count, stream.converted.data());
+        const uint64_t timestamp =
+            audio->timestamp + done * 1000000000ull / stream.input_rate - stream.resampler_latency_ns;
+        push_samples(stream.converted.data(), converted, timestamp);
+        done += count;
+    }
+}
+
+// Stream audio output thread: supplies the encoder's next block
+bool on_stream_input(void *, uint64_t start_ts, uint64_t, uint64_t *new_ts, uint32_t,
+                     struct audio_output_data *mixes)
+{
+    float *out = mixes[0].data[0];
+    const size_t copied = ring.read(&out, AUDIO_OUTPUT_FRAMES);
+    std::fill(out + copied, out + AUDIO_OUTPUT_FRAMES, 0.0f);
+
+    *new_ts = start_ts;
+    return true;
+}
+
+// Private output: gets the encoder started and forwards its packets
+
+const char *output_get_name(void *)
+{
+    return "MeetingMind Audio Stream";
+}
+
+void *output_create(obs_data_t *, obs_output_t *output)
+{
+    return output;
+}
+
+void output_destroy(void *) {}
+
+bool output_start(void *data)
+{
+    obs_output_t *output = (obs_output_t *)data;
+    if (!obs_output_can_begin_data_capture(output, 0)) return false;
+    if (!obs_output_initialize_encoders(output, 0)) return false;
+    return obs_output_begin_data_capture(output, 0);
+}
+
+void output_stop(void *data, uint64_t)
+{
+    obs_output_end_data_capture((obs_output_t *)data);
+}
+
+// Encoder thread
+void output_encoded_packet(void *, struct encoder_packet *packet)
+{
+    if (!packet || !packet->size || !stream.callback) return;
+
+    const int64_t pts = packet->timebase_den
+                            ? packet->pts * (int64_t)SAMPLE_RATE * packet->timebase_num / packet->timebase_den
+                            : packet->pts;
+    const int64_t wall_ms = stream.start_wall_ms + pts * 1000 / (int64_t)SAMPLE_RATE;
+
+    stream.frame.resize(FRAME_HEADER_SIZE + packet->size);
+    write_frame_header(stream.frame.data(), stream.sequence++, (uint64_t)pts, (uint64_t)wall_ms);
+    memcpy(stream.frame.data() + FRAME_HEADER_SIZE, packet->data, packet->size);
+
+    stream.callback(stream.param, stream.frame.data(), stream.frame.size());
+    packet_count.fetch_add(1, std::memory_order_relaxed);
+    byte_count.fetch_add(stream.frame.size(), std::memory_order_relaxed);
+}
+
+void release_stream()
+{
+    if (stream.weak) {
+        obs_source_t *source = obs_weak_source_get_source(stream.weak);
+        if (source) {
+            obs_source_remove_audio_capture_callback(source, on_source_audio, nullptr);
+            obs_source_release(source);
+        }
+        obs_weak_source_release(stream.weak);
+        stream.weak = nullptr;
+    }
+    if (stream.output) {
+        obs_output_stop(stream.output);
+        obs_output_release(stream.output);
+        stream.output = nullptr;
+    }
+    if (stream.encoder) {
+        obs_encoder_release(stream.encoder);
+        stream.encoder = nullptr;
+    }
+    if (stream.audio) {
+        audio_output_close(stream.audio);
+        stream.audio = nullptr;
+    }
+    stream.resampler.reset();
+    stream.callback = nullptr;
+    stream.param = nullptr;
+}
+
+} // namespace
+
+void register_stream_output()
+{
+    struct obs_output_info info = {};
+    info.id = OUTPUT_ID;
+    info.flags = OBS_OUTPUT_AUDIO | OBS_OUTPUT_ENCODED;
+    info.get_name = output_get_name;
+    info.create = output_create;
+    info.destroy = output_destroy;
+    info.start = output_start;
+    info.stop = output_stop;
+    info.encoded_packet = output_encoded_packet;
+    info.encoded_audio_codecs = "opus";
+    obs_register_output(&info);
+}
+
+bool start_stream(const char *source_name, int bitrate_kbps, PacketCallback callback, void *param)
+{
+    stop_stream();
+
+    obs_source_t *source = obs_get_source_by_name(source_name);
+    if (!source) {
+        blog(LOG_WARNING, "MeetingMind: Cannot stream audio, no source named '%s'", source_name);
+        return false;
+    }
+
+    // Sources hand capture callbacks program audio, which libobs keeps as
+    // float planar
+    audio_t *program = obs_get_audio();
+    stream.input_rate = audio_output_get_sample_rate(program);
+    stream.channels = std::min<size_t>(audio_output_get_channels(program), MeetingMindAudio::Resampler::MAX_CHANNELS);
+    stream.resampler =
+        std::make_unique<MeetingMindAudio::Resampler>(stream.input_rate, SAMPLE_RATE, stream.channels);
+    stream.resampler_latency_ns = stream.resampler->latency_ns();
+    stream.converted.resize(stream.resampler->max_output(MeetingMindAudio::Resampler::MAX_BLOCK_FRAMES));
+
+    // Both ends of the ring are idle until the audio output opens
+    ring.reset();
+
+    struct audio_output_info info = {};
+    info.name = "MeetingMind Stream Audio";
+    info.samples_per_sec = SAMPLE_RATE;
+    info.format = AUDIO_FORMAT_FLOAT_PLANAR;
+    info.speakers = SPEAKERS_MONO;
+    info.input_callback = on_stream_input;
+    info.input_param = nullptr;
+    if (audio_output_open(&stream.audio, &info) != AUDIO_OUTPUT_SUCCESS) {
+        blog(LOG_WARNING, "MeetingMind: Cannot set up 16 kHz audio for streaming");
+        stream.audio = nullptr;
+        obs_source_release(source);
+        release_stream();
+        return false;
+    }
+
+    obs_data_t *settings = obs_data_create();
+    obs_data_set_int(settings, "bitrate", bitrate_kbps);
+    stream.encoder = obs_audio_encoder_create(ENCODER_ID, "MeetingMind Opus", settings, 0, nullptr);
+    obs_data_release(settings);
+    stream.output = obs_output_create(OUTPUT_ID, "MeetingMind Audio Stream", nullptr, nullptr);
+    if (!stream.encoder || !stream.output) {
+        blog(LOG_WARNING, "MeetingMind: Cannot stream audio, the %s encoder is not available", ENCODER_ID);
+        obs_source_release(source);
+        release_stream();
+        return false;
+    }
+    obs_encoder_set_audio(stream.encoder, stream.audio);
+    obs_output_set_audio_encoder(stream.output, stream.encoder, 0);
+
+    packet_count.store(0, std::memory_order_relaxed);
+    byte_count.store(0, std::memory_order_relaxed);
+    input_count.store(0, std::memory_order_relaxed);
+
+    stream.source_name = source_name;
+    stream.callback = callback;
+    stream.param = param;
+    stream.sequence = 0;
+    stream.start_wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+
+    stream.weak = obs_source_get_weak_source(source);
+    obs_source_add_audio_capture_callback(source, on_source_audio, nullptr);
+    obs_source_release(source);
+
+    if (!obs_output_start(stream.output)) {
+        blog(LOG_WARNING, "MeetingMind: Audio stream output failed to start");
+        release_stream();
+        return false;
+    }
+
+    active.store(true, std::memory_order_release);
+    blog(LOG_INFO, "MeetingMind: Streaming '%s' as %u Hz mono Opus at %d kbps (%s resampler)", source_name,
+         SAMPLE_RATE, bitrate_kbps, MeetingMindAudio::Resampler::kernel_name(stream.resampler->kernel()));
+    return true;
+}
+
+void stop_stream()
+{
+    if (!active.exchange(false, std::memory_order_acq_rel) && !stream.output && !stream.resampler) return;
+
+    release_stream();
+    blog(LOG_INFO, "MeetingMind: Audio stream of '%s' stopped after %llu packets, %llu bytes",
+         stream.source_name.c_str(), (unsigned long long)packet_count.load(std::memory_order_relaxed),
+         (unsigned long long)byte_count.load(std::memory_order_relaxed));
+}
+
+bool stream_active()
+{
+    return active.load(std::memory_order_acquire);
+}
+
+StreamStats get_stream_stats()
+{
+    StreamStats stats;
+    stats.packets = packet_count.load(std::memory_order_relaxed);
+    stats.bytes = byte_count.load(std::memory_order_relaxed);
+    stats.input_samples = input_count.load(std::memory_order_relaxed);
+    stats.dropped_samples = ring.overrun_frames();
+    stats.padded_samples = ring.underrun_frames();
+    return stats;
+}
+
+void write_frame_header(uint8_t *out, uint32_t sequence, uint64_t pts, uint64_t wall_ms)
+{
+    memcpy(out, FRAME_MAGIC, sizeof(FRAME_MAGIC));
+    store_u32(out + 4, sequence);
+    store_u64(out + 8, pts);
+    store_u64(out + 16, wall_ms);
+}
+
+} // namespace MeetingMindStream
@@ -0,0 +1,54 @@
+/*
+MeetingMind Audio Stream
+Captures one OBS source, converts it to 16 kHz mono, encodes it with OBS's
+Opus encoder and hands out framed packets for the backend
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MeetingMindStream {
+
+static constexpr uint32_t SAMPLE_RATE = 16000;
+static constexpr uint32_t CHANNELS = 1;
+
+// Binary frame: a 24-byte little-endian header followed by one Opus packet
+//   0  "MMAU"
+//   4  u32 sequence, from 0 for each stream
+//   8  i64 pts, in samples at SAMPLE_RATE since the stream started; the
+//      first packets are negative, covering the encoder's lookahead
+//   16 u64 wall-clock milliseconds since the Unix epoch of the first sample
+static constexpr char FRAME_MAGIC[4] = {'M', 'M', 'A', 'U'};
+static constexpr size_t FRAME_HEADER_SIZE = 24;
+
+struct StreamStats {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;           // Including headers
+    uint64_t input_samples = 0;   // At SAMPLE_RATE, after conversion
+    uint64_t dropped_samples = 0; // Captured while the buffer was full
+    uint64_t padded_samples = 0;  // Silence sent because no audio was buffered
+};
+
+// Runs on the encoder's thread for every packet. frame holds the header and
+// payload and is only valid during the call.
+typedef void (*PacketCallback)(void *param, const uint8_t *frame, size_t size);
+
+// Registers the private output that receives the encoder's packets. Call
+// once from obs_module_load.
+void register_stream_output();
+
+// Starts streaming source_name. Fails if the source does not exist or the
+// Opus encoder is not available. A running stream is stopped first.
+bool start_stream(const char *source_name, int bitrate_kbps, PacketCallback callback, void *param);
+void stop_stream();
+bool stream_active();
+
+StreamStats get_stream_stats();
+
+// Writes the frame header for one packet into out, which must have room
+// for FRAME_HEADER_SIZE bytes
+void write_frame_header(uint8_t *out, uint32_t sequence, uint64_t pts, uint64_t wall_ms);
+
+} // namespace MeetingMindStream
@@ -0,0 +1,345 @@
+/*
+MeetingMind Audio Taps
+Audio capture callbacks on the meeting's audio sources that meter each
+channel and detect voice activity as the audio arrives, publishing levels
+once per window
+*/
+
+#include "audio-tap.hpp"
+
+#include "audio-meter.hpp"
+#include "voice-activity.hpp"
+
+#include <obs.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <string>
+
+namespace MeetingMindAudio {
+
+namespace {
+
+struct Tap {
+    std::string name;
+    obs_weak_source_t *weak = nullptr; // Guarded by taps_mutex
+    uint32_t generation = 0;           // Only set while detached
+
+    // Audio thread only
+    double sum_squares[MAX_CHANNELS] = {};
+    float peak[MAX_CHANNELS] = {};
+    uint32_t clipped[MAX_CHANNELS] = {};
+    uint32_t frames = 0;
+    uint64_t windows = 0;
+    VoiceDetector voice;
+    float last_sample[MAX_CHANNELS] = {};
+    std::atomic<bool> speaking{false};
+
+    // Seqlock around published: odd while the audio thread is writing
+    std::atomic<uint64_t> sequence{0};
+    SourceLevels published;
+
+    void reset_window()
+    {
+        std::fill(std::begin(sum_squares), std::end(sum_squares), 0.0);
+        std::fill(std::begin(peak), std::end(peak), 0.0f);
+        std::fill(std::begin(clipped), std::end(clipped), 0u);
+        frames = 0;
+    }
+};
+
+Tap taps[MAX_TAPS];
+size_t active_taps = 0;
+uint32_t taps_generation = 0;
+uint32_t window_ms = 100;
+std::mutex taps_mutex;
+bool signals_connected = false;
+
+VoiceCallback voice_callback = nullptr;
+void *voice_param = nullptr;
+
+std::atomic<uint64_t> block_count{0};
+std::atomic<uint64_t> busy_total_ns{0};
+uint64_t started_ns = 0;
+
+void publish(Tap &tap, size_t channels, bool muted, uint64_t timestamp)
+{
+    const uint64_t sequence = tap.sequence.load(std::memory_order_relaxed);
+    tap.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    SourceLevels &levels = tap.published;
+    levels.muted = muted;
+    levels.channels = (uint32_t)channels;
+    for (size_t ch = 0; ch < channels; ch++) {
+        const float rms = tap.frames ? (float)std::sqrt(tap.sum_squares[ch] / tap.frames) : 0.0f;
+        levels.channel[ch].rms_db = amplitude_to_db(rms);
+        levels.channel[ch].peak_db = amplitude_to_db(tap.peak[ch]);
+        levels.channel[ch].clipped = tap.clipped[ch];
+    }
+    levels.timestamp = timestamp;
+    levels.window = ++tap.windows;
+
+    tap.sequence.store(sequence + 2, std::memory_order_release);
+    tap.reset_window();
+}
+
+// Runs on whichever thread delivers the source's audio, which for capture
+// devices is the device's own thread; a tap is only ever fed from one.
+// Capture callbacks see the source's planar float audio after its filters.
+void on_audio(void *param, obs_source_t *, const struct audio_data *audio, bool muted)
+{
+    const uint64_t start = os_gettime_ns();
+    Tap &tap = *(Tap *)param;
+
+    const audio_t *output = obs_get_audio();
+    const size_t channels = std::min(audio_output_get_channels(output), MAX_CHANNELS);
+    const uint32_t sample_rate = audio_output_get_sample_rate(output);
+
+    float block_squares = 0.0f;
+    float block_differences = 0.0f;
+    size_t measured = 0;
+    for (size_t ch = 0; ch < channels; ch++) {
+        if (!audio->data[ch] || !audio->frames) continue;
+        const float *samples = (const float *)audio->data[ch];
+        const BlockStats block = measure_block(samples, audio->frames);
+        tap.sum_squares[ch] += block.sum_squares;
+        tap.peak[ch] = std::max(tap.peak[ch], block.peak);
+        tap.clipped[ch] += block.clipped;
+
+        block_squares += block.sum_squares;
+        block_differences += sum_squared_differences(samples, audio->frames, tap.last_sample[ch]);
+        tap.last_sample[ch] = samples[audio->frames - 1];
+        measured++;
+    }
+    tap.frames += audio->frames;
+
+    if (measured && sample_rate) {
+        const float samples = (float)(measured * audio->frames);
+        const float duration_ms = 1000.0f * audio->frames / sample_rate;
+        if (tap.voice.process(block_squares / samples, block_differences / samples, duration_ms, muted)) {
+            const bool active = tap.voice.active();
+            tap.speaking.store(active, std::memory_order_relaxed);
+            if (voice_callback) {
+                voice_callback(voice_param, (size_t)(&tap - taps), tap.generation, active, audio->timestamp);
+            }
+        }
+    }
+
+    if ((uint64_t)tap.frames * 1000 >= (uint64_t)sample_rate * window_ms) {
+        publish(tap, channels, muted, audio->timestamp);
+    }
+
+    block_count.fetch_add(1, std::memory_order_relaxed);
+    busy_total_ns.fetch_add(os_gettime_ns() - start, std::memory_order_relaxed);
+}
+
+// Caller holds taps_mutex
+int find_tap(const char *name)
+{
+    if (!name) return -1;
+    for (size_t i = 0; i < active_taps; i++) {
+        if (taps[i].name == name) return (int)i;
+    }
+    return -1;
+}
+
+// Caller holds taps_mutex
+int find_attached(obs_source_t *source)
+{
+    for (size_t i = 0; i < active_taps; i++) {
+        if (taps[i].weak && obs_weak_source_references_source(taps[i].weak, source)) return (int)i;
+    }
+    return -1;
+}
+
+// Caller holds taps_mutex
+void attach(Tap &tap, obs_source_t *source)
+{
+    if (tap.weak) return;
+    tap.reset_window();
+    tap.voice.reset();
+    std::fill(std::begin(tap.last_sample), std::end(tap.last_sample), 0.0f);
+    tap.weak = obs_source_get_weak_source(source);
+    obs_source_add_audio_capture_callback(source, on_audio, &tap);
+}
+
+// Caller holds taps_mutex. Once the callback is removed OBS no longer runs
+// it, so the window can be reset from here.
+void detach(Tap &tap, obs_source_t *source)
+{
+    obs_source_remove_audio_capture_callback(source, on_audio, &tap);
+    obs_weak_source_release(tap.weak);
+    tap.weak = nullptr;
+    tap.reset_window();
+
+    // A source that disappears mid-sentence has stopped speaking
+    if (tap.speaking.exchange(false, std::memory_order_relaxed) && voice_callback) {
+        voice_callback(voice_param, (size_t)(&tap - taps), tap.generation, false, os_gettime_ns());
+    }
+}
+
+void on_source_create(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    const int id = find_tap(obs_source_get_name(source));
+    if (id >= 0) attach(taps[id], source);
+}
+
+void on_source_destroy(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    const int id = find_attached(source);
+    if (id >= 0) detach(taps[id], source);
+}
+
+void on_source_rename(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    const int previous = find_attached(source);
+    if (previous >= 0) detach(taps[previous], source);
+
+    const int id = find_tap(calldata_string(cd, "new_name"));
+    if (id >= 0) attach(taps[id], source);
+}
+
+} // namespace
+
+void set_voice_callback(VoiceCallback callback, void *param)
+{
+    voice_callback = callback;
+    voice_param = param;
+}
+
+void init_taps(const char *const *names, size_t count, uint32_t window)
+{
+    shutdown_taps();
+
+    {
+        std::lock_guard<std::mutex> lock(taps_mutex);
+        active_taps = std::min(count, MAX_TAPS);
+        window_ms = window;
+        taps_generation++;
+        for (size_t i = 0; i < active_taps; i++) {
+            taps[i].name = names[i];
+            taps[i].generation = taps_generation;
+            taps[i].windows = 0;
+            taps[i].published = SourceLevels();
+        }
+        started_ns = os_gettime_ns();
+        block_count.store(0, std::memory_order_relaxed);
+        busy_total_ns.store(0, std::memory_order_relaxed);
+    }
+
+    signal_handler_t *handler = obs_get_signal_handler();
+    signal_handler_connect(handler, "source_create", on_source_create, nullptr);
+    signal_handler_connect(handler, "source_destroy", on_source_destroy, nullptr);
+    signal_handler_connect(handler, "source_remove", on_source_destroy, nullptr);
+    signal_handler_connect(handler, "source_rename", on_source_rename, nullptr);
+    signals_connected = true;
+
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    for (size_t i = 0; i < active_taps; i++) {
+        obs_source_t *source = obs_get_source_by_name(taps[i].name.c_str());
+        if (source) {
+            attach(taps[i], source);
+            obs_source_release(source);
+        }
+    }
+}
+
+void shutdown_taps()
+{
+    if (signals_connected) {
+        signal_handler_t *handler = obs_get_signal_handler();
+        signal_handler_disconnect(handler, "source_create", on_source_create, nullptr);
+        signal_handler_disconnect(handler, "source_destroy", on_source_destroy, nullptr);
+        signal_handler_disconnect(handler, "source_remove", on_source_destroy, nullptr);
+        signal_handler_disconnect(handler, "source_rename", on_source_rename, nullptr);
+        signals_connected = false;
+    }
+
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    for (size_t i = 0; i < active_taps; i++) {
+        Tap &tap = taps[i];
+        if (!tap.weak) continue;
+        obs_source_t *source = obs_weak_source_get_source(tap.weak);
+        if (source) {
+            detach(tap, source);
+            obs_source_release(source);
+        } else {
+            obs_weak_source_release(tap.weak);
+            tap.weak = nullptr;
+        }
+    }
+    active_taps = 0;
+}
+
+size_t tap_count()
+{
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    return active_taps;
+}
+
+uint32_t tap_generation()
+{
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    return taps_generation;
+}
+
+std::string tap_name(size_t index)
+{
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    return index < active_taps ? taps[index].name : std::string();
+}
+
+bool tap_attached(size_t index)
+{
+    std::lock_guard<std::mutex> lock(taps_mutex);
+    return index < active_taps && taps[index].weak != nullptr;
+}
+
+bool read_levels(size_t index, SourceLevels &levels)
+{
+    if (index >= MAX_TAPS) return false;
+    const Tap &tap = taps[index];
+
+    // A window is published every ~100 ms, so a retry is rare and a second
+    // one rarer still
+    for (int attempt = 0; attempt < 4; attempt++) {
+        const uint64_t before = tap.sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        levels = tap.published;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (tap.sequence.load(std::memory_order_relaxed) == before) return levels.window > 0;
+    }
+    return false;
+}
+
+bool voice_active(size_t index)
+{
+    return index < MAX_TAPS && taps[index].speaking.load(std::memory_order_relaxed);
+}
+
+TapStats get_tap_stats()
+{
+    TapStats stats;
+    stats.blocks = block_count.load(std::memory_order_relaxed);
+    stats.busy_ns = busy_total_ns.load(std::memory_order_relaxed);
+    stats.elapsed_ns = started_ns ? os_gettime_ns() - started_ns : 0;
+    return stats;
+}
+
+} // namespace MeetingMindAudio
@@ -0,0 +1,71 @@
+/*
+MeetingMind Audio Taps
+Audio capture callbacks on the meeting's audio sources that meter each
+channel and detect voice activity as the audio arrives, publishing levels
+once per window
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MeetingMindAudio {
+
+static constexpr size_t MAX_CHANNELS = 8;
+static constexpr size_t MAX_TAPS = 8;
+
+struct ChannelLevels {
+    float rms_db = 0.0f;
+    float peak_db = 0.0f;
+    uint32_t clipped = 0;
+};
+
+// Levels over one completed window
+struct SourceLevels {
+    bool muted = false;
+    uint32_t channels = 0;
+    ChannelLevels channel[MAX_CHANNELS];
+    uint64_t timestamp = 0; // OBS audio timestamp of the window's last block
+    uint64_t window = 0;    // Counts completed windows, starting at 1
+};
+
+struct TapStats {
+    uint64_t blocks = 0;
+    uint64_t busy_ns = 0;    // Time spent in the capture callbacks
+    uint64_t elapsed_ns = 0; // Since init_taps
+};
+
+// Runs on the thread delivering the tapped source's audio, in the block
+// that changed the tap's voice activity. timestamp is that block's OBS
+// audio timestamp. generation is the tap_generation() the tap belongs to, so
+// that a change handled later can be told apart from the current taps.
+typedef void (*VoiceCallback)(void *param, size_t tap, uint32_t generation, bool active, uint64_t timestamp);
+
+// Set before init_taps; nullptr to stop notifications
+void set_voice_callback(VoiceCallback callback, void *param);
+
+// Taps the named sources, now and whenever a source with one of the names
+// appears later. Levels are published every window_ms of audio.
+void init_taps(const char *const *names, size_t count, uint32_t window_ms);
+void shutdown_taps();
+
+size_t tap_count();
+// Changes with every init_taps, which may give the indices to other sources
+uint32_t tap_generation();
+// A copy, as init_taps may replace the name at any time; empty past the
+// last tap
+std::string tap_name(size_t index);
+bool tap_attached(size_t index);
+
+// Latest completed window of a tap; false if it has none yet. Safe from any
+// thread; never blocks the audio thread.
+bool read_levels(size_t index, SourceLevels &levels);
+
+// Whether the tap's source is currently speaking
+bool voice_active(size_t index);
+
+TapStats get_tap_stats();
+
+} // namespace MeetingMindAudio
@@ -0,0 +1,175 @@
+/*
+MeetingMind Auto-Director
+Picks the camera shot for whoever is speaking from per-source voice
+activity, with hold times, hysteresis and cooldowns so the program does not
+flick between speakers
+*/
+
+#include "auto-director.hpp"
+
+#include <algorithm>
+
+namespace MeetingMindDirector {
+
+namespace {
+
+const uint64_t NS_PER_MS = 1000000;
+
+std::string trim(const std::string &text)
+{
+    const size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return std::string();
+    const size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+// One "Audio Source=Scene>Item" entry; false if it is malformed
+bool parse_shot(const std::string &entry, Shot &shot)
+{
+    const size_t equals = entry.find('=');
+    if (equals == std::string::npos) return false;
+    shot.audio_source = trim(entry.substr(0, equals));
+
+    const std::string target = entry.substr(equals + 1);
+    const size_t arrow = target.find('>');
+    shot.scene = trim(target.substr(0, arrow));
+    shot.item = arrow == std::string::npos ? std::string() : trim(target.substr(arrow + 1));
+    return !shot.audio_source.empty() && !shot.scene.empty() && (arrow == std::string::npos || !shot.item.empty());
+}
+
+} // namespace
+
+size_t parse_camera_map(const std::string &text, CameraMap &map)
+{
+    map = CameraMap();
+    size_t skipped = 0;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find_first_of(";\n", begin);
+        if (end == std::string::npos) end = text.size();
+        const std::string entry = trim(text.substr(begin, end - begin));
+        begin = end + 1;
+        if (entry.empty()) continue;
+
+        Shot shot;
+        if (!parse_shot(entry, shot)) {
+            skipped++;
+        } else if (shot.audio_source == "*") {
+            map.has_wide = true;
+            map.wide = shot;
+            map.wide.audio_source.clear();
+        } else if (map.cameras.size() == Director::MAX_CAMERAS ||
+                   std::any_of(map.cameras.begin(), map.cameras.end(),
+                               [&](const Shot &other) { return other.audio_source == shot.audio_source; })) {
+            skipped++;
+        } else {
+            map.cameras.push_back(shot);
+        }
+    }
+    return skipped;
+}
+
+Director::Director(const DirectorParams &params) : params_(params) {}
+
+void Director::set_params(const DirectorParams &params)
+{
+    params_ = params;
+}
+
+void Director::configure(size_t cameras, bool has_wide)
+{
+    cameras_ = std::min(cameras, MAX_CAMERAS);
+    has_wide_ = has_wide;
+    reset();
+}
+
+void Director::reset()
+{
+    for (Camera &camera : camera_) camera = Camera();
+    talking_ = 0;
+    quiet_since_ns_ = 0;
+    crosstalk_since_ns_ = 0;
+    shot_ = NO_SHOT;
+    cut_ns_ = 0;
+    std::fill(std::begin(left_ns_), std::end(left_ns_), 0);
+    cuts_ = 0;
+}
+
+void Director::voice(size_t camera, bool active, uint64_t now_ns)
+{
+    if (camera >= cameras_ || camera_[camera].active == active) return;
+
+    camera_[camera].active = active;
+    if (active) {
+        camera_[camera].since_ns = now_ns;
+        if (++talking_ == 2) crosstalk_since_ns_ = now_ns;
+    } else if (--talking_ == 0) {
+        quiet_since_ns_ = now_ns;
+    }
+}
+
+// Keeps whichever candidate is ready first once the hold and the shot's
+// cooldown are taken into account
+void Director::consider(Candidate &best, int shot, uint64_t ready_ns) const
+{
+    if (shot_ != NO_SHOT) ready_ns = std::max(ready_ns, cut_ns_ + params_.min_hold_ms * NS_PER_MS);
+    const uint64_t left_ns = left_ns_[shot_index(shot)];
+    if (left_ns) ready_ns = std::max(ready_ns, left_ns + params_.cooldown_ms * NS_PER_MS);
+
+    if (best.shot == NO_SHOT || ready_ns < best.ready_ns) {
+        best.shot = shot;
+        best.ready_ns = ready_ns;
+    }
+}
+
+Decision Director::decide(uint64_t now_ns)
+{
+    // The earliest cut the rules allow, whether or not it is due yet
+    auto next_cut = [this]() {
+        Candidate best;
+        const bool crosstalk = talking_ >= 2;
+        if (crosstalk && has_wide_ && shot_ != WIDE_SHOT) {
+            consider(best, WIDE_SHOT, crosstalk_since_ns_ + params_.crosstalk_ms * NS_PER_MS);
+        }
+
+        // The wide shot holds for as long as the crosstalk lasts
+        if (!(crosstalk && shot_ == WIDE_SHOT)) {
+            const Camera *speaker = shot_ >= 0 && camera_[shot_].active ? &camera_[shot_] : nullptr;
+            for (size_t i = 0; i < cameras_; i++) {
+                const Camera &camera = camera_[i];
+                if (!camera.active || (int)i == shot_) continue;
+                // Over a speaker who is still talking, the overlap has to
+                // last; after them, a short confirmation keeps coughs and
+                // "mm-hm"s off the program
+                const uint64_t ready_ns =
+                    speaker ? std::max(camera.since_ns, speaker->since_ns) + params_.takeover_ms * NS_PER_MS
+                            : camera.since_ns + params_.confirm_ms * NS_PER_MS;
+                consider(best, (int)i, ready_ns);
+            }
+        }
+
+        // Until the first cut the program is the operator's, silent or not
+        if (!talking_ && has_wide_ && shot_ >= 0) {
+            consider(best, WIDE_SHOT, quiet_since_ns_ + params_.idle_ms * NS_PER_MS);
+        }
+        return best;
+    };
+
+    Decision decision;
+    Candidate candidate = next_cut();
+    if (candidate.shot != NO_SHOT && candidate.ready_ns <= now_ns) {
+        if (shot_ != NO_SHOT) left_ns_[shot_index(shot_)] = now_ns;
+        shot_ = candidate.shot;
+        cut_ns_ = now_ns;
+        cuts_++;
+        decision.cut = true;
+        decision.due_ns = candidate.ready_ns;
+        candidate = next_cut();
+    }
+
+    decision.shot = shot_;
+    if (candidate.shot != NO_SHOT) decision.next_ns = std::max(candidate.ready_ns, now_ns);
+    return decision;
+}
+
+} // namespace MeetingMindDirector
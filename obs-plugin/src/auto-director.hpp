@@ -0,0 +1,120 @@
+/*
+MeetingMind Auto-Director
+Picks the camera shot for whoever is speaking from per-source voice
+activity, with hold times, hysteresis and cooldowns so the program does not
+flick between speakers
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MeetingMindDirector {
+
+struct DirectorParams {
+    uint32_t confirm_ms = 400;    // A new voice must keep talking this long to get the camera
+    uint32_t takeover_ms = 2500;  // Talking over the speaker on camera for this long takes the camera
+    uint32_t min_hold_ms = 3000;  // Every shot stays on program at least this long
+    uint32_t cooldown_ms = 6000;  // A shot just left is not cut back to for this long
+    uint32_t crosstalk_ms = 2000; // Two or more talking together this long goes to the wide shot
+    uint32_t idle_ms = 10000;     // Nobody talking this long goes to the wide shot
+};
+
+// Shots other than a camera index
+static constexpr int NO_SHOT = -1;   // The director has not cut yet
+static constexpr int WIDE_SHOT = -2; // Everyone in view
+
+struct Decision {
+    int shot = NO_SHOT;   // On program after this decision
+    bool cut = false;     // shot changed in this decision
+    uint64_t due_ns = 0;  // When the cut became due; the time it took to act on it is now - due_ns
+    uint64_t next_ns = 0; // Decide again by then unless a voice changes first; 0 when nothing is pending
+};
+
+// One camera shot: the audio source carrying its speaker, the scene to cut
+// to, and optionally a source in that scene to show while hiding the other
+// mapped sources of the same scene
+struct Shot {
+    std::string audio_source;
+    std::string scene;
+    std::string item;
+};
+
+struct CameraMap {
+    std::vector<Shot> cameras;
+    bool has_wide = false;
+    Shot wide;
+};
+
+// Parses "Audio Source=Scene" or "Audio Source=Scene>Item" entries
+// separated by ';' or newlines. "*" in place of the audio source names the
+// wide shot. Returns the number of entries that could not be parsed, which
+// are skipped.
+size_t parse_camera_map(const std::string &text, CameraMap &map);
+
+// Runs the cutting rules. voice() records each change of a camera's voice
+// activity and decide() says which shot belongs on program now; both are
+// cheap enough to call from the UI thread on every change. Nothing happens
+// between calls, so the caller decides again at next_ns for cuts that only
+// become due with time.
+//
+// A speaker gets the camera after confirm_ms of talking, once the speaker on
+// camera has stopped; talking over them takes takeover_ms. Cuts never come
+// sooner than min_hold_ms after the last one, nor back to a shot within
+// cooldown_ms of leaving it. With a wide shot, crosstalk and long silences
+// go wide.
+class Director {
+public:
+    static constexpr size_t MAX_CAMERAS = 8;
+
+    explicit Director(const DirectorParams &params = DirectorParams());
+
+    void set_params(const DirectorParams &params);
+    const DirectorParams &params() const { return params_; }
+
+    // Cameras beyond MAX_CAMERAS are ignored. Starts over with no shot.
+    void configure(size_t cameras, bool has_wide);
+
+    void voice(size_t camera, bool active, uint64_t now_ns);
+    Decision decide(uint64_t now_ns);
+
+    int current() const { return shot_; }
+    size_t cuts() const { return cuts_; }
+
+    void reset();
+
+private:
+    struct Camera {
+        bool active = false;
+        uint64_t since_ns = 0; // Start of the current talk
+    };
+
+    struct Candidate {
+        int shot = NO_SHOT;
+        uint64_t ready_ns = 0;
+    };
+
+    static constexpr size_t WIDE_INDEX = MAX_CAMERAS;
+
+    size_t shot_index(int shot) const { return shot == WIDE_SHOT ? WIDE_INDEX : (size_t)shot; }
+    void consider(Candidate &best, int shot, uint64_t ready_ns) const;
+
+    DirectorParams params_;
+    size_t cameras_ = 0;
+    bool has_wide_ = false;
+
+    Camera camera_[MAX_CAMERAS];
+    size_t talking_ = 0;
+    uint64_t quiet_since_ns_ = 0;     // Last time everyone stopped
+    uint64_t crosstalk_since_ns_ = 0; // Last time a second voice joined
+
+    int shot_ = NO_SHOT;
+    uint64_t cut_ns_ = 0;
+    uint64_t left_ns_[MAX_CAMERAS + 1] = {}; // When each shot last went off program; 0 if never on
+    size_t cuts_ = 0;
+};
+
+} // namespace MeetingMindDirector
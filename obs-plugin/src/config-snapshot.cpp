@@ -0,0 +1,93 @@
+/*
+MeetingMind Config Snapshots
+Immutable copies of the settings, published by the UI thread and read from
+any thread without locks
+*/
+
+#include "config-snapshot.hpp"
+
+namespace MeetingMindConfig {
+
+namespace {
+
+SnapshotPtr make_defaults()
+{
+    meetingmind_config defaults = {};
+    apply_default_config(&defaults);
+
+    auto snapshot = std::make_shared<ConfigSnapshot>();
+    snapshot->server_url = defaults.server_url;
+    snapshot->server_port = defaults.server_port;
+    snapshot->api_key = defaults.api_key;
+    snapshot->meeting_id = defaults.meeting_id;
+    snapshot->auto_scene_switching = defaults.auto_scene_switching;
+    snapshot->auto_recording = defaults.auto_recording;
+    snapshot->recording_markers = defaults.recording_markers;
+    snapshot->auto_start_streaming = defaults.auto_start_streaming;
+    snapshot->auto_stop_streaming = defaults.auto_stop_streaming;
+    snapshot->audio_management = defaults.audio_management;
+    snapshot->meeting_notifications = defaults.meeting_notifications;
+    snapshot->voice_switching = defaults.voice_switching;
+    snapshot->director_map = defaults.director_map;
+    snapshot->audio_streaming = defaults.audio_streaming;
+    snapshot->audio_stream_source = defaults.audio_stream_source;
+    snapshot->slide_detection = defaults.slide_detection;
+    snapshot->slide_source = defaults.slide_source;
+    snapshot->connection_timeout = defaults.connection_timeout;
+    snapshot->binary_protocol = defaults.binary_protocol;
+    snapshot->record_trace = defaults.record_trace;
+    snapshot->coalesce_window_ms = defaults.coalesce_window_ms;
+    free_config_strings(&defaults);
+    return snapshot;
+}
+
+// Only touched through std::atomic_load/std::atomic_store
+SnapshotPtr current = make_defaults();
+std::atomic<uint64_t> version{0};
+
+} // namespace
+
+void publish_snapshot(const meetingmind_config *config)
+{
+    auto snapshot = std::make_shared<ConfigSnapshot>();
+    snapshot->version = version.load(std::memory_order_relaxed) + 1;
+    snapshot->server_url = config->server_url ? config->server_url : "";
+    snapshot->server_port = config->server_port;
+    snapshot->api_key = config->api_key ? config->api_key : "";
+    snapshot->meeting_id = config->meeting_id ? config->meeting_id : "";
+    snapshot->auto_scene_switching = config->auto_scene_switching;
+    snapshot->auto_recording = config->auto_recording;
+    snapshot->recording_markers = config->recording_markers;
+    snapshot->auto_start_streaming = config->auto_start_streaming;
+    snapshot->auto_stop_streaming = config->auto_stop_streaming;
+    snapshot->audio_management = config->audio_management;
+    snapshot->meeting_notifications = config->meeting_notifications;
+    snapshot->voice_switching = config->voice_switching;
+    snapshot->director_map = config->director_map ? config->director_map : "";
+    snapshot->audio_streaming = config->audio_streaming;
+    snapshot->audio_stream_source = config->audio_stream_source ? config->audio_stream_source : "";
+    snapshot->slide_detection = config->slide_detection;
+    snapshot->slide_source = config->slide_source ? config->slide_source : "";
+    snapshot->connection_timeout = config->connection_timeout;
+    snapshot->binary_protocol = config->binary_protocol;
+    snapshot->record_trace = config->record_trace;
+    snapshot->coalesce_window_ms = config->coalesce_window_ms;
+
+    // The pointer goes first so that a reader who sees the new version also
+    // finds the new snapshot. The old one is freed by whichever thread
+    // drops the last reference to it.
+    std::atomic_store_explicit(&current, SnapshotPtr(std::move(snapshot)), std::memory_order_release);
+    version.fetch_add(1, std::memory_order_release);
+}
+
+SnapshotPtr current_snapshot()
+{
+    return std::atomic_load_explicit(&current, std::memory_order_acquire);
+}
+
+uint64_t snapshot_version()
+{
+    return version.load(std::memory_order_acquire);
+}
+
+} // namespace MeetingMindConfig
@@ -0,0 +1,76 @@
+/*
+MeetingMind Config Snapshots
+Immutable copies of the settings, published by the UI thread and read from
+any thread without locks
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "plugin-config.hpp"
+
+namespace MeetingMindConfig {
+
+// Never modified after publication. Owns its strings, so it stays valid for
+// as long as a reader holds it, whatever the UI does to plugin_config.
+struct ConfigSnapshot {
+    uint64_t version = 0;
+
+    std::string server_url;
+    int server_port = 0;
+    std::string api_key;
+    std::string meeting_id;
+    bool auto_scene_switching = false;
+    bool auto_recording = false;
+    bool recording_markers = false;
+    bool auto_start_streaming = false;
+    bool auto_stop_streaming = false;
+    bool audio_management = false;
+    bool meeting_notifications = false;
+    bool voice_switching = false;
+    std::string director_map;
+    bool audio_streaming = false;
+    std::string audio_stream_source;
+    bool slide_detection = false;
+    std::string slide_source;
+    int connection_timeout = 0;
+    bool binary_protocol = false;
+    bool record_trace = false;
+    int coalesce_window_ms = 0;
+};
+
+using SnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
+
+// Builds a snapshot of config and swaps it in. Readers see the old snapshot
+// or the new one, never a mix. Called from the UI thread.
+void publish_snapshot(const meetingmind_config *config);
+
+// The latest snapshot; before the first publish, the defaults
+SnapshotPtr current_snapshot();
+
+// Bumped after every publish
+uint64_t snapshot_version();
+
+// Per-thread cache of the current snapshot. get() costs one atomic load
+// while the settings are unchanged, and only touches the shared pointer
+// after a publish. The reference stays valid until the next get() on the
+// same reader, so give each thread its own.
+class SnapshotReader {
+public:
+    const ConfigSnapshot &get()
+    {
+        if (!cached || snapshot_version() != cached->version) {
+            cached = current_snapshot();
+        }
+        return *cached;
+    }
+
+private:
+    SnapshotPtr cached;
+};
+
+} // namespace MeetingMindConfig
@@ -0,0 +1,154 @@
+/*
+MeetingMind Config Writer
+Saves settings on a background thread once edits have gone quiet, writing
+only the fields that changed
+*/
+
+#include "config-writer.hpp"
+
+#include <obs-module.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace MeetingMindConfig {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::mutex writer_mutex;
+std::condition_variable writer_cv;
+std::thread writer_thread;
+bool running = false;
+
+// Guarded by writer_mutex
+meetingmind_config pending = {};
+meetingmind_config saved = {};
+bool has_pending = false;
+bool flush_requested = false;
+uint64_t flushes_completed = 0;
+Clock::time_point deadline;
+std::chrono::milliseconds quiet_period(500);
+WriterStats stats;
+
+// Called with the lock held. The file is written unlocked so that the UI
+// thread never waits on disk.
+void write_pending(std::unique_lock<std::mutex> &lock)
+{
+    meetingmind_config snapshot = {};
+    copy_config(&snapshot, &pending);
+    has_pending = false;
+
+    const uint32_t dirty = diff_config(&snapshot, &saved);
+    if (!dirty) {
+        stats.unchanged++;
+    } else if (!validate_config(&snapshot)) {
+        stats.invalid++;
+    } else {
+        lock.unlock();
+        const bool written = save_config_fields(&snapshot, dirty);
+        lock.lock();
+
+        if (written) {
+            copy_config(&saved, &snapshot);
+            stats.written++;
+        } else {
+            stats.failed++;
+            blog(LOG_WARNING, "MeetingMind: Could not save settings");
+        }
+    }
+    free_config_strings(&snapshot);
+}
+
+void writer_loop()
+{
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    while (running || has_pending) {
+        if (!has_pending) {
+            if (flush_requested) {
+                flush_requested = false;
+                flushes_completed++;
+                writer_cv.notify_all();
+            }
+            writer_cv.wait(lock, [] { return has_pending || flush_requested || !running; });
+            continue;
+        }
+
+        // Each new change pushes the deadline back
+        if (running && !flush_requested && Clock::now() < deadline) {
+            writer_cv.wait_until(lock, deadline);
+            continue;
+        }
+        write_pending(lock);
+    }
+
+    if (flush_requested) {
+        flush_requested = false;
+        flushes_completed++;
+        writer_cv.notify_all();
+    }
+}
+
+} // namespace
+
+void start_config_writer(const meetingmind_config *baseline, int quiet_ms)
+{
+    stop_config_writer();
+
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    copy_config(&saved, baseline);
+    quiet_period = std::chrono::milliseconds(quiet_ms);
+    stats = WriterStats();
+    running = true;
+    writer_thread = std::thread(writer_loop);
+}
+
+void stop_config_writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        if (!running) return;
+        running = false;
+    }
+    writer_cv.notify_all();
+    writer_thread.join();
+
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    free_config_strings(&pending);
+    free_config_strings(&saved);
+}
+
+void save_config_async(const meetingmind_config *config)
+{
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        if (!running) return;
+        copy_config(&pending, config);
+        has_pending = true;
+        deadline = Clock::now() + quiet_period;
+        stats.requested++;
+    }
+    writer_cv.notify_all();
+}
+
+void flush_config_writer()
+{
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    if (!running) return;
+
+    const uint64_t target = flushes_completed + 1;
+    flush_requested = true;
+    writer_cv.notify_all();
+    writer_cv.wait(lock, [target] { return flushes_completed >= target || !running; });
+}
+
+WriterStats get_config_writer_stats()
+{
+    std::lock_guard<std::mutex> lock(writer_mutex);
+    return stats;
+}
+
+} // namespace MeetingMindConfig
@@ -0,0 +1,39 @@
+/*
+MeetingMind Config Writer
+Saves settings on a background thread once edits have gone quiet, writing
+only the fields that changed
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "plugin-config.hpp"
+
+namespace MeetingMindConfig {
+
+struct WriterStats {
+    uint64_t requested = 0; // save_config_async calls
+    uint64_t written = 0;   // Files actually saved
+    uint64_t unchanged = 0; // Quiet periods that ended with nothing to save
+    uint64_t invalid = 0;   // Settings that failed validation and were kept off disk
+    uint64_t failed = 0;    // I/O errors
+};
+
+// saved is the configuration as it is on disk, the baseline for deciding
+// which fields are dirty
+void start_config_writer(const meetingmind_config *saved, int quiet_ms);
+
+// Writes anything still pending and stops the thread
+void stop_config_writer();
+
+// Copies config and saves it once quiet_ms pass without another call. Cheap
+// enough to call on every keystroke.
+void save_config_async(const meetingmind_config *config);
+
+// Saves anything pending now, and waits for it
+void flush_config_writer();
+
+WriterStats get_config_writer_stats();
+
+} // namespace MeetingMindConfig
@@ -0,0 +1,790 @@
+/*
+MeetingMind Event Parser
+Allocation-free JSON and MessagePack object parser for inbound event frames
+*/
+
+#include "event-parser.hpp"
+
+#include <charconv>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEETINGMIND_PARSER_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MEETINGMIND_PARSER_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace MeetingMindJson {
+
+namespace {
+
+inline int count_trailing_zeros(uint64_t bits)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// Bit i becomes the XOR of input bits 0..i; applied to the quote mask this
+// marks string interiors, opening quote included
+inline uint64_t prefix_xor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t ops;
+    uint64_t control;
+};
+
+// OR-ing 0x20 folds '[' onto '{' and ']' onto '}', so four compares find all
+// six structural operators. The only other bytes that fold onto the set are
+// 0x0c and 0x1a, which are invalid outside strings and rejected in stage 2.
+// Control bytes below 0x20 are marked so that stage 2 can reject them in
+// strings, where JSON requires them to be escaped.
+#if defined(MEETINGMIND_PARSER_SSE2)
+
+inline BlockMasks classify_block(const uint8_t *p)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i fold = _mm_set1_epi8(0x20);
+    const __m128i open = _mm_set1_epi8('{');
+    const __m128i close = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i last_control = _mm_set1_epi8(0x1f);
+
+    BlockMasks masks = {0, 0, 0, 0};
+    for (int k = 0; k < 4; k++) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * k));
+        const __m128i folded = _mm_or_si128(v, fold);
+        const __m128i ops = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+            _mm_or_si128(_mm_cmpeq_epi8(folded, colon), _mm_cmpeq_epi8(folded, comma)));
+
+        masks.quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)) << (16 * k);
+        masks.backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)) << (16 * k);
+        masks.ops |= (uint64_t)(uint16_t)_mm_movemask_epi8(ops) << (16 * k);
+        masks.control |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, last_control), v))
+                         << (16 * k);
+    }
+    return masks;
+}
+
+const char *const SCANNER_NAME = "sse2";
+
+#elif defined(MEETINGMIND_PARSER_NEON)
+
+inline uint16_t movemask(uint8x16_t v)
+{
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t bits = vandq_u8(v, vld1q_u8(weights));
+    return (uint16_t)(vaddv_u8(vget_low_u8(bits)) | (vaddv_u8(vget_high_u8(bits)) << 8));
+}
+
+inline BlockMasks classify_block(const uint8_t *p)
+{
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t fold = vdupq_n_u8(0x20);
+    const uint8x16_t open = vdupq_n_u8('{');
+    const uint8x16_t close = vdupq_n_u8('}');
+    const uint8x16_t colon = vdupq_n_u8(':');
+    const uint8x16_t comma = vdupq_n_u8(',');
+    const uint8x16_t space = vdupq_n_u8(0x20);
+
+    BlockMasks masks = {0, 0, 0, 0};
+    for (int k = 0; k < 4; k++) {
+        const uint8x16_t v = vld1q_u8(p + 16 * k);
+        const uint8x16_t folded = vorrq_u8(v, fold);
+        const uint8x16_t ops = vorrq_u8(vorrq_u8(vceqq_u8(folded, open), vceqq_u8(folded, close)),
+                                        vorrq_u8(vceqq_u8(folded, colon), vceqq_u8(folded, comma)));
+
+        masks.quote |= (uint64_t)movemask(vceqq_u8(v, quote)) << (16 * k);
+        masks.backslash |= (uint64_t)movemask(vceqq_u8(v, backslash)) << (16 * k);
+        masks.ops |= (uint64_t)movemask(ops) << (16 * k);
+        masks.control |= (uint64_t)movemask(vcltq_u8(v, space)) << (16 * k);
+    }
+    return masks;
+}
+
+const char *const SCANNER_NAME = "neon";
+
+#else
+
+inline BlockMasks classify_block(const uint8_t *p)
+{
+    BlockMasks masks = {0, 0, 0, 0};
+    for (int i = 0; i < 64; i++) {
+        const uint8_t folded = p[i] | 0x20;
+        const uint64_t bit = 1ull << i;
+        if (p[i] == '"') masks.quote |= bit;
+        if (p[i] == '\\') masks.backslash |= bit;
+        if (folded == '{' || folded == '}' || folded == ':' || folded == ',') masks.ops |= bit;
+        if (p[i] < 0x20) masks.control |= bit;
+    }
+    return masks;
+}
+
+const char *const SCANNER_NAME = "scalar";
+
+#endif
+
+inline bool is_blank(const char *p, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        if (p[i] != ' ' && p[i] != '\t' && p[i] != '\n' && p[i] != '\r') return false;
+    }
+    return true;
+}
+
+inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool is_number(std::string_view s)
+{
+    size_t i = 0;
+    auto digits = [&]() -> bool {
+        const size_t first = i;
+        while (i < s.size() && is_digit(s[i])) i++;
+        return i > first;
+    };
+
+    if (i < s.size() && s[i] == '-') i++;
+    if (i < s.size() && s[i] == '0') {
+        i++;
+    } else if (!digits()) {
+        return false;
+    }
+    if (i < s.size() && s[i] == '.') {
+        i++;
+        if (!digits()) return false;
+    }
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        i++;
+        if (i < s.size() && (s[i] == '+' || s[i] == '-')) i++;
+        if (!digits()) return false;
+    }
+    return i == s.size();
+}
+
+int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool read_hex4(std::string_view s, size_t pos, uint32_t &out)
+{
+    if (pos + 4 > s.size()) return false;
+    out = 0;
+    for (size_t i = pos; i < pos + 4; i++) {
+        const int v = hex_value(s[i]);
+        if (v < 0) return false;
+        out = (out << 4) | (uint32_t)v;
+    }
+    return true;
+}
+
+// The escape whose backslash is at pos, per the JSON string grammar
+bool is_valid_escape(std::string_view s, size_t pos)
+{
+    if (pos + 1 >= s.size()) return false;
+    switch (s[pos + 1]) {
+    case '"':
+    case '\\':
+    case '/':
+    case 'b':
+    case 'f':
+    case 'n':
+    case 'r':
+    case 't':
+        return true;
+    case 'u': {
+        uint32_t cp;
+        return read_hex4(s, pos + 2, cp);
+    }
+    default:
+        return false;
+    }
+}
+
+uint64_t read_big_endian(const uint8_t *p, size_t bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) value = (value << 8) | p[i];
+    return value;
+}
+
+// Header and payload size of one MessagePack value, plus the number of
+// nested values that follow it for arrays and maps
+struct MsgpackItem {
+    ValueKind kind;
+    size_t header;
+    uint64_t payload;
+    uint64_t children;
+};
+
+bool read_msgpack_item(const uint8_t *p, size_t len, size_t pos, MsgpackItem &item)
+{
+    if (pos >= len) return false;
+    const uint8_t tag = p[pos];
+    item = {ValueKind::Number, 1, 0, 0};
+
+    if (tag <= 0x7f || tag >= 0xe0) return true;
+    if ((tag & 0xf0) == 0x80) {
+        item.kind = ValueKind::Object;
+        item.children = 2u * (tag & 0x0f);
+    } else if ((tag & 0xf0) == 0x90) {
+        item.kind = ValueKind::Array;
+        item.children = tag & 0x0f;
+    } else if ((tag & 0xe0) == 0xa0) {
+        item.kind = ValueKind::String;
+        item.payload = tag & 0x1f;
+    } else {
+        size_t length_bytes = 0;
+        switch (tag) {
+        case 0xc0: item.kind = ValueKind::Null; break;
+        case 0xc2: item.kind = ValueKind::False; break;
+        case 0xc3: item.kind = ValueKind::True; break;
+        case 0xcc: case 0xd0: item.payload = 1; break;
+        case 0xcd: case 0xd1: item.payload = 2; break;
+        case 0xca: case 0xce: case 0xd2: item.payload = 4; break;
+        case 0xcb: case 0xcf: case 0xd3: item.payload = 8; break;
+        case 0xc4: case 0xd9: item.kind = ValueKind::String; length_bytes = 1; break;
+        case 0xc5: case 0xda: item.kind = ValueKind::String; length_bytes = 2; break;
+        case 0xc6: case 0xdb: item.kind = ValueKind::String; length_bytes = 4; break;
+        case 0xdc: item.kind = ValueKind::Array; length_bytes = 2; break;
+        case 0xdd: item.kind = ValueKind::Array; length_bytes = 4; break;
+        case 0xde: item.kind = ValueKind::Object; length_bytes = 2; break;
+        case 0xdf: item.kind = ValueKind::Object; length_bytes = 4; break;
+        default: return false;
+        }
+        if (length_bytes) {
+            if (len - pos - 1 < length_bytes) return false;
+            const uint64_t length = read_big_endian(p + pos + 1, length_bytes);
+            item.header += length_bytes;
+            if (item.kind == ValueKind::String) {
+                item.payload = length;
+            } else {
+                item.children = item.kind == ValueKind::Object ? 2 * length : length;
+            }
+        }
+    }
+
+    return item.payload <= len - pos - item.header;
+}
+
+// Advances pos past one complete value without recursion: every container
+// just adds its children to the number of values still to skip
+bool skip_msgpack_value(const uint8_t *p, size_t len, size_t &pos)
+{
+    uint64_t remaining = 1;
+    while (remaining) {
+        MsgpackItem item;
+        if (!read_msgpack_item(p, len, pos, item)) return false;
+        pos += item.header + item.payload;
+        remaining += item.children - 1;
+        // Each outstanding value needs at least one more byte
+        if (remaining > len - pos) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool ObjectView::parse(std::string_view json)
+{
+    base = json.data();
+    format = Encoding::Json;
+    count = 0;
+    if (json.size() > UINT32_MAX) return false;
+
+    const char *p = json.data();
+    const size_t len = json.size();
+
+    // Stage 2 state. Only depth-1 members are recorded; deeper levels are
+    // checked for balance and bracket matching.
+    size_t depth = 0;
+    uint64_t array_levels = 0;
+    bool in_string = false;
+    bool done = false;
+    size_t end_pos = 0;
+    size_t string_begin = 0;
+
+    bool expect_key = false;
+    bool have_key = false;
+    bool have_colon = false;
+    int value_tokens = 0;
+    size_t delimiter_end = 0;
+    size_t key_begin = 0;
+    size_t key_end = 0;
+    size_t value_begin = 0;
+    size_t total_members = 0;
+
+    auto finish_member = [&](size_t pos) -> bool {
+        if (!have_key && !have_colon) {
+            // Only valid for the empty object
+            return total_members == 0 && p[pos] == '}' && is_blank(p, delimiter_end, pos);
+        }
+        if (!have_colon) return false;
+
+        size_t vb = value_begin;
+        size_t ve = pos;
+        while (vb < ve && is_blank(p, vb, vb + 1)) vb++;
+        while (ve > vb && is_blank(p, ve - 1, ve)) ve--;
+        if (vb == ve) return false;
+
+        const std::string_view value(p + vb, ve - vb);
+        ValueKind value_kind;
+        switch (value.front()) {
+        case '"':
+            value_kind = ValueKind::String;
+            if (value_tokens != 1 || value.size() < 2 || value.back() != '"') return false;
+            break;
+        case '{':
+            value_kind = ValueKind::Object;
+            if (value_tokens != 1 || value.back() != '}') return false;
+            break;
+        case '[':
+            value_kind = ValueKind::Array;
+            if (value_tokens != 1 || value.back() != ']') return false;
+            break;
+        case 't':
+            value_kind = ValueKind::True;
+            if (value_tokens != 0 || value != "true") return false;
+            break;
+        case 'f':
+            value_kind = ValueKind::False;
+            if (value_tokens != 0 || value != "false") return false;
+            break;
+        case 'n':
+            value_kind = ValueKind::Null;
+            if (value_tokens != 0 || value != "null") return false;
+            break;
+        default:
+            value_kind = ValueKind::Number;
+            if (value_tokens != 0 || !is_number(value)) return false;
+            break;
+        }
+
+        if (count < MAX_MEMBERS) {
+            members[count++] = {(uint32_t)key_begin, (uint32_t)key_end, (uint32_t)vb, (uint32_t)ve, value_kind};
+        }
+        total_members++;
+        have_key = false;
+        have_colon = false;
+        value_tokens = 0;
+        return true;
+    };
+
+    auto handle_structural = [&](size_t i) -> bool {
+        const char c = p[i];
+
+        // Most structurals belong to nested values and only need tracking
+        if (depth > 1 && (c == '"' || c == ':' || c == ',')) {
+            in_string = c == '"' ? !in_string : in_string;
+            return true;
+        }
+
+        switch (c) {
+        case '"':
+            if (!in_string) {
+                in_string = true;
+                string_begin = i;
+                if (depth == 0) return false;
+                if (depth == 1) {
+                    if (expect_key) {
+                        if (!is_blank(p, delimiter_end, i)) return false;
+                    } else if (have_colon) {
+                        if (value_tokens++ > 0 || !is_blank(p, value_begin, i)) return false;
+                    } else {
+                        return false;
+                    }
+                }
+            } else {
+                in_string = false;
+                if (depth == 1 && expect_key) {
+                    key_begin = string_begin + 1;
+                    key_end = i;
+                    expect_key = false;
+                    have_key = true;
+                    delimiter_end = i + 1;
+                }
+            }
+            return true;
+
+        case '{':
+        case '[':
+            if (depth == 0) {
+                if (done || c != '{' || !is_blank(p, 0, i)) return false;
+                depth = 1;
+                expect_key = true;
+                delimiter_end = i + 1;
+                return true;
+            }
+            if (depth == 1) {
+                if (!have_colon || value_tokens++ > 0 || !is_blank(p, value_begin, i)) return false;
+            }
+            if (depth >= MAX_DEPTH - 1) return false;
+            if (c == '[') {
+                array_levels |= 1ull << depth;
+            } else {
+                array_levels &= ~(1ull << depth);
+            }
+            depth++;
+            return true;
+
+        case '}':
+        case ']':
+            if (depth == 0) return false;
+            if (depth == 1) {
+                if (c != '}' || !finish_member(i)) return false;
+                depth = 0;
+                done = true;
+                end_pos = i + 1;
+                return true;
+            }
+            if ((c == ']') != ((array_levels >> (depth - 1)) & 1)) return false;
+            depth--;
+            return true;
+
+        case ':':
+            if (depth == 0) return false;
+            if (depth == 1) {
+                if (!have_key || have_colon || !is_blank(p, delimiter_end, i)) return false;
+                have_colon = true;
+                value_begin = i + 1;
+                value_tokens = 0;
+            }
+            return true;
+
+        case ',':
+            if (depth == 0) return false;
+            if (depth == 1) {
+                if (!finish_member(i)) return false;
+                expect_key = true;
+                delimiter_end = i + 1;
+            }
+            return true;
+
+        default:
+            return false;
+        }
+    };
+
+    // Stage 1: classify 64-byte blocks and walk the structural bits
+    uint64_t prev_escaped = 0;
+    uint64_t prev_in_string = 0;
+    for (size_t block = 0; block < len; block += 64) {
+        BlockMasks masks;
+        if (len - block >= 64) {
+            masks = classify_block(reinterpret_cast<const uint8_t *>(p + block));
+        } else {
+            uint8_t tail[64];
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, p + block, len - block);
+            masks = classify_block(tail);
+        }
+
+        // A backslash escapes the next byte unless it is itself escaped.
+        // Backslashes are rare in event frames, so walk them one by one.
+        uint64_t escaped = prev_escaped;
+        prev_escaped = 0;
+        uint64_t backslashes = masks.backslash & ~escaped;
+        while (backslashes) {
+            const int bit = count_trailing_zeros(backslashes);
+            if (bit == 63) {
+                prev_escaped = 1;
+                break;
+            }
+            escaped |= 1ull << (bit + 1);
+            backslashes &= ~(3ull << bit);
+        }
+
+        const uint64_t quotes = masks.quote & ~escaped;
+        const uint64_t string_mask = prefix_xor(quotes) ^ prev_in_string;
+        prev_in_string = (uint64_t)((int64_t)string_mask >> 63);
+
+        // Strings may not hold raw control bytes, and backslashes may only
+        // start one of the escapes JSON defines, inside a string
+        const uint64_t escapes = masks.backslash & ~escaped;
+        if ((masks.control & string_mask) || (escapes & ~string_mask)) {
+            count = 0;
+            return false;
+        }
+        for (uint64_t bits = escapes; bits; bits &= bits - 1) {
+            if (!is_valid_escape(json, block + count_trailing_zeros(bits))) {
+                count = 0;
+                return false;
+            }
+        }
+
+        uint64_t structural = (masks.ops & ~string_mask) | quotes;
+        while (structural) {
+            if (!handle_structural(block + count_trailing_zeros(structural))) {
+                count = 0;
+                return false;
+            }
+            structural &= structural - 1;
+        }
+    }
+
+    if (!done || in_string || !is_blank(p, end_pos, len)) {
+        count = 0;
+        return false;
+    }
+    return true;
+}
+
+bool ObjectView::parse_msgpack(std::string_view data)
+{
+    base = data.data();
+    format = Encoding::MessagePack;
+    count = 0;
+    if (data.size() > UINT32_MAX) return false;
+
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(data.data());
+    const size_t len = data.size();
+
+    MsgpackItem map;
+    if (!read_msgpack_item(p, len, 0, map) || map.kind != ValueKind::Object) return false;
+    size_t pos = map.header;
+
+    for (uint64_t pair = 0; pair < map.children / 2; pair++) {
+        MsgpackItem key_item;
+        if (!read_msgpack_item(p, len, pos, key_item) || key_item.kind != ValueKind::String) {
+            count = 0;
+            return false;
+        }
+        const size_t key_begin = pos + key_item.header;
+        const size_t key_end = key_begin + key_item.payload;
+        pos = key_end;
+
+        MsgpackItem value_item;
+        if (!read_msgpack_item(p, len, pos, value_item)) {
+            count = 0;
+            return false;
+        }
+        // Strings are recorded as their payload, everything else as the
+        // complete encoded value
+        const size_t value_begin = value_item.kind == ValueKind::String ? pos + value_item.header : pos;
+        if (!skip_msgpack_value(p, len, pos)) {
+            count = 0;
+            return false;
+        }
+
+        if (count < MAX_MEMBERS) {
+            members[count++] = {(uint32_t)key_begin, (uint32_t)key_end, (uint32_t)value_begin, (uint32_t)pos,
+                                value_item.kind};
+        }
+    }
+
+    if (pos != len) {
+        count = 0;
+        return false;
+    }
+    return true;
+}
+
+std::string_view ObjectView::key(size_t index) const
+{
+    return std::string_view(base + members[index].key_begin, members[index].key_end - members[index].key_begin);
+}
+
+std::string_view ObjectView::value(size_t index) const
+{
+    return std::string_view(base + members[index].value_begin, members[index].value_end - members[index].value_begin);
+}
+
+int ObjectView::find(std::string_view name) const
+{
+    for (size_t i = 0; i < count; i++) {
+        if (key(i) == name) return (int)i;
+    }
+    return -1;
+}
+
+bool ObjectView::is_string(std::string_view name) const
+{
+    const int index = find(name);
+    return index >= 0 && kind(index) == ValueKind::String;
+}
+
+bool ObjectView::is_object(std::string_view name) const
+{
+    const int index = find(name);
+    return index >= 0 && kind(index) == ValueKind::Object;
+}
+
+std::string_view ObjectView::raw_string(std::string_view name) const
+{
+    const int index = find(name);
+    if (index < 0 || kind(index) != ValueKind::String) return std::string_view();
+    if (format == Encoding::MessagePack) return value(index);
+    const std::string_view quoted = value(index);
+    return quoted.substr(1, quoted.size() - 2);
+}
+
+bool ObjectView::copy_string(std::string_view name, char *buf, size_t size) const
+{
+    const int index = find(name);
+    if (index < 0 || kind(index) != ValueKind::String || size == 0) return false;
+    const std::string_view s = raw_string(name);
+
+    if (format == Encoding::MessagePack) {
+        if (s.size() >= size) return false;
+        memcpy(buf, s.data(), s.size());
+        buf[s.size()] = '\0';
+        return true;
+    }
+
+    size_t out = 0;
+    auto put = [&](char c) -> bool {
+        if (out + 1 >= size) return false;
+        buf[out++] = c;
+        return true;
+    };
+
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] != '\\') {
+            if (!put(s[i])) return false;
+            continue;
+        }
+        if (++i >= s.size()) return false;
+        switch (s[i]) {
+        case '"': if (!put('"')) return false; break;
+        case '\\': if (!put('\\')) return false; break;
+        case '/': if (!put('/')) return false; break;
+        case 'b': if (!put('\b')) return false; break;
+        case 'f': if (!put('\f')) return false; break;
+        case 'n': if (!put('\n')) return false; break;
+        case 'r': if (!put('\r')) return false; break;
+        case 't': if (!put('\t')) return false; break;
+        case 'u': {
+            uint32_t cp;
+            if (!read_hex4(s, i + 1, cp)) return false;
+            i += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                uint32_t low;
+                if (i + 2 >= s.size() || s[i + 1] != '\\' || s[i + 2] != 'u' ||
+                    !read_hex4(s, i + 3, low) || low < 0xDC00 || low > 0xDFFF) {
+                    return false;
+                }
+                i += 6;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            }
+            bool ok;
+            if (cp < 0x80) {
+                ok = put((char)cp);
+            } else if (cp < 0x800) {
+                ok = put((char)(0xC0 | (cp >> 6))) && put((char)(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                ok = put((char)(0xE0 | (cp >> 12))) && put((char)(0x80 | ((cp >> 6) & 0x3F))) &&
+                     put((char)(0x80 | (cp & 0x3F)));
+            } else {
+                ok = put((char)(0xF0 | (cp >> 18))) && put((char)(0x80 | ((cp >> 12) & 0x3F))) &&
+                     put((char)(0x80 | ((cp >> 6) & 0x3F))) && put((char)(0x80 | (cp & 0x3F)));
+            }
+            if (!ok) return false;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+
+    buf[out] = '\0';
+    return true;
+}
+
+bool ObjectView::get_int(std::string_view name, int64_t &out) const
+{
+    const int index = find(name);
+    if (index < 0 || kind(index) != ValueKind::Number) return false;
+    const std::string_view s = value(index);
+
+    if (format == Encoding::MessagePack) {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(s.data());
+        const uint8_t tag = p[0];
+        if (tag <= 0x7f) {
+            out = tag;
+        } else if (tag >= 0xe0) {
+            out = (int8_t)tag;
+        } else if (tag >= 0xcc && tag <= 0xcf) {
+            const uint64_t value = read_big_endian(p + 1, s.size() - 1);
+            if (value > (uint64_t)INT64_MAX) return false;
+            out = (int64_t)value;
+        } else if (tag >= 0xd0 && tag <= 0xd3) {
+            const size_t bytes = s.size() - 1;
+            const uint64_t value = read_big_endian(p + 1, bytes);
+            const unsigned shift = 64 - 8 * (unsigned)bytes;
+            out = shift ? (int64_t)(value << shift) >> shift : (int64_t)value;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const auto result = std::from_chars(s.data(), s.data() + s.size(), out);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+}
+
+bool ObjectView::get_bool(std::string_view name, bool &out) const
+{
+    const int index = find(name);
+    if (index < 0) return false;
+    if (kind(index) == ValueKind::True) {
+        out = true;
+    } else if (kind(index) == ValueKind::False) {
+        out = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ObjectView ObjectView::object(std::string_view name) const
+{
+    ObjectView nested;
+    const int index = find(name);
+    if (index >= 0 && kind(index) == ValueKind::Object) {
+        if (format == Encoding::MessagePack) {
+            nested.parse_msgpack(value(index));
+        } else {
+            nested.parse(value(index));
+        }
+    }
+    return nested;
+}
+
+const char *scanner_name()
+{
+    return SCANNER_NAME;
+}
+
+} // namespace MeetingMindJson
@@ -0,0 +1,99 @@
+/*
+MeetingMind Event Parser
+Allocation-free parser for inbound event frames. JSON text frames go
+through a SIMD pass that classifies structural characters 64 bytes at a
+time (in the style of simdjson stage 1) and a small state machine that
+records the top-level members as spans into the original frame. Binary
+frames carry the same object encoded as a MessagePack map.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace MeetingMindJson {
+
+enum class ValueKind : uint8_t {
+    String,
+    Number,
+    Object,
+    Array,
+    True,
+    False,
+    Null,
+};
+
+enum class Encoding : uint8_t {
+    Json,
+    MessagePack,
+};
+
+// Top-level members of one JSON object or MessagePack map. Keys and values
+// are offsets into the parsed buffer, which must outlive the view.
+class ObjectView {
+public:
+    static constexpr size_t MAX_MEMBERS = 16;
+    static constexpr size_t MAX_DEPTH = 64;
+
+    // Returns false if the buffer is not a single well-formed JSON object.
+    // Members beyond MAX_MEMBERS are validated but not recorded. Strings are
+    // checked for escapes and control bytes at every depth; otherwise nested
+    // containers are checked for balance only; use object() to validate one.
+    bool parse(std::string_view json);
+
+    // Same contract for a MessagePack map with string keys. Strings and
+    // binaries are exposed as String, integers and floats as Number;
+    // extension types are rejected.
+    bool parse_msgpack(std::string_view data);
+
+    Encoding encoding() const { return format; }
+
+    size_t size() const { return count; }
+    std::string_view key(size_t index) const;
+    std::string_view value(size_t index) const;
+    ValueKind kind(size_t index) const { return members[index].kind; }
+
+    // Index of the member with the given key, or -1. Keys are compared as
+    // raw (still escaped) bytes.
+    int find(std::string_view key) const;
+
+    bool is_string(std::string_view key) const;
+    bool is_object(std::string_view key) const;
+
+    // String contents without the surrounding quotes, still escaped (JSON)
+    // or the raw payload bytes (MessagePack)
+    std::string_view raw_string(std::string_view key) const;
+
+    // Unescapes a string member into buf and NUL-terminates it. Returns
+    // false if the member is missing, not a string or does not fit.
+    bool copy_string(std::string_view key, char *buf, size_t size) const;
+
+    bool get_int(std::string_view key, int64_t &out) const;
+    bool get_bool(std::string_view key, bool &out) const;
+
+    // Parses a nested object member; the result is empty if the member is
+    // missing or not an object.
+    ObjectView object(std::string_view key) const;
+
+private:
+    struct Member {
+        uint32_t key_begin;
+        uint32_t key_end;
+        uint32_t value_begin;
+        uint32_t value_end;
+        ValueKind kind;
+    };
+
+    const char *base = nullptr;
+    Encoding format = Encoding::Json;
+    size_t count = 0;
+    std::array<Member, MAX_MEMBERS> members{};
+};
+
+// Name of the structural scanner compiled in ("sse2", "neon" or "scalar")
+const char *scanner_name();
+
+} // namespace MeetingMindJson
@@ -0,0 +1,178 @@
+/*
+MeetingMind Event Registry
+Compile-time perfect-hash table mapping event names to handlers
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace MeetingMindDispatch {
+
+// 64-bit FNV-1a over the key; computed once per lookup
+constexpr uint64_t hash_name(std::string_view name)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (char c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// splitmix64 finalizer so that every seed produces an independent spread
+constexpr uint32_t mix_hash(uint64_t h, uint32_t seed)
+{
+    h ^= seed * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return static_cast<uint32_t>(h);
+}
+
+constexpr std::size_t next_pow2(std::size_t n)
+{
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+template <typename Value>
+struct HashEntry {
+    std::string_view key;
+    Value value;
+};
+
+// Hash-and-displace perfect hash map. Keys are first spread into buckets with
+// seed 0; each bucket then gets its own displacement seed chosen so that all
+// of its keys land in distinct free slots. A lookup is always one pass over
+// the key, two finalizer rounds and one key comparison, independent of the
+// number of entries.
+template <typename Value, std::size_t N>
+class PerfectHashMap {
+public:
+    static constexpr std::size_t bucket_count = next_pow2(N);
+    static constexpr std::size_t slot_count = 2 * next_pow2(N);
+
+    constexpr explicit PerfectHashMap(const HashEntry<Value> (&entries)[N])
+    {
+        // Counting sort of entries by first-level bucket
+        std::array<uint64_t, N> hashes{};
+        std::array<std::size_t, N> bucket_of{};
+        std::array<std::size_t, bucket_count + 1> offsets{};
+        for (std::size_t i = 0; i < N; i++) {
+            hashes[i] = hash_name(entries[i].key);
+            bucket_of[i] = mix_hash(hashes[i], 0) & (bucket_count - 1);
+            offsets[bucket_of[i] + 1]++;
+        }
+        for (std::size_t b = 0; b < bucket_count; b++) {
+            offsets[b + 1] += offsets[b];
+        }
+
+        std::array<std::size_t, N> members{};
+        std::array<std::size_t, bucket_count> fill{};
+        for (std::size_t i = 0; i < N; i++) {
+            const std::size_t b = bucket_of[i];
+            members[offsets[b] + fill[b]++] = i;
+        }
+
+        // Largest buckets are the hardest to place, so place them first
+        std::array<std::size_t, bucket_count> order{};
+        for (std::size_t b = 0; b < bucket_count; b++) order[b] = b;
+        for (std::size_t i = 1; i < bucket_count; i++) {
+            const std::size_t b = order[i];
+            const std::size_t size = offsets[b + 1] - offsets[b];
+            std::size_t j = i;
+            while (j > 0 && offsets[order[j - 1] + 1] - offsets[order[j - 1]] < size) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = b;
+        }
+
+        for (std::size_t b : order) {
+            const std::size_t begin = offsets[b];
+            const std::size_t end = offsets[b + 1];
+            if (begin == end) break;
+
+            for (std::size_t i = begin; i < end; i++) {
+                for (std::size_t j = begin; j < i; j++) {
+                    if (entries[members[i]].key == entries[members[j]].key) {
+                        throw std::logic_error("duplicate key in perfect hash map");
+                    }
+                }
+            }
+
+            uint32_t seed = 1;
+            while (!try_place(entries, hashes, members, begin, end, seed)) {
+                if (++seed == 0) {
+                    throw std::logic_error("no displacement seed found");
+                }
+            }
+            seeds_[b] = seed;
+        }
+    }
+
+    constexpr const Value *find(std::string_view key) const
+    {
+        const int slot = find_slot(key);
+        return slot < 0 ? nullptr : &slots_[slot].value;
+    }
+
+    // Slot holding key, or -1. Slots never move, so they can index side
+    // tables of slot_count entries.
+    constexpr int find_slot(std::string_view key) const
+    {
+        const uint64_t h = hash_name(key);
+        const uint32_t bucket = mix_hash(h, 0) & (bucket_count - 1);
+        const uint32_t slot = mix_hash(h, seeds_[bucket]) & (slot_count - 1);
+        if (!occupied_[slot] || slots_[slot].key != key) return -1;
+        return (int)slot;
+    }
+
+    constexpr bool occupied(std::size_t slot) const { return occupied_[slot]; }
+    constexpr const HashEntry<Value> &entry(std::size_t slot) const { return slots_[slot]; }
+
+    constexpr std::size_t size() const { return N; }
+
+private:
+    constexpr bool try_place(const HashEntry<Value> (&entries)[N],
+                             const std::array<uint64_t, N> &hashes,
+                             const std::array<std::size_t, N> &members,
+                             std::size_t begin, std::size_t end, uint32_t seed)
+    {
+        std::array<std::size_t, N> placed{};
+        for (std::size_t i = begin; i < end; i++) {
+            const std::size_t slot = mix_hash(hashes[members[i]], seed) & (slot_count - 1);
+            if (occupied_[slot]) return false;
+            for (std::size_t j = 0; j < i - begin; j++) {
+                if (placed[j] == slot) return false;
+            }
+            placed[i - begin] = slot;
+        }
+        for (std::size_t i = begin; i < end; i++) {
+            const std::size_t slot = placed[i - begin];
+            slots_[slot] = entries[members[i]];
+            occupied_[slot] = true;
+        }
+        return true;
+    }
+
+    std::array<uint32_t, bucket_count> seeds_{};
+    std::array<HashEntry<Value>, slot_count> slots_{};
+    std::array<bool, slot_count> occupied_{};
+};
+
+template <typename Value, std::size_t N>
+constexpr PerfectHashMap<Value, N> make_perfect_hash_map(const HashEntry<Value> (&entries)[N])
+{
+    return PerfectHashMap<Value, N>(entries);
+}
+
+} // namespace MeetingMindDispatch
@@ -0,0 +1,344 @@
+/*
+MeetingMind Jitter Buffer
+Reorders numbered PCM packets from the network and plays them out at a
+steady rate, adapting its depth to the measured jitter and covering lost
+packets with a faded repeat of the last one
+*/
+
+#include "jitter-buffer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace MeetingMindAudio {
+
+namespace {
+
+// A sequence number this far behind playout means the sender restarted
+const int32_t RESTART_DISTANCE = (int32_t)JitterBuffer::SLOTS * 4;
+
+// Multiples of the measured jitter kept buffered beyond one packet
+const double JITTER_MARGIN = 4.0;
+
+// Per packet, the target moves this fraction of the way down to what the
+// jitter calls for; about a second and a half at 20 ms packets
+const double TARGET_EASE = 1.0 / 64.0;
+
+} // namespace
+
+JitterBuffer::JitterBuffer(const JitterParams &params)
+    : params_(params),
+      samples_(SLOTS * MAX_CHANNELS * MAX_PACKET_FRAMES),
+      reference_(MAX_CHANNELS * MAX_PACKET_FRAMES)
+{
+}
+
+InsertResult JitterBuffer::insert(uint32_t sequence, uint64_t pts, uint32_t sample_rate, size_t channels,
+                                  const int16_t *samples, size_t frames, uint64_t arrival_ns)
+{
+    if (!frames || frames > MAX_PACKET_FRAMES || !channels || channels > MAX_CHANNELS || !sample_rate) {
+        return InsertResult::Invalid;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sample_rate != rate_ || channels != channels_) {
+        rate_ = sample_rate;
+        channels_ = channels;
+        reset_locked();
+    }
+
+    int32_t distance = (int32_t)(sequence - next_sequence_);
+    if (started_ && (distance >= (int32_t)SLOTS || distance < -RESTART_DISTANCE)) {
+        // Too far ahead to hold, or far behind: the stream has moved on
+        // without us, so pick it up again from here
+        reset_locked();
+    }
+    if (!started_) {
+        started_ = true;
+        next_sequence_ = sequence;
+        offset_ = 0;
+        play_pts_ = pts;
+        newest_end_pts_ = pts;
+        distance = 0;
+    }
+    last_arrival_ns_ = arrival_ns;
+
+    if (distance < 0) {
+        stats_.late++;
+        return InsertResult::Late;
+    }
+    Slot &slot = slots_[sequence % SLOTS];
+    if (slot.used && slot.sequence == sequence) {
+        stats_.duplicates++;
+        return InsertResult::Duplicate;
+    }
+
+    const size_t index = sequence % SLOTS;
+    for (size_t c = 0; c < channels; c++) {
+        float *plane = slot_plane(index, c);
+        for (size_t f = 0; f < frames; f++) plane[f] = samples[f * channels + c] * (1.0f / 32768.0f);
+    }
+    slot.used = true;
+    slot.sequence = sequence;
+    slot.pts = pts;
+    slot.frames = frames;
+    if ((int64_t)(pts + frames - newest_end_pts_) > 0) newest_end_pts_ = pts + frames;
+    stats_.packets++;
+
+    // RFC 3550 interarrival jitter: how much the network delay varies from
+    // one packet to the next, smoothed over about 16 packets
+    const int64_t transit = (int64_t)arrival_ns - (int64_t)(pts * 1000000000.0 / rate_);
+    if (have_transit_) {
+        const double change = (double)std::llabs(transit - last_transit_ns_);
+        jitter_ns_ += (change - jitter_ns_) / 16.0;
+    }
+    have_transit_ = true;
+    last_transit_ns_ = transit;
+    update_target(frames);
+    return InsertResult::Accepted;
+}
+
+void JitterBuffer::update_target(size_t packet_frames)
+{
+    packet_frames_ = packet_frames;
+    const double jitter_frames = jitter_ns_ * rate_ / 1e9;
+    const double wanted = std::min<double>(std::max<double>(packet_frames + JITTER_MARGIN * jitter_frames,
+                                                            ms_to_frames(params_.min_delay_ms)),
+                                           ms_to_frames(params_.max_delay_ms));
+    if (wanted > target_frames_) {
+        target_frames_ = wanted;
+    } else {
+        target_frames_ += (wanted - target_frames_) * TARGET_EASE;
+    }
+}
+
+bool JitterBuffer::read(float *const *planes, size_t frames, uint64_t now_ns)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_) return false;
+    if (now_ns > last_arrival_ns_ + params_.idle_ms * 1000000ull) {
+        reset_locked();
+        return false;
+    }
+
+    if (!playing_) {
+        if (depth_frames() >= (int64_t)target_frames_) {
+            playing_ = true;
+            ever_played_ = true;
+        } else if (!ever_played_) {
+            return false;
+        } else {
+            conceal(planes, 0, frames);
+            return true;
+        }
+    }
+
+    size_t done = 0;
+    while (done < frames) {
+        Slot &slot = slots_[next_sequence_ % SLOTS];
+        if (slot.used && slot.sequence == next_sequence_) {
+            if (offset_ == 0) {
+                // The packet's position, not its arrival, says where it
+                // plays: a gap before it is covered, and if it came in part
+                // way through its own turn only the rest of it plays
+                const int64_t lead = (int64_t)(slot.pts - play_pts_);
+                if (lead > 0) {
+                    const size_t count = (size_t)std::min<int64_t>(lead, (int64_t)(frames - done));
+                    conceal(planes, done, count);
+                    play_pts_ += count;
+                    done += count;
+                    continue;
+                }
+                if ((size_t)-lead >= slot.frames) {
+                    stats_.late++;
+                    slot.used = false;
+                    next_sequence_++;
+                    continue;
+                }
+                offset_ = (size_t)-lead;
+
+                // Well past the target: skip this packet to catch up
+                if (offset_ == 0 && depth_frames() - (int64_t)slot.frames > (int64_t)(target_frames_ * 1.5)) {
+                    stats_.discarded++;
+                    slot.used = false;
+                    next_sequence_++;
+                    play_pts_ += slot.frames;
+                    fade_in_remaining_ = ms_to_frames(params_.fade_ms);
+                    continue;
+                }
+            }
+
+            const size_t count = std::min(frames - done, slot.frames - offset_);
+            play(planes, done, count);
+            offset_ += count;
+            play_pts_ += count;
+            done += count;
+            if (offset_ == slot.frames) finish_packet(slot);
+            continue;
+        }
+
+        uint32_t later_sequence = 0;
+        const Slot *later = next_present(&later_sequence);
+        if (!later) {
+            // Ran dry. Cover the rest and buffer up again; the delay grows
+            // by however long the network stalled.
+            conceal(planes, done, frames - done);
+            stats_.underruns++;
+            playing_ = false;
+            target_frames_ =
+                std::min<double>(target_frames_ + 2.0 * packet_frames_, ms_to_frames(params_.max_delay_ms));
+            return true;
+        }
+
+        // Lost: everything before the next packet that did arrive
+        stats_.lost += later_sequence - next_sequence_;
+        next_sequence_ = later_sequence;
+        offset_ = 0;
+    }
+    return true;
+}
+
+void JitterBuffer::play(float *const *planes, size_t at, size_t frames)
+{
+    const size_t index = next_sequence_ % SLOTS;
+    for (size_t c = 0; c < MAX_CHANNELS; c++) {
+        if (c < channels_) {
+            memcpy(planes[c] + at, slot_plane(index, c) + offset_, frames * sizeof(float));
+        } else {
+            std::fill(planes[c] + at, planes[c] + at + frames, 0.0f);
+        }
+    }
+
+    if (fade_in_remaining_) {
+        const size_t fade_frames = std::max<size_t>(ms_to_frames(params_.fade_ms), 1);
+        const size_t count = std::min(frames, fade_in_remaining_);
+        for (size_t i = 0; i < count; i++) {
+            const float gain = 1.0f - (float)(fade_in_remaining_ - i) / fade_frames;
+            for (size_t c = 0; c < channels_; c++) planes[c][at + i] *= gain;
+        }
+        fade_in_remaining_ -= count;
+    }
+}
+
+void JitterBuffer::conceal(float *const *planes, size_t at, size_t frames)
+{
+    // Repeats the last packet, fading to silence over its length
+    const float step = reference_frames_ ? 1.0f / reference_frames_ : 1.0f;
+    float gain = conceal_gain_;
+    size_t position = conceal_position_;
+    for (size_t c = 0; c < MAX_CHANNELS; c++) {
+        float *out = planes[c] + at;
+        if (c >= channels_ || !reference_frames_ || conceal_gain_ <= 0.0f) {
+            std::fill(out, out + frames, 0.0f);
+            continue;
+        }
+        const float *reference = reference_.data() + c * MAX_PACKET_FRAMES;
+        gain = conceal_gain_;
+        position = conceal_position_;
+        for (size_t i = 0; i < frames; i++) {
+            out[i] = reference[position] * gain;
+            gain = std::max(0.0f, gain - step);
+            if (++position == reference_frames_) position = 0;
+        }
+    }
+    conceal_gain_ = reference_frames_ ? gain : 0.0f;
+    conceal_position_ = position;
+    stats_.concealed_frames += frames;
+    fade_in_remaining_ = ms_to_frames(params_.fade_ms);
+}
+
+void JitterBuffer::finish_packet(Slot &slot)
+{
+    // Kept for concealment in case the next one does not arrive
+    const size_t index = next_sequence_ % SLOTS;
+    for (size_t c = 0; c < channels_; c++) {
+        memcpy(reference_.data() + c * MAX_PACKET_FRAMES, slot_plane(index, c), slot.frames * sizeof(float));
+    }
+    reference_frames_ = slot.frames;
+    conceal_position_ = 0;
+    conceal_gain_ = 1.0f;
+
+    slot.used = false;
+    next_sequence_++;
+    offset_ = 0;
+}
+
+const JitterBuffer::Slot *JitterBuffer::next_present(uint32_t *sequence) const
+{
+    for (uint32_t i = 1; i < SLOTS; i++) {
+        const Slot &slot = slots_[(next_sequence_ + i) % SLOTS];
+        if (slot.used && slot.sequence == next_sequence_ + i) {
+            *sequence = slot.sequence;
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+int64_t JitterBuffer::depth_frames() const
+{
+    return (int64_t)(newest_end_pts_ - play_pts_);
+}
+
+size_t JitterBuffer::ms_to_frames(uint32_t ms) const
+{
+    return (size_t)((uint64_t)rate_ * ms / 1000);
+}
+
+void JitterBuffer::set_params(const JitterParams &params)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    params_ = params;
+}
+
+uint32_t JitterBuffer::sample_rate() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate_;
+}
+
+size_t JitterBuffer::channels() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channels_;
+}
+
+JitterStats JitterBuffer::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    JitterStats stats = stats_;
+    stats.jitter_ms = jitter_ns_ / 1e6;
+    if (rate_) {
+        stats.target_ms = target_frames_ * 1000.0 / rate_;
+        stats.depth_ms = started_ ? std::max<int64_t>(depth_frames(), 0) * 1000.0 / rate_ : 0.0;
+    }
+    return stats;
+}
+
+void JitterBuffer::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reset_locked();
+    stats_ = JitterStats();
+}
+
+void JitterBuffer::reset_locked()
+{
+    // Keeps the format and the counters; everything in flight is dropped
+    for (Slot &slot : slots_) slot.used = false;
+    started_ = false;
+    playing_ = false;
+    ever_played_ = false;
+    offset_ = 0;
+    have_transit_ = false;
+    jitter_ns_ = 0.0;
+    target_frames_ = (double)ms_to_frames(params_.start_delay_ms);
+    packet_frames_ = 0;
+    reference_frames_ = 0;
+    conceal_position_ = 0;
+    conceal_gain_ = 1.0f;
+    fade_in_remaining_ = 0;
+}
+
+} // namespace MeetingMindAudio
@@ -0,0 +1,151 @@
+/*
+MeetingMind Jitter Buffer
+Reorders numbered PCM packets from the network and plays them out at a
+steady rate, adapting its depth to the measured jitter and covering lost
+packets with a faded repeat of the last one
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace MeetingMindAudio {
+
+struct JitterParams {
+    uint32_t min_delay_ms = 40;
+    uint32_t max_delay_ms = 500;
+    uint32_t start_delay_ms = 100; // Target until jitter has been measured
+    uint32_t fade_ms = 5;          // Fade in after concealment or a skip
+    uint32_t idle_ms = 2000;       // Without packets for this long the feed has stopped
+};
+
+struct JitterStats {
+    uint64_t packets = 0;          // Accepted
+    uint64_t late = 0;             // Arrived after their turn to play
+    uint64_t duplicates = 0;
+    uint64_t lost = 0;             // Never arrived; concealed
+    uint64_t discarded = 0;        // Skipped to bring the depth back down
+    uint64_t underruns = 0;        // Times playout ran dry and rebuffered
+    uint64_t concealed_frames = 0;
+    double jitter_ms = 0.0;        // RFC 3550 interarrival jitter
+    double target_ms = 0.0;
+    double depth_ms = 0.0;         // Buffered ahead of playout
+};
+
+enum class InsertResult {
+    Accepted,
+    Duplicate,
+    Late,
+    Invalid,
+};
+
+// One feed of network audio. The network thread inserts packets, each
+// numbered and stamped with the position of its first frame in samples;
+// the playout thread reads fixed-size blocks. Playout starts once the
+// buffered audio reaches the target depth, and the sample positions decide
+// where every packet and every gap falls, so output stays sample-accurate
+// whatever order packets arrive in.
+//
+// The target follows the jitter: it rises at once when jitter grows or
+// playout runs dry, and eases back when the network settles, skipping a
+// packet when the buffer runs well past it. A missing packet is covered by
+// the last one played, fading to silence over its length, and real audio
+// fades back in.
+//
+// Both sides take a short lock; storage for SLOTS packets is allocated up
+// front, so neither side allocates.
+class JitterBuffer {
+public:
+    static constexpr size_t SLOTS = 64;
+    static constexpr size_t MAX_PACKET_FRAMES = 2880; // 60 ms at 48 kHz
+    static constexpr size_t MAX_CHANNELS = 2;
+
+    explicit JitterBuffer(const JitterParams &params = JitterParams());
+
+    JitterBuffer(const JitterBuffer &) = delete;
+    JitterBuffer &operator=(const JitterBuffer &) = delete;
+
+    // Network side. samples holds frames interleaved 16-bit frames. A change
+    // of sample rate or channel count restarts the buffer.
+    InsertResult insert(uint32_t sequence, uint64_t pts, uint32_t sample_rate, size_t channels,
+                        const int16_t *samples, size_t frames, uint64_t arrival_ns);
+
+    // Playout side. Writes frames frames to each of MAX_CHANNELS planes and
+    // returns true, or returns false while the feed has not started or has
+    // gone idle, in which case nothing is written.
+    bool read(float *const *planes, size_t frames, uint64_t now_ns);
+
+    // Takes effect as the target next moves
+    void set_params(const JitterParams &params);
+
+    // Format of the packets being buffered; 0 before the first packet
+    uint32_t sample_rate() const;
+    size_t channels() const;
+
+    JitterStats stats() const;
+
+    void reset();
+
+private:
+    struct Slot {
+        bool used = false;
+        uint32_t sequence = 0;
+        uint64_t pts = 0;
+        size_t frames = 0;
+    };
+
+    float *slot_plane(size_t slot, size_t channel)
+    {
+        return samples_.data() + (slot * MAX_CHANNELS + channel) * MAX_PACKET_FRAMES;
+    }
+
+    void reset_locked();
+    size_t ms_to_frames(uint32_t ms) const;
+    int64_t depth_frames() const;
+    const Slot *next_present(uint32_t *sequence) const;
+    void play(float *const *planes, size_t at, size_t frames);
+    void conceal(float *const *planes, size_t at, size_t frames);
+    void finish_packet(Slot &slot);
+    void update_target(size_t packet_frames);
+
+    mutable std::mutex mutex_;
+    JitterParams params_;
+
+    uint32_t rate_ = 0;
+    size_t channels_ = 0;
+
+    Slot slots_[SLOTS];
+    std::vector<float> samples_; // Slot s, channel c at (s * MAX_CHANNELS + c) * MAX_PACKET_FRAMES
+
+    // Playout position: the packet being played, how far into it, and the
+    // sample position of the next frame out
+    bool started_ = false;
+    bool playing_ = false;
+    bool ever_played_ = false;
+    uint32_t next_sequence_ = 0;
+    size_t offset_ = 0;
+    uint64_t play_pts_ = 0;
+    uint64_t newest_end_pts_ = 0;
+    uint64_t last_arrival_ns_ = 0;
+
+    // Depth control
+    bool have_transit_ = false;
+    int64_t last_transit_ns_ = 0;
+    double jitter_ns_ = 0.0;
+    double target_frames_ = 0.0;
+    size_t packet_frames_ = 0;
+
+    // Concealment: the last packet played, and where its faded repeat is
+    std::vector<float> reference_;
+    size_t reference_frames_ = 0;
+    size_t conceal_position_ = 0;
+    float conceal_gain_ = 1.0f;
+    size_t fade_in_remaining_ = 0;
+
+    JitterStats stats_;
+};
+
+} // namespace MeetingMindAudio
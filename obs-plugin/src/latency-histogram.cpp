@@ -0,0 +1,122 @@
+/*
+MeetingMind Latency Histograms
+Fixed-size log-linear histograms for event latency, one set per event type
+and pipeline stage
+*/
+
+#include "latency-histogram.hpp"
+
+#include <algorithm>
+
+namespace MeetingMindLatency {
+
+namespace {
+
+constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << LatencyHistogram::SUB_BUCKET_BITS;
+constexpr uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+constexpr uint64_t MAX_TRACKABLE = (uint64_t(1) << LatencyHistogram::MAX_VALUE_BITS) - 1;
+
+unsigned highest_bit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - (unsigned)__builtin_clzll(value);
+#else
+    unsigned bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+#endif
+}
+
+} // namespace
+
+const char *stage_name(Stage stage)
+{
+    switch (stage) {
+    case STAGE_PARSE: return "parse";
+    case STAGE_QUEUE: return "queue";
+    case STAGE_HANDLE: return "handle";
+    case STAGE_TOTAL: return "total";
+    default: return "unknown";
+    }
+}
+
+// Values below SUB_BUCKET_COUNT get a bucket each. Above that, a value whose
+// highest bit is b lands in exponent e = b - (SUB_BUCKET_BITS - 1) and keeps
+// its top SUB_BUCKET_BITS bits as the sub-bucket, which always has the high
+// bit set, so each exponent contributes SUB_BUCKET_HALF buckets.
+size_t LatencyHistogram::bucket_index(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT) return (size_t)value;
+    const unsigned exponent = highest_bit(value) - (SUB_BUCKET_BITS - 1);
+    return (size_t)(exponent * SUB_BUCKET_HALF + (value >> exponent));
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) return index;
+    const unsigned exponent = (unsigned)(index / SUB_BUCKET_HALF) - 1;
+    const uint64_t sub_bucket = index - exponent * SUB_BUCKET_HALF;
+    return ((sub_bucket + 1) << exponent) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_ns)
+{
+    const uint64_t value = std::min(value_ns, MAX_TRACKABLE);
+    counts[bucket_index(value)]++;
+    total++;
+    if (value > max_value) max_value = value;
+}
+
+void LatencyHistogram::reset()
+{
+    counts.fill(0);
+    total = 0;
+    max_value = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double fraction) const
+{
+    if (total == 0) return 0;
+
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+    const uint64_t rank = std::max<uint64_t>(1, (uint64_t)(fraction * (double)total + 0.5));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(bucket_upper_bound(i), max_value);
+    }
+    return max_value;
+}
+
+LatencyRecorder::LatencyRecorder(size_t type_count)
+    : per_type(type_count)
+{
+}
+
+void LatencyRecorder::record(size_t type, Stage stage, uint64_t value_ns)
+{
+    all_types[stage].record(value_ns);
+
+    if (type >= per_type.size()) return;
+    if (!per_type[type]) per_type[type] = std::make_unique<StageHistograms>();
+    (*per_type[type])[stage].record(value_ns);
+}
+
+void LatencyRecorder::reset()
+{
+    for (LatencyHistogram &histogram : all_types) histogram.reset();
+    for (auto &histograms : per_type) {
+        if (histograms) {
+            for (LatencyHistogram &histogram : *histograms) histogram.reset();
+        }
+    }
+}
+
+const LatencyHistogram *LatencyRecorder::histogram(size_t type, Stage stage) const
+{
+    if (type >= per_type.size() || !per_type[type]) return nullptr;
+    return &(*per_type[type])[stage];
+}
+
+} // namespace MeetingMindLatency
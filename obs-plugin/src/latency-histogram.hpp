@@ -0,0 +1,83 @@
+/*
+MeetingMind Latency Histograms
+Fixed-size log-linear histograms for event latency, one set per event type
+and pipeline stage
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MeetingMindLatency {
+
+// Stages of one event's trip through the plugin. Total runs from the frame
+// arriving on the socket to the last OBS call it caused returning, including
+// any coalescing delay.
+enum Stage {
+    STAGE_PARSE,    // received -> parsed and validated (network thread)
+    STAGE_QUEUE,    // parsed -> picked up by the UI thread
+    STAGE_HANDLE,   // picked up -> handler returned
+    STAGE_TOTAL,    // received -> OBS call complete
+    STAGE_COUNT,
+};
+
+const char *stage_name(Stage stage);
+
+// HDR-style histogram of nanosecond values. Each power of two is split into
+// 16 linear sub-buckets, so any reported value is within about 6% of the
+// recorded one. Recording is a couple of shifts and an increment; the
+// buckets cover 1 ns to about 18 minutes in 2.5 KB.
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) << (SUB_BUCKET_BITS - 1);
+
+    void record(uint64_t value_ns);
+    void reset();
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return max_value; }
+
+    // Value at or below which the given fraction (0..1) of samples fall,
+    // reported as the upper edge of its bucket. 0 if nothing was recorded.
+    uint64_t percentile(double fraction) const;
+
+private:
+    static size_t bucket_index(uint64_t value);
+    static uint64_t bucket_upper_bound(size_t index);
+
+    std::array<uint32_t, BUCKET_COUNT> counts{};
+    uint64_t total = 0;
+    uint64_t max_value = 0;
+};
+
+// Histograms per event type and stage, plus an aggregate over all types.
+// Type ids are small dense integers chosen by the caller; a type's
+// histograms are allocated the first time it is recorded. Not thread-safe;
+// the plugin records everything on the UI thread.
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(size_t type_count);
+
+    void record(size_t type, Stage stage, uint64_t value_ns);
+    void reset();
+
+    // nullptr if the type has never been recorded
+    const LatencyHistogram *histogram(size_t type, Stage stage) const;
+    const LatencyHistogram &aggregate(Stage stage) const { return all_types[stage]; }
+
+    size_t type_count() const { return per_type.size(); }
+
+private:
+    using StageHistograms = std::array<LatencyHistogram, STAGE_COUNT>;
+
+    std::vector<std::unique_ptr<StageHistograms>> per_type;
+    StageHistograms all_types;
+};
+
+} // namespace MeetingMindLatency
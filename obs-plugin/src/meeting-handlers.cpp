@@ -0,0 +1,194 @@
+/*
+MeetingMind Meeting Handlers
+What each meeting event does to OBS, and the registry that maps event names
+to their handlers
+*/
+
+#include "meeting-handlers.hpp"
+#include "action-executor.hpp"
+#include "config-snapshot.hpp"
+
+#include <util/base.h>
+
+namespace MeetingMindEvents {
+
+namespace {
+
+using MeetingMindJson::ObjectView;
+
+void run_immediately(void (*action)())
+{
+    action();
+}
+
+// Until set_callbacks(), every action goes straight to the executor
+Callbacks host = {
+    MeetingMindActions::switch_scene,
+    MeetingMindActions::set_mute,
+    run_immediately,
+    nullptr,
+};
+
+const MeetingMindConfig::ConfigSnapshot &settings()
+{
+    thread_local MeetingMindConfig::SnapshotReader reader;
+    return reader.get();
+}
+
+} // namespace
+
+void set_callbacks(const Callbacks &callbacks)
+{
+    host = callbacks;
+}
+
+void handle_meeting_started(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_WELCOME);
+    }
+    if (settings().auto_recording) {
+        host.run_output(MeetingMindActions::start_recording);
+    }
+    if (settings().audio_management) {
+        host.set_mute(AUDIO_MICROPHONE, false);
+    }
+}
+
+void handle_meeting_ended(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_ENDING);
+    }
+    if (settings().auto_recording) {
+        host.run_output(MeetingMindActions::stop_recording);
+    }
+}
+
+void handle_participant_joined(const ObjectView &data)
+{
+    char name[256];
+    if (settings().meeting_notifications && data.copy_string("name", name, sizeof(name))) {
+        blog(LOG_INFO, "MeetingMind: Participant joined: %s", name);
+    }
+}
+
+void handle_participant_left(const ObjectView &data)
+{
+    char name[256];
+    if (settings().meeting_notifications && data.copy_string("name", name, sizeof(name))) {
+        blog(LOG_INFO, "MeetingMind: Participant left: %s", name);
+    }
+}
+
+void handle_screen_share_started(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_SCREEN_SHARE);
+    }
+    if (settings().audio_management) {
+        host.set_mute(AUDIO_DESKTOP, false);
+    }
+}
+
+void handle_screen_share_ended(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_DISCUSSION);
+    }
+}
+
+void handle_presentation_started(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_PRESENTATION);
+    }
+}
+
+void handle_presentation_ended(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_DISCUSSION);
+    }
+}
+
+void handle_break_started(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_BREAK);
+    }
+    if (settings().audio_management) {
+        host.set_mute(AUDIO_MICROPHONE, true);
+    }
+}
+
+void handle_break_ended(const ObjectView &)
+{
+    if (settings().auto_scene_switching) {
+        host.switch_scene(SCENE_DISCUSSION);
+    }
+    if (settings().audio_management) {
+        host.set_mute(AUDIO_MICROPHONE, false);
+    }
+}
+
+void handle_recording_requested(const ObjectView &)
+{
+    if (settings().auto_recording) {
+        host.run_output(MeetingMindActions::start_recording);
+    }
+}
+
+void handle_recording_stopped(const ObjectView &)
+{
+    if (settings().auto_recording) {
+        host.run_output(MeetingMindActions::stop_recording);
+    }
+}
+
+void handle_streaming_requested(const ObjectView &)
+{
+    if (settings().auto_start_streaming) {
+        host.run_output(MeetingMindActions::start_streaming);
+    }
+}
+
+void handle_streaming_stopped(const ObjectView &)
+{
+    if (settings().auto_stop_streaming) {
+        host.run_output(MeetingMindActions::stop_streaming);
+    }
+}
+
+void handle_audio_mute_requested(const ObjectView &data)
+{
+    char source[256];
+    if (settings().audio_management) {
+        host.set_mute(data.copy_string("source", source, sizeof(source)) ? source : AUDIO_MICROPHONE, true);
+    }
+}
+
+void handle_audio_unmute_requested(const ObjectView &data)
+{
+    char source[256];
+    if (settings().audio_management) {
+        host.set_mute(data.copy_string("source", source, sizeof(source)) ? source : AUDIO_MICROPHONE, false);
+    }
+}
+
+void handle_scene_change_requested(const ObjectView &data)
+{
+    char scene[256];
+    if (settings().auto_scene_switching && data.copy_string("scene", scene, sizeof(scene))) {
+        host.switch_scene(scene);
+    }
+}
+
+void handle_latency_report_requested(const ObjectView &data)
+{
+    bool reset = false;
+    data.get_bool("reset", reset);
+    if (host.send_latency_report) host.send_latency_report(reset);
+}
+
+} // namespace MeetingMindEvents
@@ -0,0 +1,83 @@
+/*
+MeetingMind Meeting Handlers
+What each meeting event does to OBS, and the registry that maps event names
+to their handlers
+*/
+
+#pragma once
+
+#include "event-parser.hpp"
+#include "event-registry.hpp"
+
+namespace MeetingMindEvents {
+
+static constexpr const char *SCENE_WELCOME = "Meeting - Welcome";
+static constexpr const char *SCENE_PRESENTATION = "Meeting - Presentation";
+static constexpr const char *SCENE_DISCUSSION = "Meeting - Discussion";
+static constexpr const char *SCENE_SCREEN_SHARE = "Meeting - Screen Share";
+static constexpr const char *SCENE_BREAK = "Meeting - Break";
+static constexpr const char *SCENE_ENDING = "Meeting - Ending";
+
+static constexpr const char *AUDIO_MICROPHONE = "Microphone";
+static constexpr const char *AUDIO_DESKTOP = "Desktop Audio";
+static constexpr const char *AUDIO_MEETING = "Meeting Audio";
+
+// How the handlers reach OBS. Scene and mute requests may be held back, as
+// the plugin's coalescer does; run_output must then apply them before
+// starting or stopping the output, so that both reach OBS in order.
+struct Callbacks {
+    void (*switch_scene)(const char *scene_name);
+    void (*set_mute)(const char *source_name, bool muted);
+    void (*run_output)(void (*action)());
+    void (*send_latency_report)(bool reset);
+};
+
+// Call before the first event is dispatched
+void set_callbacks(const Callbacks &callbacks);
+
+// Each handler reads the current config snapshot and does nothing for the
+// features it has turned off. Called on the thread that owns the actions.
+void handle_meeting_started(const MeetingMindJson::ObjectView &data);
+void handle_meeting_ended(const MeetingMindJson::ObjectView &data);
+void handle_participant_joined(const MeetingMindJson::ObjectView &data);
+void handle_participant_left(const MeetingMindJson::ObjectView &data);
+void handle_screen_share_started(const MeetingMindJson::ObjectView &data);
+void handle_screen_share_ended(const MeetingMindJson::ObjectView &data);
+void handle_presentation_started(const MeetingMindJson::ObjectView &data);
+void handle_presentation_ended(const MeetingMindJson::ObjectView &data);
+void handle_break_started(const MeetingMindJson::ObjectView &data);
+void handle_break_ended(const MeetingMindJson::ObjectView &data);
+void handle_recording_requested(const MeetingMindJson::ObjectView &data);
+void handle_recording_stopped(const MeetingMindJson::ObjectView &data);
+void handle_streaming_requested(const MeetingMindJson::ObjectView &data);
+void handle_streaming_stopped(const MeetingMindJson::ObjectView &data);
+void handle_audio_mute_requested(const MeetingMindJson::ObjectView &data);
+void handle_audio_unmute_requested(const MeetingMindJson::ObjectView &data);
+void handle_scene_change_requested(const MeetingMindJson::ObjectView &data);
+void handle_latency_report_requested(const MeetingMindJson::ObjectView &data);
+
+using Handler = void (*)(const MeetingMindJson::ObjectView &data);
+
+// Event name -> handler, resolved at compile time
+inline constexpr auto registry = MeetingMindDispatch::make_perfect_hash_map<Handler>({
+    {"meeting_started", &handle_meeting_started},
+    {"meeting_ended", &handle_meeting_ended},
+    {"participant_joined", &handle_participant_joined},
+    {"participant_left", &handle_participant_left},
+    {"screen_share_started", &handle_screen_share_started},
+    {"screen_share_ended", &handle_screen_share_ended},
+    {"presentation_started", &handle_presentation_started},
+    {"presentation_ended", &handle_presentation_ended},
+    {"break_started", &handle_break_started},
+    {"break_ended", &handle_break_ended},
+    {"recording_requested", &handle_recording_requested},
+    {"recording_stopped", &handle_recording_stopped},
+    {"streaming_requested", &handle_streaming_requested},
+    {"streaming_stopped", &handle_streaming_stopped},
+    {"audio_mute_requested", &handle_audio_mute_requested},
+    {"audio_unmute_requested", &handle_audio_unmute_requested},
+    {"scene_change_requested", &handle_scene_change_requested},
+    {"latency_report_requested", &handle_latency_report_requested},
+});
+
+} // namespace MeetingMindEvents
@@ -7,7 +7,6 @@ Provides automatic scene switching, audio management, and meeting-aware features
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include <obs.hpp>
-#include <util/config-file.h>
 #include <util/platform.h>
 #include <QApplication>
 #include <QMainWindow>
@@ -20,17 +19,49 @@ Provides automatic scene switching, audio management, and meeting-aware features
 #include <QSpinBox>
 #include <QCheckBox>
 #include <QComboBox>
+#include <QGridLayout>
 #include <QGroupBox>
-#include <QTextEdit>
+#include <QListView>
+#include <QScrollBar>
 #include <QTimer>
+#include <QDateTime>
+#include <QDir>
+#include <QRandomGenerator>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
-#include <QWebSocket>
+#include <QThread>
+#include <QStringList>
 #include <QUrl>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "action-coalescer.hpp"
+#include "action-executor.hpp"
+#include "activity-log-model.hpp"
+#include "audio-meter.hpp"
+#include "audio-stream.hpp"
+#include "audio-tap.hpp"
+#include "auto-director.hpp"
+#include "config-snapshot.hpp"
+#include "config-writer.hpp"
+#include "latency-histogram.hpp"
+#include "meeting-handlers.hpp"
+#include "network-worker.hpp"
+#include "plugin-config.hpp"
+#include "recording-index.hpp"
+#include "remote-audio.hpp"
+#include "slide-watch.hpp"
+#include "source-cache.hpp"
+#include "spsc-queue.hpp"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE("meetingmind-plugin", "en-US")
@@ -40,51 +71,96 @@ MODULE_EXPORT const char *obs_module_description(void)
     return "MeetingMind Integration Plugin";
 }
 
-// Plugin configuration structure
-struct meetingmind_config {
-    char *server_url;
-    int server_port;
-    char *api_key;
-    bool auto_scene_switching;
-    bool auto_recording;
-    bool audio_management;
-    bool meeting_notifications;
-    int connection_timeout;
-    char *meeting_id;
-    bool connected;
-};
-
 // Global plugin instance
 static meetingmind_config *plugin_config = nullptr;
-static QWebSocket *websocket = nullptr;
-static QNetworkAccessManager *network_manager = nullptr;
+static QThread *network_thread = nullptr;
+static MeetingMindNetworkWorker *network_worker = nullptr;
+static QString trace_path; // Empty while no event trace is being recorded
 static QTimer *status_timer = nullptr;
+static QTimer *coalesce_timer = nullptr;
+static QTimer *director_timer = nullptr;
+static QTimer *voice_timer = nullptr;
+
+// Reconnect backoff: the delay doubles per attempt up to the cap, with the
+// upper half randomised so that plugins dropped together do not return in
+// lockstep
+static const int RECONNECT_BASE_DELAY_MS = 1000;
+static const int RECONNECT_MAX_DELAY_MS = 30000;
+static const int MAX_RECONNECT_ATTEMPTS = 12;
+
+// Settings are written once edits have paused for this long
+static const int CONFIG_SAVE_QUIET_MS = 500;
+
+// The log view picks up new lines at most this often
+static const int LOG_REFRESH_INTERVAL_MS = 100;
 
-// Scene mapping for different meeting states
-static const char *SCENE_WELCOME = "Meeting - Welcome";
-static const char *SCENE_PRESENTATION = "Meeting - Presentation";
-static const char *SCENE_DISCUSSION = "Meeting - Discussion";
-static const char *SCENE_SCREEN_SHARE = "Meeting - Screen Share";
-static const char *SCENE_BREAK = "Meeting - Break";
-static const char *SCENE_ENDING = "Meeting - Ending";
+// Scene and audio source names the meeting events switch between
+using MeetingMindEvents::SCENE_DISCUSSION;
+using MeetingMindEvents::SCENE_PRESENTATION;
+using MeetingMindEvents::AUDIO_DESKTOP;
+using MeetingMindEvents::AUDIO_MEETING;
+using MeetingMindEvents::AUDIO_MICROPHONE;
 
-// Audio source names
-static const char *AUDIO_MICROPHONE = "Microphone";
-static const char *AUDIO_DESKTOP = "Desktop Audio";
-static const char *AUDIO_MEETING = "Meeting Audio";
+// Sources metered by the audio taps. Levels are published once per window;
+// the dock shows every window and the backend gets every fifth.
+static const char *const AUDIO_TAP_SOURCES[] = {AUDIO_MICROPHONE, AUDIO_DESKTOP, AUDIO_MEETING};
+static const int METER_WINDOW_MS = 100;
+static const int METER_REPORT_EVERY = 5;
+
+// Auto-director: the camera shot for each speaker's audio source, parsed
+// from the Speaker Cameras setting, and the director choosing among them
+static MeetingMindDirector::CameraMap camera_map;
+static MeetingMindDirector::Director director;
+
+// Voice changes wait here for the UI thread, one queue per tap since each
+// tap is fed from its own audio thread. The UI polls them rather than
+// being woken, which would allocate on the audio thread.
+struct VoiceChange {
+    uint32_t generation = 0;
+    bool active = false;
+    uint64_t detected_ns = 0;
+};
+static SpscQueue<VoiceChange, 32> voice_changes[MeetingMindAudio::MAX_TAPS];
+static const int VOICE_POLL_INTERVAL_MS = 10;
+
+// Index of the meeting events in the running recording; closed while not
+// recording
+static MeetingMindIndex::IndexWriter recording_index;
+
+// Opus at this rate keeps 16 kHz speech intelligible for transcription at
+// about 1/10 of the PCM bandwidth
+static const int AUDIO_STREAM_BITRATE_KBPS = 24;
 
 // Forward declarations
 class MeetingMindWidget;
 static void load_config();
 static void save_config();
-static void connect_to_server();
+static const MeetingMindConfig::ConfigSnapshot &settings();
+static void update_config_string(char *&field, const QString &text);
+static void connect_to_server(bool resuming);
 static void disconnect_from_server();
-static void handle_meeting_event(const QString &event_type, const QJsonObject &data);
+static QString update_trace_recording();
+static QString update_audio_stream();
+static QString update_director();
+static void on_director_timer();
+static void drain_voice_changes();
+static QString update_slide_watch();
+static QString update_recording_index(bool starting);
+static void mark_recording(const char *type, const char *chapter, const QByteArray &message, uint64_t event_ns,
+                           uint32_t flags);
+static QByteArray encode_obs_message(const char *type, const QJsonObject &data);
+static void send_obs_message(const char *type, const QJsonObject &data);
+static void handle_meeting_event(const MeetingEvent &event, uint64_t dispatched_ns);
 static void switch_to_scene(const char *scene_name);
 static void set_source_visibility(const char *source_name, bool visible);
 static void set_source_mute(const char *source_name, bool muted);
-static void start_recording();
-static void stop_recording();
+static void flush_coalesced_actions();
+static void run_output_action(void (*action)());
+static void push_obs_state_snapshot();
+static void send_latency_report(bool reset);
+static QString audio_levels_summary(QString *details);
+static void send_audio_levels();
+static QString latency_summary(QString *details);
 
 // Main plugin widget class
 class MeetingMindWidget : public QWidget
@@ -95,6 +171,8 @@ public:
     explicit MeetingMindWidget(QWidget *parent = nullptr);
     ~MeetingMindWidget();
 
+    void update_output_status();
+
 private slots:
     void on_connect_clicked();
     void on_disconnect_clicked();
@@ -102,13 +180,21 @@ private slots:
     void on_test_connection_clicked();
     void on_websocket_connected();
     void on_websocket_disconnected();
-    void on_websocket_message(const QString &message);
+    void on_events_ready();
+    void on_subscribed(const QString &encoding, const QString &session_id, bool resumed);
+    void on_health_checked(bool healthy, const QString &message);
     void on_status_update();
+    void on_log_refresh();
+    void on_meter_update();
 
 private:
     void setup_ui();
     void update_connection_status();
     void log_message(const QString &message);
+    void schedule_reconnect();
+
+    // True when the next subscribe will ask to resume the last session
+    bool resuming_session() const;
 
     // UI Elements
     QVBoxLayout *main_layout;
@@ -124,8 +210,20 @@ private:
 
     QCheckBox *auto_scene_switching_check;
     QCheckBox *auto_recording_check;
+    QCheckBox *recording_markers_check;
+    QCheckBox *auto_start_streaming_check;
+    QCheckBox *auto_stop_streaming_check;
     QCheckBox *audio_management_check;
     QCheckBox *meeting_notifications_check;
+    QCheckBox *binary_protocol_check;
+    QCheckBox *record_trace_check;
+    QCheckBox *voice_switching_check;
+    QLineEdit *director_map_edit;
+    QCheckBox *audio_streaming_check;
+    QComboBox *audio_stream_source_combo;
+    QCheckBox *slide_detection_check;
+    QComboBox *slide_source_combo;
+    QSpinBox *coalesce_window_spin;
 
     QPushButton *connect_button;
     QPushButton *disconnect_button;
@@ -134,12 +232,40 @@ private:
     QLabel *connection_status_label;
     QLabel *meeting_status_label;
     QLabel *recording_status_label;
+    QLabel *source_cache_label;
+    QLabel *actions_label;
+    QLabel *latency_label;
+    QLabel *audio_levels_label;
+
+    QListView *log_view;
+    MeetingMindActivityLogModel *log_model;
+    QTimer *log_refresh_timer;
+    QTimer *meter_timer;
+    int meter_ticks;
+
+    // Reconnection
+    QTimer *reconnect_timer;
+    bool auto_reconnect_enabled;
+    int reconnect_attempts;
+    int max_reconnect_attempts;
 
-    QTextEdit *log_text;
+    // Session to resume after a dropped connection, and the meeting it
+    // belongs to
+    QString session_id;
+    QString session_meeting_id;
+
+    // Set while the form is being filled from the loaded settings
+    bool loading_config;
 };
 
 MeetingMindWidget::MeetingMindWidget(QWidget *parent)
-    : QWidget(parent)
+    : QWidget(parent),
+      reconnect_timer(nullptr),
+      auto_reconnect_enabled(false),
+      reconnect_attempts(0),
+      max_reconnect_attempts(MAX_RECONNECT_ATTEMPTS),
+      meter_ticks(0),
+      loading_config(false)
 {
     setWindowTitle("MeetingMind Integration");
     setMinimumSize(500, 600);
@@ -149,8 +275,10 @@ MeetingMindWidget::MeetingMindWidget(QWidget *parent)
     // Load configuration
     load_config();
     
-    // Update UI with loaded config
+    // Update UI with loaded config. on_config_changed would otherwise
+    // save a half-populated form back over the settings after each field.
     if (plugin_config) {
+        loading_config = true;
         server_url_edit->setText(plugin_config->server_url ? plugin_config->server_url : "localhost");
         server_port_spin->setValue(plugin_config->server_port);
         api_key_edit->setText(plugin_config->api_key ? plugin_config->api_key : "");
@@ -158,8 +286,26 @@ MeetingMindWidget::MeetingMindWidget(QWidget *parent)
         
         auto_scene_switching_check->setChecked(plugin_config->auto_scene_switching);
         auto_recording_check->setChecked(plugin_config->auto_recording);
+        recording_markers_check->setChecked(plugin_config->recording_markers);
+        auto_start_streaming_check->setChecked(plugin_config->auto_start_streaming);
+        auto_stop_streaming_check->setChecked(plugin_config->auto_stop_streaming);
         audio_management_check->setChecked(plugin_config->audio_management);
         meeting_notifications_check->setChecked(plugin_config->meeting_notifications);
+        voice_switching_check->setChecked(plugin_config->voice_switching);
+        director_map_edit->setText(plugin_config->director_map ? plugin_config->director_map : "");
+        audio_streaming_check->setChecked(plugin_config->audio_streaming);
+        audio_stream_source_combo->setCurrentText(plugin_config->audio_stream_source ? plugin_config->audio_stream_source : "");
+        slide_detection_check->setChecked(plugin_config->slide_detection);
+        slide_source_combo->setCurrentText(plugin_config->slide_source ? plugin_config->slide_source : "");
+        binary_protocol_check->setChecked(plugin_config->binary_protocol);
+        record_trace_check->setChecked(plugin_config->record_trace);
+        coalesce_window_spin->setValue(plugin_config->coalesce_window_ms);
+        loading_config = false;
+        
+        const QString started_trace = update_trace_recording();
+        if (!started_trace.isEmpty()) {
+            log_message(QString("Recording event trace to %1").arg(started_trace));
+        }
     }
     
     // Setup status timer
@@ -167,16 +313,57 @@ MeetingMindWidget::MeetingMindWidget(QWidget *parent)
     connect(status_timer, &QTimer::timeout, this, &MeetingMindWidget::on_status_update);
     status_timer->start(5000); // Update every 5 seconds
     
+    // Fires once a burst of scene/audio requests has gone quiet
+    coalesce_timer = new QTimer(this);
+    coalesce_timer->setSingleShot(true);
+    connect(coalesce_timer, &QTimer::timeout, this, [] { flush_coalesced_actions(); });
+    
+    // Wakes the auto-director for cuts that fall due between voice changes
+    director_timer = new QTimer(this);
+    director_timer->setSingleShot(true);
+    director_timer->setTimerType(Qt::PreciseTimer);
+    connect(director_timer, &QTimer::timeout, this, [] { on_director_timer(); });
+    
+    voice_timer = new QTimer(this);
+    voice_timer->setTimerType(Qt::PreciseTimer);
+    connect(voice_timer, &QTimer::timeout, this, [] { drain_voice_changes(); });
+    voice_timer->start(VOICE_POLL_INTERVAL_MS);
+    
+    reconnect_timer = new QTimer(this);
+    reconnect_timer->setSingleShot(true);
+    connect(reconnect_timer, &QTimer::timeout, this, [this] { connect_to_server(resuming_session()); });
+    
+    log_refresh_timer = new QTimer(this);
+    connect(log_refresh_timer, &QTimer::timeout, this, &MeetingMindWidget::on_log_refresh);
+    log_refresh_timer->start(LOG_REFRESH_INTERVAL_MS);
+    
+    meter_timer = new QTimer(this);
+    connect(meter_timer, &QTimer::timeout, this, &MeetingMindWidget::on_meter_update);
+    meter_timer->start(METER_WINDOW_MS);
+    
+    // Network events arrive from the worker thread as queued signals
+    if (network_worker) {
+        connect(network_worker, &MeetingMindNetworkWorker::connected, this, &MeetingMindWidget::on_websocket_connected);
+        connect(network_worker, &MeetingMindNetworkWorker::disconnected, this, &MeetingMindWidget::on_websocket_disconnected);
+        connect(network_worker, &MeetingMindNetworkWorker::events_ready, this, &MeetingMindWidget::on_events_ready);
+        connect(network_worker, &MeetingMindNetworkWorker::subscribed, this, &MeetingMindWidget::on_subscribed);
+        connect(network_worker, &MeetingMindNetworkWorker::health_checked, this, &MeetingMindWidget::on_health_checked);
+    }
+    
     update_connection_status();
 }
 
 MeetingMindWidget::~MeetingMindWidget()
 {
-    if (websocket) {
-        websocket->close();
-        delete websocket;
-        websocket = nullptr;
+    if (network_worker) {
+        network_worker->disconnect(this);
     }
+    
+    // The timers are children of this widget
+    status_timer = nullptr;
+    coalesce_timer = nullptr;
+    director_timer = nullptr;
+    voice_timer = nullptr;
 }
 
 void MeetingMindWidget::setup_ui()
@@ -223,13 +410,72 @@ void MeetingMindWidget::setup_ui()
     
     auto_scene_switching_check = new QCheckBox("Automatic Scene Switching");
     auto_recording_check = new QCheckBox("Automatic Recording Control");
+    auto_start_streaming_check = new QCheckBox("Start Streaming When Requested");
+    auto_start_streaming_check->setToolTip("Lets the server start the live stream, which goes out publicly.");
+    auto_stop_streaming_check = new QCheckBox("Stop Streaming When Requested");
+    auto_stop_streaming_check->setToolTip("Lets the server stop the live stream.");
+    recording_markers_check = new QCheckBox("Mark Meeting Events in Recordings");
+    recording_markers_check->setToolTip("Adds a chapter for each meeting event where the recording format supports "
+                                        "them, and writes an event index next to each recording. Takes effect from "
+                                        "the next recording.");
     audio_management_check = new QCheckBox("Audio Source Management");
     meeting_notifications_check = new QCheckBox("Meeting Status Notifications");
+    voice_switching_check = new QCheckBox("Switch to Speaker Camera on Voice");
+    voice_switching_check->setToolTip("Detects speech on the speakers' audio sources and cuts to their cameras without waiting for the server.");
+    binary_protocol_check = new QCheckBox("Binary Event Protocol (MessagePack)");
+    record_trace_check = new QCheckBox("Record Event Trace");
+    record_trace_check->setToolTip("Writes every frame received from the server to a trace file in the plugin's traces folder, for offline replay.");
     
     settings_layout->addWidget(auto_scene_switching_check);
     settings_layout->addWidget(auto_recording_check);
+    settings_layout->addWidget(recording_markers_check);
+    settings_layout->addWidget(auto_start_streaming_check);
+    settings_layout->addWidget(auto_stop_streaming_check);
     settings_layout->addWidget(audio_management_check);
     settings_layout->addWidget(meeting_notifications_check);
+    settings_layout->addWidget(voice_switching_check);
+    
+    QHBoxLayout *director_layout = new QHBoxLayout();
+    director_layout->addWidget(new QLabel("Speaker Cameras:"));
+    director_map_edit = new QLineEdit();
+    director_map_edit->setToolTip("Audio Source=Scene or Audio Source=Scene>Camera Source, separated by ';'. "
+                                  "Camera sources of a scene are shown one at a time. *=Scene names a wide shot "
+                                  "for crosstalk and long silences.");
+    director_layout->addWidget(director_map_edit);
+    settings_layout->addLayout(director_layout);
+    
+    QHBoxLayout *stream_layout = new QHBoxLayout();
+    audio_streaming_check = new QCheckBox("Stream Audio to Server:");
+    audio_streaming_check->setToolTip("While connected, sends the chosen source to the server as 16 kHz mono Opus for transcription.");
+    audio_stream_source_combo = new QComboBox();
+    audio_stream_source_combo->setEditable(true);
+    audio_stream_source_combo->addItems({AUDIO_MEETING, AUDIO_MICROPHONE, AUDIO_DESKTOP});
+    stream_layout->addWidget(audio_streaming_check);
+    stream_layout->addWidget(audio_stream_source_combo);
+    settings_layout->addLayout(stream_layout);
+    
+    QHBoxLayout *slide_layout = new QHBoxLayout();
+    slide_detection_check = new QCheckBox("Detect Slides in:");
+    slide_detection_check->setToolTip("Watches the chosen video source for new slides, switching to the presentation scene "
+                                      "when slides start and reporting each slide to the server.");
+    slide_source_combo = new QComboBox();
+    slide_source_combo->setEditable(true);
+    slide_source_combo->addItems({"Presentation", "Screen Share", "Display Capture", "Window Capture"});
+    slide_layout->addWidget(slide_detection_check);
+    slide_layout->addWidget(slide_source_combo);
+    settings_layout->addLayout(slide_layout);
+    
+    settings_layout->addWidget(binary_protocol_check);
+    settings_layout->addWidget(record_trace_check);
+    
+    QHBoxLayout *coalesce_layout = new QHBoxLayout();
+    coalesce_layout->addWidget(new QLabel("Event Coalescing Window (ms):"));
+    coalesce_window_spin = new QSpinBox();
+    coalesce_window_spin->setRange(0, 2000);
+    coalesce_window_spin->setSingleStep(50);
+    coalesce_window_spin->setToolTip("Scene and audio changes arriving within this window are collapsed into one. 0 applies them immediately.");
+    coalesce_layout->addWidget(coalesce_window_spin);
+    settings_layout->addLayout(coalesce_layout);
     
     // Status group
     status_group = new QGroupBox("Status");
@@ -247,14 +493,35 @@ void MeetingMindWidget::setup_ui()
     recording_status_label = new QLabel("Not recording");
     status_layout->addWidget(recording_status_label, 2, 1);
     
+    status_layout->addWidget(new QLabel("Source Cache:"), 3, 0);
+    source_cache_label = new QLabel("No lookups");
+    status_layout->addWidget(source_cache_label, 3, 1);
+    
+    status_layout->addWidget(new QLabel("Actions:"), 4, 0);
+    actions_label = new QLabel("None applied");
+    status_layout->addWidget(actions_label, 4, 1);
+    
+    status_layout->addWidget(new QLabel("Latency:"), 5, 0);
+    latency_label = new QLabel("No events");
+    status_layout->addWidget(latency_label, 5, 1);
+    
+    status_layout->addWidget(new QLabel("Audio:"), 6, 0);
+    audio_levels_label = new QLabel("No audio");
+    status_layout->addWidget(audio_levels_label, 6, 1);
+    
     // Logs group
     logs_group = new QGroupBox("Activity Log");
     QVBoxLayout *logs_layout = new QVBoxLayout(logs_group);
     
-    log_text = new QTextEdit();
-    log_text->setMaximumHeight(150);
-    log_text->setReadOnly(true);
-    logs_layout->addWidget(log_text);
+    // Uniform row heights let the view lay out only the visible rows
+    log_model = new MeetingMindActivityLogModel(this);
+    log_view = new QListView();
+    log_view->setModel(log_model);
+    log_view->setUniformItemSizes(true);
+    log_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    log_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    log_view->setMaximumHeight(150);
+    logs_layout->addWidget(log_view);
     
     // Add all groups to main layout
     main_layout->addWidget(connection_group);
@@ -274,80 +541,115 @@ void MeetingMindWidget::setup_ui()
     
     connect(auto_scene_switching_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
     connect(auto_recording_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(recording_markers_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(auto_start_streaming_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(auto_stop_streaming_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
     connect(audio_management_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
     connect(meeting_notifications_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(voice_switching_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(director_map_edit, &QLineEdit::editingFinished, this, &MeetingMindWidget::on_config_changed);
+    connect(audio_streaming_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(audio_stream_source_combo, &QComboBox::activated, this, &MeetingMindWidget::on_config_changed);
+    connect(audio_stream_source_combo->lineEdit(), &QLineEdit::editingFinished, this,
+            &MeetingMindWidget::on_config_changed);
+    connect(slide_detection_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(slide_source_combo, &QComboBox::activated, this, &MeetingMindWidget::on_config_changed);
+    connect(slide_source_combo->lineEdit(), &QLineEdit::editingFinished, this, &MeetingMindWidget::on_config_changed);
+    connect(binary_protocol_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(record_trace_check, &QCheckBox::toggled, this, &MeetingMindWidget::on_config_changed);
+    connect(coalesce_window_spin, QOverload<int>::of(&QSpinBox::valueChanged), this, &MeetingMindWidget::on_config_changed);
 }
 
 void MeetingMindWidget::on_connect_clicked()
 {
-    connect_to_server();
+    auto_reconnect_enabled = true;
+    reconnect_attempts = 0;
+    reconnect_timer->stop();
+    connect_to_server(resuming_session());
 }
 
 void MeetingMindWidget::on_disconnect_clicked()
 {
+    // A deliberate disconnect ends the session; the next connect starts fresh
+    auto_reconnect_enabled = false;
+    reconnect_timer->stop();
+    session_id.clear();
     disconnect_from_server();
+    update_connection_status();
 }
 
 void MeetingMindWidget::on_config_changed()
 {
-    if (!plugin_config) return;
-    
-    // Update configuration
-    if (plugin_config->server_url) bfree(plugin_config->server_url);
-    plugin_config->server_url = bstrdup(server_url_edit->text().toUtf8().constData());
+    if (!plugin_config || loading_config) return;
     
+    // Update configuration. Strings are only reallocated when they changed.
+    update_config_string(plugin_config->server_url, server_url_edit->text());
     plugin_config->server_port = server_port_spin->value();
-    
-    if (plugin_config->api_key) bfree(plugin_config->api_key);
-    plugin_config->api_key = bstrdup(api_key_edit->text().toUtf8().constData());
-    
-    if (plugin_config->meeting_id) bfree(plugin_config->meeting_id);
-    plugin_config->meeting_id = bstrdup(meeting_id_edit->text().toUtf8().constData());
+    update_config_string(plugin_config->api_key, api_key_edit->text());
+    update_config_string(plugin_config->meeting_id, meeting_id_edit->text());
     
     plugin_config->auto_scene_switching = auto_scene_switching_check->isChecked();
     plugin_config->auto_recording = auto_recording_check->isChecked();
+    plugin_config->recording_markers = recording_markers_check->isChecked();
+    plugin_config->auto_start_streaming = auto_start_streaming_check->isChecked();
+    plugin_config->auto_stop_streaming = auto_stop_streaming_check->isChecked();
     plugin_config->audio_management = audio_management_check->isChecked();
     plugin_config->meeting_notifications = meeting_notifications_check->isChecked();
-    
+    plugin_config->voice_switching = voice_switching_check->isChecked();
+    update_config_string(plugin_config->director_map, director_map_edit->text());
+    plugin_config->audio_streaming = audio_streaming_check->isChecked();
+    update_config_string(plugin_config->audio_stream_source, audio_stream_source_combo->currentText());
+    plugin_config->slide_detection = slide_detection_check->isChecked();
+    update_config_string(plugin_config->slide_source, slide_source_combo->currentText());
+    plugin_config->binary_protocol = binary_protocol_check->isChecked();
+    plugin_config->record_trace = record_trace_check->isChecked();
+    plugin_config->coalesce_window_ms = coalesce_window_spin->value();
+    
+    MeetingMindConfig::publish_snapshot(plugin_config);
     save_config();
+    
+    const QString started_trace = update_trace_recording();
+    if (!started_trace.isEmpty()) {
+        log_message(QString("Recording event trace to %1").arg(started_trace));
+    }
+    
+    const QString stream_change = update_audio_stream();
+    if (!stream_change.isEmpty()) {
+        log_message(stream_change);
+    }
+    
+    const QString director_change = update_director();
+    if (!director_change.isEmpty()) {
+        log_message(director_change);
+    }
+    
+    const QString slide_change = update_slide_watch();
+    if (!slide_change.isEmpty()) {
+        log_message(slide_change);
+    }
+    
+    const QString index_change = update_recording_index(false);
+    if (!index_change.isEmpty()) {
+        log_message(index_change);
+    }
 }
 
 void MeetingMindWidget::on_test_connection_clicked()
 {
     log_message("Testing connection to MeetingMind server...");
     
-    if (!network_manager) {
-        network_manager = new QNetworkAccessManager(this);
-    }
+    if (!network_worker) return;
     
     QString url = QString("http://%1:%2/api/health")
                   .arg(server_url_edit->text())
                   .arg(server_port_spin->value());
     
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    
-    if (!api_key_edit->text().isEmpty()) {
-        request.setRawHeader("Authorization", QString("Bearer %1").arg(api_key_edit->text()).toUtf8());
-    }
-    
-    QNetworkReply *reply = network_manager->get(request);
-    
-    connect(reply, &QNetworkReply::finished, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-            QJsonObject obj = doc.object();
-            
-            if (obj["status"].toString() == "healthy") {
-                log_message("✓ Connection test successful!");
-            } else {
-                log_message("⚠ Server responded but reported unhealthy status");
-            }
-        } else {
-            log_message(QString("✗ Connection test failed: %1").arg(reply->errorString()));
-        }
-        reply->deleteLater();
-    });
+    network_worker->check_health_async(QUrl(url), api_key_edit->text().toUtf8());
+}
+
+void MeetingMindWidget::on_health_checked(bool, const QString &message)
+{
+    log_message(message);
 }
 
 void MeetingMindWidget::on_websocket_connected()
@@ -356,7 +658,12 @@ void MeetingMindWidget::on_websocket_connected()
         plugin_config->connected = true;
     }
     
-    log_message("✓ Connected to MeetingMind WebSocket");
+    if (reconnect_attempts > 0) {
+        log_message(QString("✓ Reconnected to MeetingMind WebSocket after %1 attempt(s)").arg(reconnect_attempts));
+    } else {
+        log_message("✓ Connected to MeetingMind WebSocket");
+    }
+    reconnect_attempts = 0;
     update_connection_status();
     
     // Subscribe to meeting events
@@ -365,10 +672,38 @@ void MeetingMindWidget::on_websocket_connected()
         subscribe_msg["type"] = "subscribe";
         subscribe_msg["meeting_id"] = meeting_id_edit->text();
         
+        // Resume the previous session so the backend replays only the
+        // events after the last one we saw
+        const bool resuming = resuming_session();
+        if (resuming) {
+            subscribe_msg["session_id"] = session_id;
+            subscribe_msg["last_seq"] = (qint64)network_worker->last_sequence();
+        }
+        
+        // Offer binary framing; the backend picks one and acknowledges with
+        // a "subscribed" message. Without an acknowledgement we stay on JSON.
+        if (plugin_config && plugin_config->binary_protocol) {
+            subscribe_msg["encodings"] = QJsonArray({"msgpack", "json"});
+        }
+        
         QJsonDocument doc(subscribe_msg);
-        websocket->sendTextMessage(doc.toJson());
+        network_worker->send_text_async(doc.toJson(QJsonDocument::Compact));
+        
+        if (resuming) {
+            log_message(QString("Resuming meeting %1 after event %2")
+                        .arg(meeting_id_edit->text())
+                        .arg(network_worker->last_sequence()));
+        } else {
+            log_message(QString("Subscribed to meeting: %1").arg(meeting_id_edit->text()));
+        }
         
-        log_message(QString("Subscribed to meeting: %1").arg(meeting_id_edit->text()));
+        // From here on the backend learns about OBS changes as they happen
+        push_obs_state_snapshot();
+    }
+    
+    const QString stream_change = update_audio_stream();
+    if (!stream_change.isEmpty()) {
+        log_message(stream_change);
     }
 }
 
@@ -380,32 +715,139 @@ void MeetingMindWidget::on_websocket_disconnected()
     
     log_message("✗ Disconnected from MeetingMind WebSocket");
     update_connection_status();
+    
+    const QString stream_change = update_audio_stream();
+    if (!stream_change.isEmpty()) {
+        log_message(stream_change);
+    }
+    
+    if (auto_reconnect_enabled) {
+        schedule_reconnect();
+    }
 }
 
-void MeetingMindWidget::on_websocket_message(const QString &message)
+void MeetingMindWidget::schedule_reconnect()
 {
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    QJsonObject obj = doc.object();
+    if (reconnect_timer->isActive()) return;
     
-    QString event_type = obj["type"].toString();
-    QJsonObject event_data = obj["data"].toObject();
+    if (reconnect_attempts >= max_reconnect_attempts) {
+        auto_reconnect_enabled = false;
+        log_message(QString("✗ Giving up after %1 reconnect attempts").arg(reconnect_attempts));
+        update_connection_status();
+        return;
+    }
     
-    log_message(QString("Received event: %1").arg(event_type));
+    const int shift = std::min(reconnect_attempts, 16);
+    const int ceiling = (int)std::min<int64_t>((int64_t)RECONNECT_BASE_DELAY_MS << shift, RECONNECT_MAX_DELAY_MS);
+    const int delay_ms = ceiling / 2 + (int)QRandomGenerator::global()->bounded(ceiling / 2 + 1);
     
-    handle_meeting_event(event_type, event_data);
+    reconnect_attempts++;
+    reconnect_timer->start(delay_ms);
+    
+    log_message(QString("Reconnecting in %1 s (attempt %2 of %3)")
+                .arg(delay_ms / 1000.0, 0, 'f', 1)
+                .arg(reconnect_attempts)
+                .arg(max_reconnect_attempts));
+    update_connection_status();
+}
+
+void MeetingMindWidget::on_events_ready()
+{
+    // Events were parsed and validated on the network thread; only the
+    // dispatch into OBS happens here
+    network_worker->begin_drain();
+    
+    MeetingEvent event;
+    while (network_worker->pop_event(event)) {
+        const uint64_t dispatched_ns = os_gettime_ns();
+        log_message(QString("Received event: %1").arg(QString::fromUtf8(event.type.data(), (int)event.type.size())));
+        
+        handle_meeting_event(event, dispatched_ns);
+    }
+}
+
+void MeetingMindWidget::on_subscribed(const QString &encoding, const QString &new_session_id, bool resumed)
+{
+    if (resumed) {
+        log_message(QString("Session resumed (%1 framing)").arg(encoding));
+    } else {
+        log_message(QString("Subscription confirmed (%1 framing)").arg(encoding));
+    }
+    
+    session_id = new_session_id;
+    session_meeting_id = meeting_id_edit->text();
+}
+
+bool MeetingMindWidget::resuming_session() const
+{
+    return !session_id.isEmpty() && session_meeting_id == meeting_id_edit->text();
+}
+
+void MeetingMindWidget::update_output_status()
+{
+    // Called on output transitions rather than polled
+    const bool recording = obs_frontend_recording_active();
+    const bool streaming = obs_frontend_streaming_active();
+    if (recording && streaming) {
+        recording_status_label->setText("Recording and streaming");
+    } else if (streaming) {
+        recording_status_label->setText("Streaming");
+    } else {
+        recording_status_label->setText(recording ? "Recording" : "Not recording");
+    }
 }
 
 void MeetingMindWidget::on_status_update()
 {
-    // Update recording status
-    bool recording = obs_frontend_recording_active();
-    recording_status_label->setText(recording ? "Recording" : "Not recording");
+    // Source cache effectiveness
+    MeetingMindSourceCache::Stats cache = MeetingMindSourceCache::get_stats();
+    if (cache.lookups > 0) {
+        source_cache_label->setText(QString("%1% hits, %2 µs avg, %3 µs max (%4 lookups)")
+                                    .arg(100.0 * cache.hits / cache.lookups, 0, 'f', 1)
+                                    .arg(cache.total_ns / 1000.0 / cache.lookups, 0, 'f', 2)
+                                    .arg(cache.max_ns / 1000.0, 0, 'f', 2)
+                                    .arg(cache.lookups));
+    }
+    
+    // Calls skipped because OBS was already in the requested state
+    MeetingMindActions::ExecutorStats actions = MeetingMindActions::get_executor_stats();
+    if (actions.applied + actions.skipped > 0) {
+        actions_label->setText(QString("%1 applied, %2 redundant skipped")
+                               .arg(actions.applied)
+                               .arg(actions.skipped));
+    }
+    
+    // End-to-end event latency; per-stage figures in the tooltip
+    QString latency_details;
+    const QString latency = latency_summary(&latency_details);
+    if (!latency.isEmpty()) {
+        latency_label->setText(latency);
+        latency_label->setToolTip(latency_details);
+    }
     
     // Update meeting status (placeholder)
-    if (plugin_config && plugin_config->connected) {
-        meeting_status_label->setText("Connected to meeting");
+    QString meeting_status = plugin_config && plugin_config->connected ? "Connected to meeting" : "No active meeting";
+    
+    // Events lost to a full queue never reached OBS, so they stay visible
+    const uint64_t dropped = network_worker ? network_worker->dropped_events() : 0;
+    if (dropped > 0) {
+        meeting_status += QString(" (%1 events dropped)").arg(dropped);
+        meeting_status_label->setStyleSheet("color: orange;");
     } else {
-        meeting_status_label->setText("No active meeting");
+        meeting_status_label->setStyleSheet("");
+    }
+    meeting_status_label->setText(meeting_status);
+}
+
+void MeetingMindWidget::on_meter_update()
+{
+    QString details;
+    audio_levels_label->setText(audio_levels_summary(&details));
+    audio_levels_label->setToolTip(details);
+    
+    if (++meter_ticks >= METER_REPORT_EVERY) {
+        meter_ticks = 0;
+        send_audio_levels();
     }
 }
 
@@ -416,6 +858,11 @@ void MeetingMindWidget::update_connection_status()
         connection_status_label->setStyleSheet("color: green;");
         connect_button->setEnabled(false);
         disconnect_button->setEnabled(true);
+    } else if (reconnect_timer && reconnect_timer->isActive()) {
+        connection_status_label->setText(QString("Reconnecting (attempt %1)").arg(reconnect_attempts));
+        connection_status_label->setStyleSheet("color: orange;");
+        connect_button->setEnabled(false);
+        disconnect_button->setEnabled(true);
     } else {
         connection_status_label->setText("Disconnected");
         connection_status_label->setStyleSheet("color: red;");
@@ -426,24 +873,19 @@ void MeetingMindWidget::update_connection_status()
 
 void MeetingMindWidget::log_message(const QString &message)
 {
-    QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-    QString log_entry = QString("[%1] %2").arg(timestamp, message);
-    
-    log_text->append(log_entry);
+    const QByteArray text = message.toUtf8();
+    MeetingMindActivityLog::append(text.constData(), (size_t)text.size());
+}
+
+void MeetingMindWidget::on_log_refresh()
+{
+    // Follow new lines only if the user has not scrolled up to read
+    QScrollBar *scroll_bar = log_view->verticalScrollBar();
+    const bool at_bottom = scroll_bar->value() == scroll_bar->maximum();
     
-    // Keep only last 100 lines
-    QTextDocument *doc = log_text->document();
-    if (doc->blockCount() > 100) {
-        QTextCursor cursor(doc);
-        cursor.movePosition(QTextCursor::Start);
-        cursor.movePosition(QTextCursor::Down, QTextCursor::KeepAnchor, doc->blockCount() - 100);
-        cursor.removeSelectedText();
+    if (log_model->refresh() && at_bottom) {
+        log_view->scrollToBottom();
     }
-    
-    // Scroll to bottom
-    QTextCursor cursor = log_text->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    log_text->setTextCursor(cursor);
 }
 
 // Plugin implementation functions
@@ -454,223 +896,996 @@ static void load_config()
         plugin_config = (meetingmind_config*)bzalloc(sizeof(meetingmind_config));
     }
     
-    char *config_path = obs_module_config_path("meetingmind.ini");
-    config_t *config = config_create(config_path);
-    bfree(config_path);
+    MeetingMindConfig::load_config(plugin_config);
+    MeetingMindConfig::publish_snapshot(plugin_config);
+}
+
+// Settings as seen by event dispatch and the audio and graphics callbacks.
+// plugin_config is the dock's working copy; these only read published
+// snapshots, so they never observe a half-applied edit. Each thread keeps its
+// own reader, since a reader's snapshot may be replaced by its next get().
+static const MeetingMindConfig::ConfigSnapshot &settings()
+{
+    thread_local MeetingMindConfig::SnapshotReader reader;
+    return reader.get();
+}
+
+// Queues the settings for the config writer thread; called on every edit
+static void save_config()
+{
+    if (!plugin_config) return;
     
-    if (config_open(config, CONFIG_OPEN_EXISTING) == CONFIG_SUCCESS) {
-        plugin_config->server_url = bstrdup(config_get_string(config, "connection", "server_url"));
-        plugin_config->server_port = (int)config_get_int(config, "connection", "server_port");
-        plugin_config->api_key = bstrdup(config_get_string(config, "connection", "api_key"));
-        plugin_config->meeting_id = bstrdup(config_get_string(config, "connection", "meeting_id"));
-        
-        plugin_config->auto_scene_switching = config_get_bool(config, "features", "auto_scene_switching");
-        plugin_config->auto_recording = config_get_bool(config, "features", "auto_recording");
-        plugin_config->audio_management = config_get_bool(config, "features", "audio_management");
-        plugin_config->meeting_notifications = config_get_bool(config, "features", "meeting_notifications");
-        
-        plugin_config->connection_timeout = (int)config_get_int(config, "advanced", "connection_timeout");
-    } else {
-        // Set defaults
-        plugin_config->server_url = bstrdup("localhost");
-        plugin_config->server_port = 8080;
-        plugin_config->api_key = bstrdup("");
-        plugin_config->meeting_id = bstrdup("");
-        plugin_config->auto_scene_switching = true;
-        plugin_config->auto_recording = true;
-        plugin_config->audio_management = true;
-        plugin_config->meeting_notifications = true;
-        plugin_config->connection_timeout = 10;
+    MeetingMindConfig::save_config_async(plugin_config);
+}
+
+static void update_config_string(char *&field, const QString &text)
+{
+    const QByteArray value = text.toUtf8();
+    if (field && value == field) return;
+    
+    if (field) bfree(field);
+    field = bstrdup(value.constData());
+}
+
+static void connect_to_server(bool resuming)
+{
+    if (!plugin_config || !network_worker) return;
+    
+    QString url = QString("ws://%1:%2/ws")
+                  .arg(plugin_config->server_url)
+                  .arg(plugin_config->server_port);
+    
+    network_worker->open_async(QUrl(url), QByteArray(plugin_config->api_key ? plugin_config->api_key : ""), resuming);
+}
+
+static void disconnect_from_server()
+{
+    if (network_worker) {
+        network_worker->close_async();
     }
+}
+
+// Starts or stops the worker's trace to match the record_trace setting.
+// Returns the new trace's path when recording has just started.
+static QString update_trace_recording()
+{
+    if (!plugin_config || !network_worker) return QString();
+    if (plugin_config->record_trace == !trace_path.isEmpty()) return QString();
     
-    plugin_config->connected = false;
+    if (!plugin_config->record_trace) {
+        network_worker->stop_trace_async();
+        trace_path.clear();
+        return QString();
+    }
+    
+    char *traces_dir = obs_module_config_path("traces");
+    const QString dir = QString::fromUtf8(traces_dir);
+    bfree(traces_dir);
+    QDir().mkpath(dir);
     
-    config_close(config);
+    trace_path = QString("%1/meetingmind-%2.mmtrace")
+                 .arg(dir, QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+    network_worker->start_trace_async(trace_path);
+    return trace_path;
 }
 
-static void save_config()
+// Encoder thread; the frame is copied before the call returns
+static void on_stream_packet(void *, const uint8_t *frame, size_t size)
 {
-    if (!plugin_config) return;
+    if (network_worker) {
+        network_worker->send_binary_async(QByteArray((const char *)frame, (int)size));
+    }
+}
+
+// Runs the audio stream while connected with streaming enabled, restarting
+// it when the source changes. Returns a line for the activity log when
+// anything changed.
+static QString update_audio_stream()
+{
+    using namespace MeetingMindStream;
+    static QString streamed_source; // Empty while not streaming
+    
+    const MeetingMindConfig::ConfigSnapshot &config = settings();
+    const bool wanted = plugin_config && plugin_config->connected && config.audio_streaming &&
+                        !config.audio_stream_source.empty();
+    const QString source = wanted ? QString::fromStdString(config.audio_stream_source) : QString();
+    if (source == streamed_source) return QString();
+    
+    if (!streamed_source.isEmpty()) {
+        const StreamStats stats = get_stream_stats();
+        stop_stream();
+        
+        QJsonObject data;
+        data["source"] = streamed_source;
+        data["packets"] = (qint64)stats.packets;
+        data["bytes"] = (qint64)stats.bytes;
+        data["dropped_samples"] = (qint64)stats.dropped_samples;
+        data["padded_samples"] = (qint64)stats.padded_samples;
+        send_obs_message("audio_stream_stopped", data);
+        streamed_source.clear();
+        if (!wanted) {
+            return QString("Audio stream stopped after %1 packets (%2 KB)")
+                   .arg(stats.packets)
+                   .arg(stats.bytes / 1024);
+        }
+    }
     
-    char *config_path = obs_module_config_path("meetingmind.ini");
-    config_t *config = config_create(config_path);
-    bfree(config_path);
+    const QByteArray name = source.toUtf8();
+    
+    // Announced first so the backend can set up its decoder before the
+    // first frame arrives
+    QJsonObject data;
+    data["source"] = source;
+    data["codec"] = "opus";
+    data["sample_rate"] = (qint64)SAMPLE_RATE;
+    data["channels"] = (qint64)CHANNELS;
+    data["bitrate_kbps"] = AUDIO_STREAM_BITRATE_KBPS;
+    data["header_bytes"] = (qint64)FRAME_HEADER_SIZE;
+    send_obs_message("audio_stream_started", data);
+    
+    if (!start_stream(name.constData(), AUDIO_STREAM_BITRATE_KBPS, on_stream_packet, nullptr)) {
+        QJsonObject failed;
+        failed["source"] = source;
+        send_obs_message("audio_stream_stopped", failed);
+        return QString("✗ Cannot stream audio from '%1'; see the OBS log").arg(source);
+    }
+    streamed_source = source;
+    return QString("Streaming '%1' to the server as %2 kbps Opus").arg(source).arg(AUDIO_STREAM_BITRATE_KBPS);
+}
+
+// Network worker thread
+
+static void start_network_worker()
+{
+    network_thread = new QThread();
+    network_thread->setObjectName("MeetingMind Network");
+    
+    network_worker = new MeetingMindNetworkWorker();
+    network_worker->set_binary_frame_handler(MeetingMindRemoteAudio::FRAME_MAGIC, MeetingMindRemoteAudio::push_frame);
+    network_worker->moveToThread(network_thread);
     
-    config_set_string(config, "connection", "server_url", plugin_config->server_url);
-    config_set_int(config, "connection", "server_port", plugin_config->server_port);
-    config_set_string(config, "connection", "api_key", plugin_config->api_key);
-    config_set_string(config, "connection", "meeting_id", plugin_config->meeting_id);
+    // The worker and its sockets must be destroyed on their own thread
+    QObject::connect(network_thread, &QThread::finished, network_worker, &QObject::deleteLater);
     
-    config_set_bool(config, "features", "auto_scene_switching", plugin_config->auto_scene_switching);
-    config_set_bool(config, "features", "auto_recording", plugin_config->auto_recording);
-    config_set_bool(config, "features", "audio_management", plugin_config->audio_management);
-    config_set_bool(config, "features", "meeting_notifications", plugin_config->meeting_notifications);
+    network_thread->start();
+}
+
+static void stop_network_worker()
+{
+    if (!network_thread) return;
     
-    config_set_int(config, "advanced", "connection_timeout", plugin_config->connection_timeout);
+    network_thread->quit();
+    network_thread->wait();
+    network_worker = nullptr;
+    trace_path.clear();
     
-    config_save(config);
-    config_close(config);
+    delete network_thread;
+    network_thread = nullptr;
 }
 
-static void connect_to_server()
+// Latency per event type, indexed by registry slot. Everything is recorded on
+// the UI thread from timestamps the network thread stored in the event.
+static MeetingMindLatency::LatencyRecorder event_latency(decltype(MeetingMindEvents::registry)::slot_count);
+
+// Event being handled, so that actions it defers to the coalescer can
+// complete its end-to-end measurement when they are finally applied
+struct PendingLatency {
+    int slot;
+    uint64_t received_ns;
+};
+static PendingLatency handling_event = {-1, 0};
+static bool handling_event_deferred = false;
+static std::vector<PendingLatency> deferred_latency;
+static const size_t MAX_DEFERRED_LATENCY = 256;
+
+// "participant_joined" for Ana reads "Participant joined: Ana"
+static QByteArray chapter_name(std::string_view type, const MeetingMindJson::ObjectView &data)
+{
+    QByteArray name(type.data(), (int)type.size());
+    name.replace('_', ' ');
+    if (!name.isEmpty()) name[0] = (char)toupper((unsigned char)name[0]);
+    
+    char detail[128];
+    if (data.copy_string("name", detail, sizeof(detail)) || data.copy_string("scene", detail, sizeof(detail)) ||
+        data.copy_string("source", detail, sizeof(detail))) {
+        name += ": ";
+        name += detail;
+    }
+    return name;
+}
+
+static void handle_meeting_event(const MeetingEvent &event, uint64_t dispatched_ns)
 {
     if (!plugin_config) return;
     
-    if (websocket) {
-        websocket->close();
-        delete websocket;
+    const int slot = MeetingMindEvents::registry.find_slot(event.type);
+    if (slot < 0) {
+        blog(LOG_DEBUG, "MeetingMind: Ignoring unknown event '%.*s'",
+             (int)event.type.size(), event.type.data());
+        return;
     }
     
-    QString url = QString("ws://%1:%2/ws")
-                  .arg(plugin_config->server_url)
-                  .arg(plugin_config->server_port);
+    handling_event = {slot, event.received_ns};
+    handling_event_deferred = false;
     
-    websocket = new QWebSocket();
+    MeetingMindEvents::registry.entry(slot).value(event.data);
     
-    // Set headers
-    QNetworkRequest request(url);
-    if (plugin_config->api_key && strlen(plugin_config->api_key) > 0) {
-        request.setRawHeader("Authorization", QString("Bearer %1").arg(plugin_config->api_key).toUtf8());
+    const uint64_t done_ns = os_gettime_ns();
+    event_latency.record(slot, MeetingMindLatency::STAGE_PARSE, event.parsed_ns - event.received_ns);
+    event_latency.record(slot, MeetingMindLatency::STAGE_QUEUE, dispatched_ns - event.parsed_ns);
+    event_latency.record(slot, MeetingMindLatency::STAGE_HANDLE, done_ns - dispatched_ns);
+    if (!handling_event_deferred) {
+        event_latency.record(slot, MeetingMindLatency::STAGE_TOTAL, done_ns - event.received_ns);
+    }
+    handling_event.slot = -1;
+    
+    // Latency reports are about the plugin, not the meeting
+    if (settings().recording_markers && obs_frontend_recording_active() &&
+        event.type != "latency_report_requested") {
+        const std::string type(event.type);
+        const QByteArray chapter = chapter_name(event.type, event.data);
+        mark_recording(type.c_str(), chapter.constData(), event.frame, event.received_ns,
+                       event.encoding == MeetingMindJson::Encoding::MessagePack ? MeetingMindIndex::FLAG_MSGPACK : 0);
+    }
+}
+
+// Scene and audio actions. Handlers request a target state; with a non-zero
+// coalescing window the request is held until the burst goes quiet so that
+// only the final state reaches OBS.
+
+static MeetingMindActions::ActionCoalescer action_coalescer;
+static uint64_t coalesce_burst_start_ns = 0;
+
+static bool coalescing_enabled()
+{
+    return coalesce_timer && settings().coalesce_window_ms > 0;
+}
+
+// Debounce: every request restarts the window, but a continuous stream is
+// still flushed at most four windows after its first request
+static void schedule_coalesced_flush()
+{
+    if (handling_event.slot >= 0 && !handling_event_deferred &&
+        deferred_latency.size() < MAX_DEFERRED_LATENCY) {
+        deferred_latency.push_back(handling_event);
+        handling_event_deferred = true;
     }
     
-    websocket->open(request);
+    const uint64_t now = os_gettime_ns();
+    const uint64_t window_ns = (uint64_t)settings().coalesce_window_ms * 1000000;
+    if (!coalesce_timer->isActive()) {
+        coalesce_burst_start_ns = now;
+    }
+    
+    const uint64_t deadline = coalesce_burst_start_ns + 4 * window_ns;
+    const uint64_t delay_ns = deadline > now ? std::min(window_ns, deadline - now) : 0;
+    coalesce_timer->start((int)(delay_ns / 1000000));
 }
 
-static void disconnect_from_server()
+static void flush_coalesced_actions()
 {
-    if (websocket) {
-        websocket->close();
+    if (action_coalescer.empty()) return;
+    
+    static const MeetingMindActions::ActionCoalescer::Callbacks callbacks = {
+        MeetingMindActions::switch_scene,
+        MeetingMindActions::set_mute,
+        MeetingMindActions::set_visibility,
+    };
+    const size_t calls = action_coalescer.flush(callbacks);
+    
+    const uint64_t done_ns = os_gettime_ns();
+    for (const PendingLatency &pending : deferred_latency) {
+        event_latency.record(pending.slot, MeetingMindLatency::STAGE_TOTAL, done_ns - pending.received_ns);
     }
+    deferred_latency.clear();
+    
+    blog(LOG_DEBUG, "MeetingMind: Applied %zu coalesced actions (%llu superseded so far)",
+         calls, (unsigned long long)action_coalescer.coalesced_requests());
 }
 
-static void handle_meeting_event(const QString &event_type, const QJsonObject &data)
+// Outputs start and stop at once, so any scene or mute change requested
+// before them is applied first; otherwise a meeting would start recording
+// on the previous scene, or stop before its closing scene was shown
+static void run_output_action(void (*action)())
 {
-    if (!plugin_config) return;
+    if (coalesce_timer) coalesce_timer->stop();
+    flush_coalesced_actions();
+    action();
+}
+
+static void switch_to_scene(const char *scene_name)
+{
+    if (coalescing_enabled()) {
+        action_coalescer.request_scene(scene_name);
+        schedule_coalesced_flush();
+    } else {
+        MeetingMindActions::switch_scene(scene_name);
+    }
+}
+
+static void set_source_visibility(const char *source_name, bool visible)
+{
+    if (coalescing_enabled()) {
+        action_coalescer.request_visibility(source_name, visible);
+        schedule_coalesced_flush();
+    } else {
+        MeetingMindActions::set_visibility(source_name, visible);
+    }
+}
+
+static void set_source_mute(const char *source_name, bool muted)
+{
+    if (coalescing_enabled()) {
+        action_coalescer.request_mute(source_name, muted);
+        schedule_coalesced_flush();
+    } else {
+        MeetingMindActions::set_mute(source_name, muted);
+    }
+}
+
+// Plugin dock registration
+static MeetingMindWidget *dock_widget = nullptr;
+
+static void register_dock()
+{
+    dock_widget = new MeetingMindWidget();
     
-    if (event_type == "meeting_started") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_WELCOME);
+    obs_frontend_add_dock_by_id("meetingmind_dock", "MeetingMind", dock_widget);
+}
+
+static void unregister_dock()
+{
+    if (dock_widget) {
+        obs_frontend_remove_dock("meetingmind_dock");
+        delete dock_widget;
+        dock_widget = nullptr;
+    }
+}
+
+// OBS state push. Output and scene transitions are sent to the backend as
+// they happen, so it does not have to poll OBS for them.
+
+static const char *frontend_event_name(enum obs_frontend_event event)
+{
+    switch (event) {
+    case OBS_FRONTEND_EVENT_RECORDING_STARTING: return "recording_starting";
+    case OBS_FRONTEND_EVENT_RECORDING_STARTED: return "recording_started";
+    case OBS_FRONTEND_EVENT_RECORDING_STOPPING: return "recording_stopping";
+    case OBS_FRONTEND_EVENT_RECORDING_STOPPED: return "recording_stopped";
+    case OBS_FRONTEND_EVENT_RECORDING_PAUSED: return "recording_paused";
+    case OBS_FRONTEND_EVENT_RECORDING_UNPAUSED: return "recording_unpaused";
+    case OBS_FRONTEND_EVENT_STREAMING_STARTING: return "streaming_starting";
+    case OBS_FRONTEND_EVENT_STREAMING_STARTED: return "streaming_started";
+    case OBS_FRONTEND_EVENT_STREAMING_STOPPING: return "streaming_stopping";
+    case OBS_FRONTEND_EVENT_STREAMING_STOPPED: return "streaming_stopped";
+    case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTING: return "replay_buffer_starting";
+    case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STARTED: return "replay_buffer_started";
+    case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPING: return "replay_buffer_stopping";
+    case OBS_FRONTEND_EVENT_REPLAY_BUFFER_STOPPED: return "replay_buffer_stopped";
+    case OBS_FRONTEND_EVENT_REPLAY_BUFFER_SAVED: return "replay_buffer_saved";
+    case OBS_FRONTEND_EVENT_SCENE_CHANGED: return "scene_changed";
+    default: return nullptr;
+    }
+}
+
+static QString current_scene_name()
+{
+    obs_source_t *scene = obs_frontend_get_current_scene();
+    QString name = scene ? QString::fromUtf8(obs_source_get_name(scene)) : QString();
+    obs_source_release(scene);
+    return name;
+}
+
+static QByteArray encode_obs_message(const char *type, const QJsonObject &data)
+{
+    QJsonObject message;
+    message["type"] = type;
+    message["data"] = data;
+    return QJsonDocument(message).toJson(QJsonDocument::Compact);
+}
+
+static void send_obs_message(const char *type, const QJsonObject &data)
+{
+    if (!network_worker || !plugin_config || !plugin_config->connected) return;
+    
+    network_worker->send_text_async(encode_obs_message(type, data));
+}
+
+static void push_obs_state_snapshot()
+{
+    QJsonObject data;
+    data["recording"] = obs_frontend_recording_active();
+    data["recording_paused"] = obs_frontend_recording_paused();
+    data["streaming"] = obs_frontend_streaming_active();
+    data["replay_buffer"] = obs_frontend_replay_buffer_active();
+    data["scene"] = current_scene_name();
+    data["timestamp_ms"] = QDateTime::currentMSecsSinceEpoch();
+    send_obs_message("obs_state", data);
+}
+
+static void on_frontend_event(enum obs_frontend_event event, void *)
+{
+    QString index_change;
+    switch (event) {
+    case OBS_FRONTEND_EVENT_RECORDING_STARTED:
+        index_change = update_recording_index(true);
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_STOPPED:
+        index_change = update_recording_index(false);
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_PAUSED:
+        recording_index.pause(os_gettime_ns());
+        break;
+    case OBS_FRONTEND_EVENT_RECORDING_UNPAUSED:
+        recording_index.resume(os_gettime_ns());
+        break;
+    default:
+        break;
+    }
+    if (!index_change.isEmpty()) {
+        const QByteArray text = index_change.toUtf8();
+        MeetingMindActivityLog::append(text.constData(), (size_t)text.size());
+    }
+    
+    const char *name = frontend_event_name(event);
+    if (!name) {
+        if (event == OBS_FRONTEND_EVENT_FINISHED_LOADING && dock_widget) {
+            dock_widget->update_output_status();
         }
-        if (plugin_config->auto_recording) {
-            start_recording();
+        return;
+    }
+    
+    QJsonObject data;
+    data["event"] = name;
+    data["timestamp_ms"] = QDateTime::currentMSecsSinceEpoch();
+    if (event == OBS_FRONTEND_EVENT_SCENE_CHANGED) {
+        data["scene"] = current_scene_name();
+    }
+    if (event == OBS_FRONTEND_EVENT_RECORDING_STARTED && recording_index.is_open()) {
+        data["index"] = QString::fromUtf8(recording_index.index_path().c_str());
+    }
+    send_obs_message("obs_event", data);
+    
+    if (dock_widget && event != OBS_FRONTEND_EVENT_SCENE_CHANGED) {
+        dock_widget->update_output_status();
+    }
+}
+
+// Latency reporting
+
+static QString format_latency(uint64_t ns)
+{
+    if (ns < 1000000) {
+        return QString("%1 µs").arg(ns / 1000.0, 0, 'f', 0);
+    }
+    return QString("%1 ms").arg(ns / 1000000.0, 0, 'f', 1);
+}
+
+static QString latency_summary(QString *details)
+{
+    using namespace MeetingMindLatency;
+    
+    const LatencyHistogram &total = event_latency.aggregate(STAGE_TOTAL);
+    if (total.count() == 0) return QString();
+    
+    if (details) {
+        QStringList lines;
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            const LatencyHistogram &histogram = event_latency.aggregate((Stage)stage);
+            lines << QString("%1: p50 %2, p99 %3, max %4")
+                     .arg(stage_name((Stage)stage))
+                     .arg(format_latency(histogram.percentile(0.50)))
+                     .arg(format_latency(histogram.percentile(0.99)))
+                     .arg(format_latency(histogram.max()));
         }
-        if (plugin_config->audio_management) {
-            set_source_mute(AUDIO_MICROPHONE, false);
+        *details = lines.join("\n");
+    }
+    
+    return QString("p50 %1, p99 %2 (%3 events)")
+           .arg(format_latency(total.percentile(0.50)))
+           .arg(format_latency(total.percentile(0.99)))
+           .arg(total.count());
+}
+
+static QJsonObject latency_json(const MeetingMindLatency::LatencyHistogram &histogram)
+{
+    QJsonObject obj;
+    obj["count"] = (qint64)histogram.count();
+    obj["p50_us"] = histogram.percentile(0.50) / 1000.0;
+    obj["p90_us"] = histogram.percentile(0.90) / 1000.0;
+    obj["p99_us"] = histogram.percentile(0.99) / 1000.0;
+    obj["max_us"] = histogram.max() / 1000.0;
+    return obj;
+}
+
+static void send_latency_report(bool reset)
+{
+    using namespace MeetingMindLatency;
+    
+    QJsonObject stages;
+    for (int stage = 0; stage < STAGE_COUNT; stage++) {
+        stages[stage_name((Stage)stage)] = latency_json(event_latency.aggregate((Stage)stage));
+    }
+    
+    QJsonObject events;
+    for (size_t slot = 0; slot < event_latency.type_count(); slot++) {
+        if (!MeetingMindEvents::registry.occupied(slot) || !event_latency.histogram(slot, STAGE_TOTAL)) continue;
+        
+        QJsonObject per_stage;
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            per_stage[stage_name((Stage)stage)] = latency_json(*event_latency.histogram(slot, (Stage)stage));
         }
+        const std::string_view name = MeetingMindEvents::registry.entry(slot).key;
+        events[QString::fromUtf8(name.data(), (int)name.size())] = per_stage;
+    }
+    
+    QJsonObject data;
+    data["stages"] = stages;
+    data["events"] = events;
+    send_obs_message("latency_report", data);
+    
+    if (reset) {
+        event_latency.reset();
     }
-    else if (event_type == "meeting_ended") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_ENDING);
+}
+
+// Audio levels
+
+static QString audio_levels_summary(QString *details)
+{
+    using namespace MeetingMindAudio;
+    
+    QStringList parts;
+    QStringList lines;
+    for (size_t i = 0; i < tap_count(); i++) {
+        const QString name = QString::fromStdString(tap_name(i));
+        SourceLevels levels;
+        if (!tap_attached(i) || !read_levels(i, levels)) {
+            lines << QString("%1: not found").arg(name);
+            continue;
         }
-        if (plugin_config->auto_recording) {
-            stop_recording();
+        
+        // The loudest channel stands for the source
+        float rms_db = SILENCE_DB;
+        uint32_t clipped = 0;
+        for (uint32_t ch = 0; ch < levels.channels; ch++) {
+            rms_db = std::max(rms_db, levels.channel[ch].rms_db);
+            clipped += levels.channel[ch].clipped;
+            lines << QString("%1 ch%2: rms %3 dB, peak %4 dB, %5 clipped")
+                     .arg(name).arg(ch + 1)
+                     .arg(levels.channel[ch].rms_db, 0, 'f', 1)
+                     .arg(levels.channel[ch].peak_db, 0, 'f', 1)
+                     .arg(levels.channel[ch].clipped);
         }
+        parts << QString("%1 %2 dB%3%4%5")
+                 .arg(name)
+                 .arg(rms_db, 0, 'f', 0)
+                 .arg(levels.muted ? " (muted)" : "")
+                 .arg(voice_active(i) ? " (speaking)" : "")
+                 .arg(clipped ? " CLIP" : "");
     }
-    else if (event_type == "presentation_started") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_PRESENTATION);
+    
+    const TapStats stats = get_tap_stats();
+    if (details) {
+        if (stats.elapsed_ns > 0) {
+            lines << QString("Metering cost: %1% of a core")
+                     .arg(100.0 * stats.busy_ns / stats.elapsed_ns, 0, 'f', 3);
         }
+        *details = lines.join("\n");
     }
-    else if (event_type == "screen_share_started") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_SCREEN_SHARE);
-        }
-        if (plugin_config->audio_management) {
-            set_source_mute(AUDIO_DESKTOP, false);
+    return parts.isEmpty() ? QString("No audio") : parts.join(", ");
+}
+
+// Sends the windows completed since the last report
+static void send_audio_levels()
+{
+    using namespace MeetingMindAudio;
+    static uint64_t last_sent_window[MAX_TAPS] = {};
+    
+    QJsonArray sources;
+    for (size_t i = 0; i < tap_count(); i++) {
+        SourceLevels levels;
+        if (!read_levels(i, levels) || levels.window == last_sent_window[i]) continue;
+        last_sent_window[i] = levels.window;
+        
+        QJsonArray rms_db, peak_db, clipped;
+        for (uint32_t ch = 0; ch < levels.channels; ch++) {
+            rms_db.append(std::round(levels.channel[ch].rms_db * 10.0f) / 10.0);
+            peak_db.append(std::round(levels.channel[ch].peak_db * 10.0f) / 10.0);
+            clipped.append((qint64)levels.channel[ch].clipped);
         }
+        QJsonObject source;
+        source["name"] = QString::fromStdString(tap_name(i));
+        source["muted"] = levels.muted;
+        source["rms_db"] = rms_db;
+        source["peak_db"] = peak_db;
+        source["clipped"] = clipped;
+        sources.append(source);
     }
-    else if (event_type == "screen_share_ended") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_DISCUSSION);
-        }
+    if (sources.isEmpty()) return;
+    
+    QJsonObject data;
+    data["window_ms"] = METER_WINDOW_MS;
+    data["sources"] = sources;
+    data["timestamp_ms"] = QDateTime::currentMSecsSinceEpoch();
+    send_obs_message("audio_levels", data);
+}
+
+// Voice activity and the auto-director
+
+using MeetingMindDirector::Shot;
+
+static int camera_for_source(const std::string &source)
+{
+    if (source.empty()) return -1;
+    for (size_t i = 0; i < camera_map.cameras.size(); i++) {
+        if (camera_map.cameras[i].audio_source == source) return (int)i;
     }
-    else if (event_type == "break_started") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_BREAK);
+    return -1;
+}
+
+// Starts the director over, picking up whoever is already talking
+static void restart_director()
+{
+    if (director_timer) director_timer->stop();
+    director.configure(camera_map.cameras.size(), camera_map.has_wide);
+    if (!settings().voice_switching) return;
+    
+    const uint64_t now = os_gettime_ns();
+    for (size_t tap = 0; tap < MeetingMindAudio::tap_count(); tap++) {
+        const int camera = camera_for_source(MeetingMindAudio::tap_name(tap));
+        if (camera >= 0 && MeetingMindAudio::voice_active(tap)) director.voice((size_t)camera, true, now);
+    }
+}
+
+// UI thread. Taps the metered sources and every speaker source in the camera
+// map, and restarts the director when the map or the switch changes.
+// Returns a line for the activity log, or an empty string if nothing
+// changed.
+static QString update_director()
+{
+    static bool started = false;
+    static std::string map_text;
+    static bool enabled = false;
+    
+    const MeetingMindConfig::ConfigSnapshot &config = settings();
+    if (started && config.director_map == map_text && config.voice_switching == enabled) return QString();
+    const bool map_changed = !started || config.director_map != map_text;
+    started = true;
+    map_text = config.director_map;
+    enabled = config.voice_switching;
+    
+    size_t skipped = 0;
+    if (map_changed) {
+        skipped = MeetingMindDirector::parse_camera_map(map_text, camera_map);
+        
+        std::vector<const char *> names(std::begin(AUDIO_TAP_SOURCES), std::end(AUDIO_TAP_SOURCES));
+        for (const Shot &shot : camera_map.cameras) {
+            const bool tapped = std::any_of(names.begin(), names.end(), [&](const char *name) {
+                return shot.audio_source == name;
+            });
+            if (!tapped && names.size() < MeetingMindAudio::MAX_TAPS) names.push_back(shot.audio_source.c_str());
         }
-        if (plugin_config->audio_management) {
-            set_source_mute(AUDIO_MICROPHONE, true);
+        
+        // Retapping drops the sources' voice state, so only when the set of
+        // sources actually changes
+        bool same_taps = names.size() == MeetingMindAudio::tap_count();
+        for (size_t i = 0; same_taps && i < names.size(); i++) {
+            same_taps = MeetingMindAudio::tap_name(i) == names[i];
         }
+        if (!same_taps) MeetingMindAudio::init_taps(names.data(), names.size(), METER_WINDOW_MS);
     }
-    else if (event_type == "break_ended") {
-        if (plugin_config->auto_scene_switching) {
-            switch_to_scene(SCENE_DISCUSSION);
-        }
-        if (plugin_config->audio_management) {
-            set_source_mute(AUDIO_MICROPHONE, false);
+    restart_director();
+    
+    if (!enabled) return map_changed ? QString() : QString("Speaker camera switching off");
+    QString line = QString("Speaker camera switching on: %1 camera(s)").arg(camera_map.cameras.size());
+    if (camera_map.has_wide) line += QString(", wide shot %1").arg(QString::fromUtf8(camera_map.wide.scene.c_str()));
+    if (skipped) line += QString(", %1 entry(ies) skipped").arg(skipped);
+    return line;
+}
+
+static QString describe_shot(const Shot &shot)
+{
+    QString text = QString::fromUtf8(shot.scene.c_str());
+    if (!shot.item.empty()) text += QString(" > %1").arg(QString::fromUtf8(shot.item.c_str()));
+    return text;
+}
+
+// An item shot shows its camera source and hides the other mapped sources
+// of its scene before the cut, so the scene comes up on the right camera
+static void take_shot(const Shot &shot)
+{
+    if (!shot.item.empty()) {
+        for (const Shot &other : camera_map.cameras) {
+            if (other.scene == shot.scene && !other.item.empty() && other.item != shot.item) {
+                action_coalescer.request_visibility(other.item.c_str(), false);
+            }
         }
+        action_coalescer.request_visibility(shot.item.c_str(), true);
     }
+    action_coalescer.request_scene(shot.scene.c_str());
+    
+    // A speaker cut cannot wait out the coalescing window, so it is applied
+    // at once. Going through the coalescer lets it supersede a scene request
+    // still pending, which would otherwise land after the cut and leave the
+    // director's shot off program. The executor skips calls that change
+    // nothing.
+    if (coalesce_timer) coalesce_timer->stop();
+    flush_coalesced_actions();
 }
 
-static void switch_to_scene(const char *scene_name)
+// UI thread. Asks the director for the shot, takes it if it changed and
+// tells the backend. since_ns is the voice change that prompted the call, or
+// 0 from the timer, in which case the delay runs from when the cut fell due.
+// Returns the shot cut to, or nullptr.
+static const Shot *direct_cameras(uint64_t since_ns, uint64_t *delay_ns)
 {
-    obs_source_t *scene = obs_get_source_by_name(scene_name);
-    if (scene) {
-        obs_frontend_set_current_scene(scene);
-        obs_source_release(scene);
-        
-        blog(LOG_INFO, "MeetingMind: Switched to scene '%s'", scene_name);
-    } else {
-        blog(LOG_WARNING, "MeetingMind: Scene '%s' not found", scene_name);
+    const uint64_t now = os_gettime_ns();
+    const MeetingMindDirector::Decision decision = director.decide(now);
+    
+    // The director only moves when asked, so come back for the next cut
+    // that falls due without a voice change
+    if (director_timer) {
+        if (decision.next_ns) {
+            director_timer->start((int)((decision.next_ns - now + 999999) / 1000000));
+        } else {
+            director_timer->stop();
+        }
     }
+    if (!decision.cut) return nullptr;
+    
+    const bool wide = decision.shot == MeetingMindDirector::WIDE_SHOT;
+    const Shot &shot = wide ? camera_map.wide : camera_map.cameras[(size_t)decision.shot];
+    take_shot(shot);
+    *delay_ns = os_gettime_ns() - (since_ns ? since_ns : decision.due_ns);
+    
+    QJsonObject data;
+    data["scene"] = QString::fromUtf8(shot.scene.c_str());
+    if (!shot.item.empty()) data["item"] = QString::fromUtf8(shot.item.c_str());
+    data["shot"] = wide ? "wide" : "speaker";
+    if (!wide) data["source"] = QString::fromUtf8(shot.audio_source.c_str());
+    data["delay_us"] = (qint64)(*delay_ns / 1000);
+    data["timestamp_ms"] = QDateTime::currentMSecsSinceEpoch();
+    send_obs_message("camera_cut", data);
+    mark_recording("camera_cut", nullptr, encode_obs_message("camera_cut", data), os_gettime_ns(),
+                   MeetingMindIndex::FLAG_LOCAL);
+    return &shot;
 }
 
-static void set_source_visibility(const char *source_name, bool visible)
+// A cut that fell due between voice changes: a confirmed speaker, a
+// takeover, or the wide shot after crosstalk or a long silence
+static void on_director_timer()
+{
+    if (!plugin_config || !settings().voice_switching) return;
+    
+    uint64_t delay_ns = 0;
+    const Shot *shot = direct_cameras(0, &delay_ns);
+    if (!shot) return;
+    
+    const QString line = QString("Cut to %1 %2 us after it fell due")
+                         .arg(describe_shot(*shot))
+                         .arg(delay_ns / 1000);
+    const QByteArray text = line.toUtf8();
+    MeetingMindActivityLog::append(text.constData(), (size_t)text.size());
+}
+
+// UI thread. Changes from before the last retap are dropped, as their tap
+// index may now belong to another source.
+static void handle_voice_activity(size_t tap, uint32_t generation, bool active, uint64_t detected_ns)
 {
-    obs_source_t *source = obs_get_source_by_name(source_name);
-    if (source) {
-        obs_source_set_enabled(source, visible);
-        obs_source_release(source);
+    if (!plugin_config || generation != MeetingMindAudio::tap_generation()) return;
+    
+    const std::string source = MeetingMindAudio::tap_name(tap);
+    if (source.empty()) return;
+    
+    const Shot *shot = nullptr;
+    if (settings().voice_switching) {
+        const int camera = camera_for_source(source);
+        if (camera >= 0) director.voice((size_t)camera, active, detected_ns);
         
-        blog(LOG_INFO, "MeetingMind: Set source '%s' visibility to %s", 
-             source_name, visible ? "visible" : "hidden");
+        uint64_t delay_ns = 0;
+        shot = direct_cameras(detected_ns, &delay_ns);
+        if (shot) {
+            const QString line = QString("Voice %1 %2, cut to %3 in %4 us")
+                                 .arg(QString::fromLatin1(active ? "on" : "off"), QString::fromStdString(source),
+                                      describe_shot(*shot))
+                                 .arg(delay_ns / 1000);
+            const QByteArray text = line.toUtf8();
+            MeetingMindActivityLog::append(text.constData(), (size_t)text.size());
+        }
     }
+    
+    QJsonObject data;
+    data["source"] = QString::fromStdString(source);
+    data["active"] = active;
+    if (shot) data["scene"] = QString::fromUtf8(shot->scene.c_str());
+    data["timestamp_ms"] = QDateTime::currentMSecsSinceEpoch();
+    send_obs_message("voice_activity", data);
 }
 
-static void set_source_mute(const char *source_name, bool muted)
+// Audio thread of the tapped source; hands the change to the UI thread
+// without allocating. A change that finds the queue full is dropped, which
+// at a few changes a second takes the UI stalling for several seconds.
+static void on_voice_activity(void *, size_t tap, uint32_t generation, bool active, uint64_t)
 {
-    obs_source_t *source = obs_get_source_by_name(source_name);
-    if (source) {
-        obs_source_set_muted(source, muted);
-        obs_source_release(source);
-        
-        blog(LOG_INFO, "MeetingMind: Set source '%s' mute to %s", 
-             source_name, muted ? "muted" : "unmuted");
+    VoiceChange change;
+    change.generation = generation;
+    change.active = active;
+    change.detected_ns = os_gettime_ns();
+    voice_changes[tap].try_push(std::move(change));
+}
+
+// UI thread, every VOICE_POLL_INTERVAL_MS
+static void drain_voice_changes()
+{
+    VoiceChange change;
+    for (size_t tap = 0; tap < MeetingMindAudio::MAX_TAPS; tap++) {
+        while (voice_changes[tap].try_pop(change)) {
+            handle_voice_activity(tap, change.generation, change.active, change.detected_ns);
+        }
     }
 }
 
-static void start_recording()
+// Slide detection
+
+static const char *slide_event_name(MeetingMindVideo::SlideEventType type)
 {
-    if (!obs_frontend_recording_active()) {
-        obs_frontend_recording_start();
-        blog(LOG_INFO, "MeetingMind: Started recording");
+    switch (type) {
+    case MeetingMindVideo::SlideEventType::PresentationStarted:
+        return "presentation_started";
+    case MeetingMindVideo::SlideEventType::SlideChanged:
+        return "slide_changed";
+    case MeetingMindVideo::SlideEventType::PresentationEnded:
+        return "presentation_ended";
+    case MeetingMindVideo::SlideEventType::None:
+        break;
     }
+    return nullptr;
 }
 
-static void stop_recording()
+// UI thread. Slides starting or changing bring up the presentation scene,
+// and blank slides return to the discussion.
+static void handle_slide_event(const MeetingMindVideo::SlideEvent &event)
 {
-    if (obs_frontend_recording_active()) {
-        obs_frontend_recording_stop();
-        blog(LOG_INFO, "MeetingMind: Stopped recording");
+    using MeetingMindVideo::SlideEventType;
+    if (!plugin_config || !settings().slide_detection) return;
+    
+    const char *type = slide_event_name(event.type);
+    if (!type) return;
+    
+    if (settings().auto_scene_switching) {
+        switch_to_scene(event.type == SlideEventType::PresentationEnded ? SCENE_DISCUSSION : SCENE_PRESENTATION);
     }
+    
+    // The slide is dated to when it first appeared, not when it settled
+    const uint64_t now = os_gettime_ns();
+    const uint64_t age_ms = now > event.timestamp_ns ? (now - event.timestamp_ns) / 1000000 : 0;
+    const qint64 shown_ms = QDateTime::currentMSecsSinceEpoch() - (qint64)age_ms;
+    const QString source = QString::fromUtf8(settings().slide_source.c_str());
+    const QString hash = QString("%1").arg((qulonglong)event.hash, 16, 16, QLatin1Char('0'));
+    
+    const QString line = event.type == SlideEventType::PresentationEnded
+                             ? QString("Presentation in '%1' ended after %2 slides").arg(source).arg(event.slide)
+                             : QString("Slide %1 in '%2' (%3 blocks changed)")
+                                   .arg(event.slide)
+                                   .arg(source)
+                                   .arg(event.changed_blocks);
+    const QByteArray text = line.toUtf8();
+    MeetingMindActivityLog::append(text.constData(), (size_t)text.size());
+    
+    QJsonObject data;
+    data["source"] = source;
+    data["slide"] = (qint64)event.slide;
+    if (event.type != SlideEventType::PresentationEnded) {
+        data["hash"] = hash;
+        data["changed_blocks"] = (qint64)event.changed_blocks;
+    }
+    data["timestamp_ms"] = shown_ms;
+    send_obs_message(type, data);
+    
+    // The index dates the slide to when it appeared; a chapter can only go
+    // where the recording is now
+    const QByteArray chapter = event.type == SlideEventType::PresentationEnded
+                                   ? QByteArray("Presentation ended")
+                                   : QString("Slide %1").arg(event.slide).toUtf8();
+    mark_recording(type, chapter.constData(), encode_obs_message(type, data), event.timestamp_ns,
+                   MeetingMindIndex::FLAG_LOCAL);
 }
 
-// Plugin dock registration
-static MeetingMindWidget *dock_widget = nullptr;
+// Graphics thread; hands the event to the UI thread
+static void on_slide_event(void *, const MeetingMindVideo::SlideEvent &event)
+{
+    QMetaObject::invokeMethod(qApp, [event]() {
+        handle_slide_event(event);
+    }, Qt::QueuedConnection);
+}
 
-static void register_dock()
+// UI thread. Runs the slide watch while it is enabled, restarting it when
+// the source changes. Returns a line for the activity log when anything
+// changed.
+static QString update_slide_watch()
 {
-    dock_widget = new MeetingMindWidget();
+    static QString watched_source; // Empty while not watching
+    
+    const MeetingMindConfig::ConfigSnapshot &config = settings();
+    const bool wanted = plugin_config && config.slide_detection && !config.slide_source.empty();
+    const QString source = wanted ? QString::fromStdString(config.slide_source) : QString();
+    if (source == watched_source) return QString();
+    
+    if (source.isEmpty()) {
+        const MeetingMindSlides::WatchStats stats = MeetingMindSlides::get_watch_stats();
+        MeetingMindSlides::stop_watch();
+        watched_source.clear();
+        return QString("Slide detection stopped after %1 slide events").arg(stats.events);
+    }
     
-    obs_frontend_add_dock_by_id("meetingmind_dock", "MeetingMind", dock_widget);
+    const QByteArray name = source.toUtf8();
+    MeetingMindSlides::start_watch(name.constData(), on_slide_event, nullptr);
+    watched_source = source;
+    return QString("Watching '%1' for slides").arg(source);
 }
 
-static void unregister_dock()
+// Recording markers
+
+// UI thread. Opens an index for each recording started while markers are
+// enabled, and closes it when the recording stops or markers are turned
+// off. A recording already running when markers are turned on is not
+// indexed, since its start time is unknown. Returns a line for the activity
+// log when anything changed.
+static QString update_recording_index(bool starting)
 {
-    if (dock_widget) {
-        obs_frontend_remove_dock("meetingmind_dock");
-        delete dock_widget;
-        dock_widget = nullptr;
+    const bool wanted = plugin_config && settings().recording_markers && obs_frontend_recording_active();
+    QString change;
+    if (recording_index.is_open() && (!wanted || starting)) {
+        change = QString("Indexed %1 events in %2")
+                 .arg(recording_index.records())
+                 .arg(QString::fromUtf8(recording_index.index_path().c_str()));
+        recording_index.close();
+    }
+    if (!wanted || !starting) return change;
+    
+    char *path = obs_frontend_get_last_recording();
+    if (!path) return change;
+    
+    // The recording begins with the frame being output as it starts
+    struct obs_video_info ovi = {};
+    obs_get_video_info(&ovi);
+    const bool opened = recording_index.open(path, obs_get_video_frame_time(), QDateTime::currentMSecsSinceEpoch(),
+                                             ovi.fps_num, ovi.fps_den);
+    const QString recording = QString::fromUtf8(path);
+    bfree(path);
+    if (!opened) return QString("✗ Cannot write an event index next to %1").arg(recording);
+    return QString("Indexing meeting events in %1").arg(QString::fromUtf8(recording_index.index_path().c_str()));
+}
+
+// UI thread. Marks an event in the running recording: a chapter, unless
+// chapter is null, and an index record pointing at the event's message.
+// event_ns is when it happened, on the os_gettime_ns clock.
+static void mark_recording(const char *type, const char *chapter, const QByteArray &message, uint64_t event_ns,
+                           uint32_t flags)
+{
+    if (!plugin_config || !settings().recording_markers || !obs_frontend_recording_active()) return;
+    
+#if LIBOBS_API_VER >= MAKE_SEMANTIC_VERSION(30, 2, 0)
+    // Only some formats, such as hybrid MP4, take chapters
+    static bool chapters_unsupported_logged = false;
+    if (chapter && !obs_frontend_recording_paused() && !obs_frontend_recording_add_chapter(chapter) &&
+        !chapters_unsupported_logged) {
+        blog(LOG_INFO, "MeetingMind: The recording format does not take chapters; events are only indexed");
+        chapters_unsupported_logged = true;
+    }
+#else
+    (void)chapter;
+#endif
+    
+    if (!recording_index.is_open()) return;
+    const uint64_t now = os_gettime_ns();
+    const uint64_t age_ms = now > event_ns ? (now - event_ns) / 1000000 : 0;
+    const uint64_t wall_ms = (uint64_t)QDateTime::currentMSecsSinceEpoch() - age_ms;
+    if (!recording_index.append(event_ns, wall_ms, type, message.constData(), (size_t)message.size(), flags)) {
+        blog(LOG_WARNING, "MeetingMind: Cannot write to %s; events are no longer indexed",
+             recording_index.index_path().c_str());
+        recording_index.close();
     }
 }
 
@@ -680,7 +1895,20 @@ bool obs_module_load(void)
     blog(LOG_INFO, "MeetingMind plugin loaded (version 1.0.0)");
     
     load_config();
+    MeetingMindConfig::start_config_writer(plugin_config, CONFIG_SAVE_QUIET_MS);
+    MeetingMindSourceCache::init();
+    MeetingMindAudio::set_voice_callback(on_voice_activity, nullptr);
+    // Taps the metered and speaker sources
+    const QString director_state = update_director();
+    if (!director_state.isEmpty()) blog(LOG_INFO, "MeetingMind: %s", director_state.toUtf8().constData());
+    update_slide_watch();
+    MeetingMindActions::init_executor();
+    MeetingMindEvents::set_callbacks({switch_to_scene, set_source_mute, run_output_action, send_latency_report});
+    MeetingMindStream::register_stream_output();
+    MeetingMindRemoteAudio::register_remote_audio_source();
+    start_network_worker();
     register_dock();
+    obs_frontend_add_event_callback(on_frontend_event, nullptr);
     
     return true;
 }
@@ -689,26 +1917,27 @@ void obs_module_unload(void)
 {
     blog(LOG_INFO, "MeetingMind plugin unloaded");
     
+    obs_frontend_remove_event_callback(on_frontend_event, nullptr);
+    MeetingMindStream::stop_stream();
+    MeetingMindSlides::stop_watch();
+    recording_index.close();
     disconnect_from_server();
     unregister_dock();
     
+    // Writes out any edit still inside its quiet period
+    MeetingMindConfig::stop_config_writer();
+    
     if (plugin_config) {
-        if (plugin_config->server_url) bfree(plugin_config->server_url);
-        if (plugin_config->api_key) bfree(plugin_config->api_key);
-        if (plugin_config->meeting_id) bfree(plugin_config->meeting_id);
+        MeetingMindConfig::free_config_strings(plugin_config);
         bfree(plugin_config);
         plugin_config = nullptr;
     }
     
-    if (websocket) {
-        delete websocket;
-        websocket = nullptr;
-    }
-    
-    if (network_manager) {
-        delete network_manager;
-        network_manager = nullptr;
-    }
+    stop_network_worker();
+    MeetingMindActions::shutdown_executor();
+    MeetingMindAudio::shutdown_taps();
+    MeetingMindAudio::set_voice_callback(nullptr, nullptr);
+    MeetingMindSourceCache::shutdown();
 }
 
 #include "meetingmind-plugin.moc"
\ No newline at end of file
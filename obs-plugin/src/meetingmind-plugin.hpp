@@ -13,6 +13,9 @@ Defines interfaces and structures for the MeetingMind OBS integration
 #include <QTimer>
 #include <QJsonObject>
 
+#include "event-parser.hpp"
+#include "plugin-config.hpp"
+
 class QVBoxLayout;
 class QHBoxLayout;
 class QGridLayout;
@@ -31,20 +34,6 @@ class QTextEdit;
 #define MEETINGMIND_PLUGIN_VERSION_PATCH 0
 #define MEETINGMIND_PLUGIN_VERSION_STRING "1.0.0"
 
-// Plugin configuration structure
-struct meetingmind_config {
-    char *server_url;
-    int server_port;
-    char *api_key;
-    bool auto_scene_switching;
-    bool auto_recording;
-    bool audio_management;
-    bool meeting_notifications;
-    int connection_timeout;
-    char *meeting_id;
-    bool connected;
-};
-
 // Scene names for automatic switching
 extern const char *SCENE_WELCOME;
 extern const char *SCENE_PRESENTATION;
@@ -180,33 +169,24 @@ namespace MeetingMindUtils {
 
 // Event handler functions
 namespace MeetingMindEvents {
-    void handle_meeting_started(const QJsonObject &data);
-    void handle_meeting_ended(const QJsonObject &data);
-    void handle_participant_joined(const QJsonObject &data);
-    void handle_participant_left(const QJsonObject &data);
-    void handle_screen_share_started(const QJsonObject &data);
-    void handle_screen_share_ended(const QJsonObject &data);
-    void handle_presentation_started(const QJsonObject &data);
-    void handle_presentation_ended(const QJsonObject &data);
-    void handle_break_started(const QJsonObject &data);
-    void handle_break_ended(const QJsonObject &data);
-    void handle_recording_requested(const QJsonObject &data);
-    void handle_recording_stopped(const QJsonObject &data);
-    void handle_streaming_requested(const QJsonObject &data);
-    void handle_streaming_stopped(const QJsonObject &data);
-    void handle_audio_mute_requested(const QJsonObject &data);
-    void handle_audio_unmute_requested(const QJsonObject &data);
-    void handle_scene_change_requested(const QJsonObject &data);
-}
-
-// Configuration management
-namespace MeetingMindConfig {
-    bool load_config(meetingmind_config *config);
-    bool save_config(const meetingmind_config *config);
-    void apply_default_config(meetingmind_config *config);
-    bool validate_config(const meetingmind_config *config);
-    QString get_config_file_path();
-    void migrate_config_if_needed();
+    void handle_meeting_started(const MeetingMindJson::ObjectView &data);
+    void handle_meeting_ended(const MeetingMindJson::ObjectView &data);
+    void handle_participant_joined(const MeetingMindJson::ObjectView &data);
+    void handle_participant_left(const MeetingMindJson::ObjectView &data);
+    void handle_screen_share_started(const MeetingMindJson::ObjectView &data);
+    void handle_screen_share_ended(const MeetingMindJson::ObjectView &data);
+    void handle_presentation_started(const MeetingMindJson::ObjectView &data);
+    void handle_presentation_ended(const MeetingMindJson::ObjectView &data);
+    void handle_break_started(const MeetingMindJson::ObjectView &data);
+    void handle_break_ended(const MeetingMindJson::ObjectView &data);
+    void handle_recording_requested(const MeetingMindJson::ObjectView &data);
+    void handle_recording_stopped(const MeetingMindJson::ObjectView &data);
+    void handle_streaming_requested(const MeetingMindJson::ObjectView &data);
+    void handle_streaming_stopped(const MeetingMindJson::ObjectView &data);
+    void handle_audio_mute_requested(const MeetingMindJson::ObjectView &data);
+    void handle_audio_unmute_requested(const MeetingMindJson::ObjectView &data);
+    void handle_scene_change_requested(const MeetingMindJson::ObjectView &data);
+    void handle_latency_report_requested(const MeetingMindJson::ObjectView &data);
 }
 
 // Global plugin state
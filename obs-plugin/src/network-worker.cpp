@@ -0,0 +1,323 @@
+/*
+MeetingMind Network Worker
+Owns the MeetingMind WebSocket on a dedicated thread, parses and validates
+inbound frames there and hands typed events to the UI thread
+*/
+
+#include "network-worker.hpp"
+
+#include <util/base.h>
+#include <util/platform.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QWebSocket>
+#include <cstring>
+
+MeetingMindNetworkWorker::MeetingMindNetworkWorker(QObject *parent)
+    : QObject(parent),
+      websocket(nullptr),
+      network_manager(nullptr),
+      frame_handlers(),
+      frame_handler_count(0),
+      drain_scheduled(false),
+      dropped_count(0),
+      invalid_count(0),
+      duplicate_count(0),
+      last_sequence_seen(0)
+{
+}
+
+MeetingMindNetworkWorker::~MeetingMindNetworkWorker()
+{
+    if (websocket) {
+        websocket->abort();
+    }
+    trace_writer.close();
+}
+
+void MeetingMindNetworkWorker::set_binary_frame_handler(const char tag[4], BinaryFrameHandler handler)
+{
+    if (frame_handler_count == MAX_FRAME_HANDLERS) return;
+    memcpy(frame_handlers[frame_handler_count].tag, tag, 4);
+    frame_handlers[frame_handler_count].handler = handler;
+    frame_handler_count++;
+}
+
+void MeetingMindNetworkWorker::open_async(const QUrl &url, const QByteArray &api_key, bool resuming)
+{
+    QMetaObject::invokeMethod(this, [this, url, api_key, resuming]() { open(url, api_key, resuming); },
+                              Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::close_async()
+{
+    QMetaObject::invokeMethod(this, [this]() { close(); }, Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::send_text_async(const QByteArray &message)
+{
+    QMetaObject::invokeMethod(this, [this, message]() {
+        if (websocket && websocket->state() == QAbstractSocket::ConnectedState) {
+            websocket->sendTextMessage(QString::fromUtf8(message));
+        }
+    }, Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::send_binary_async(const QByteArray &message)
+{
+    QMetaObject::invokeMethod(this, [this, message]() {
+        if (websocket && websocket->state() == QAbstractSocket::ConnectedState) {
+            websocket->sendBinaryMessage(message);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::check_health_async(const QUrl &url, const QByteArray &api_key)
+{
+    QMetaObject::invokeMethod(this, [this, url, api_key]() {
+        if (!network_manager) {
+            network_manager = new QNetworkAccessManager(this);
+        }
+
+        QNetworkRequest request(url);
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+        if (!api_key.isEmpty()) {
+            request.setRawHeader("Authorization", "Bearer " + api_key);
+        }
+
+        QNetworkReply *reply = network_manager->get(request);
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+            if (reply->error() == QNetworkReply::NoError) {
+                QJsonObject obj = QJsonDocument::fromJson(reply->readAll()).object();
+                if (obj["status"].toString() == "healthy") {
+                    emit health_checked(true, "✓ Connection test successful!");
+                } else {
+                    emit health_checked(false, "⚠ Server responded but reported unhealthy status");
+                }
+            } else {
+                emit health_checked(false, QString("✗ Connection test failed: %1").arg(reply->errorString()));
+            }
+            reply->deleteLater();
+        });
+    }, Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::start_trace_async(const QString &path)
+{
+    QMetaObject::invokeMethod(this, [this, path]() {
+        const QByteArray file = path.toUtf8();
+        if (trace_writer.open(file.constData())) {
+            blog(LOG_INFO, "MeetingMind: Recording event trace to %s", file.constData());
+        } else {
+            blog(LOG_WARNING, "MeetingMind: Cannot write event trace %s", file.constData());
+        }
+    }, Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::stop_trace_async()
+{
+    QMetaObject::invokeMethod(this, [this]() {
+        if (!trace_writer.is_open()) return;
+        blog(LOG_INFO, "MeetingMind: Event trace closed after %llu frames",
+             (unsigned long long)trace_writer.records());
+        trace_writer.close();
+    }, Qt::QueuedConnection);
+}
+
+void MeetingMindNetworkWorker::begin_drain()
+{
+    drain_scheduled.store(false, std::memory_order_release);
+}
+
+bool MeetingMindNetworkWorker::pop_event(MeetingEvent &event)
+{
+    return event_queue.try_pop(event);
+}
+
+void MeetingMindNetworkWorker::open(const QUrl &url, const QByteArray &api_key, bool resuming)
+{
+    close();
+
+    // Only a resumed session continues the numbering we have seen. A new
+    // one, or a backend that never acknowledges, starts again from 1.
+    if (!resuming) {
+        last_sequence_seen.store(0, std::memory_order_release);
+    }
+
+    websocket = new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this);
+    connect(websocket, &QWebSocket::connected, this, &MeetingMindNetworkWorker::connected);
+    connect(websocket, &QWebSocket::disconnected, this, &MeetingMindNetworkWorker::disconnected);
+    connect(websocket, &QWebSocket::textMessageReceived, this, &MeetingMindNetworkWorker::on_websocket_message);
+    connect(websocket, &QWebSocket::binaryMessageReceived, this, &MeetingMindNetworkWorker::on_websocket_binary_message);
+
+    QNetworkRequest request(url);
+    if (!api_key.isEmpty()) {
+        request.setRawHeader("Authorization", "Bearer " + api_key);
+    }
+
+    websocket->open(request);
+}
+
+void MeetingMindNetworkWorker::close()
+{
+    if (!websocket) return;
+
+    // The socket may outlive this call while the close handshake runs, so
+    // detach it first and report the disconnect ourselves
+    const bool was_connected = websocket->state() == QAbstractSocket::ConnectedState;
+    websocket->disconnect(this);
+    websocket->close();
+    websocket->deleteLater();
+    websocket = nullptr;
+
+    if (was_connected) {
+        emit disconnected();
+    }
+}
+
+void MeetingMindNetworkWorker::on_websocket_message(const QString &message)
+{
+    MeetingEvent event;
+    event.received_ns = os_gettime_ns();
+    event.frame = message.toUtf8();
+    if (trace_writer.is_open()) {
+        trace_writer.append(event.received_ns, false, event.frame.constData(), (size_t)event.frame.size());
+    }
+    handle_frame(std::move(event), MeetingMindJson::Encoding::Json);
+}
+
+void MeetingMindNetworkWorker::on_websocket_binary_message(const QByteArray &message)
+{
+    const uint64_t received_ns = os_gettime_ns();
+    if (message.size() >= 4) {
+        for (size_t i = 0; i < frame_handler_count; i++) {
+            if (memcmp(message.constData(), frame_handlers[i].tag, 4) != 0) continue;
+            if (!frame_handlers[i].handler((const uint8_t *)message.constData(), (size_t)message.size(),
+                                           received_ns)) {
+                invalid_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
+
+    // Other binary frames are MessagePack; the QByteArray is shared, not
+    // copied
+    MeetingEvent event;
+    event.received_ns = received_ns;
+    event.frame = message;
+    if (trace_writer.is_open()) {
+        trace_writer.append(event.received_ns, true, message.constData(), (size_t)message.size());
+    }
+    handle_frame(std::move(event), MeetingMindJson::Encoding::MessagePack);
+}
+
+void MeetingMindNetworkWorker::handle_frame(MeetingEvent &&event, MeetingMindJson::Encoding encoding)
+{
+    if (!parse_event(event, encoding)) {
+        invalid_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    event.parsed_ns = os_gettime_ns();
+
+    if (handle_control_message(event)) return;
+
+    // A resumed session may replay events we already dispatched; only the
+    // worker thread writes the high-water mark
+    if (event.sequence != 0) {
+        if (event.sequence <= last_sequence_seen.load(std::memory_order_relaxed)) {
+            duplicate_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        last_sequence_seen.store(event.sequence, std::memory_order_release);
+    }
+
+    publish_event(std::move(event));
+}
+
+bool MeetingMindNetworkWorker::parse_event(MeetingEvent &event, MeetingMindJson::Encoding encoding)
+{
+    event.encoding = encoding;
+
+    // Reads the fields straight out of the frame; nothing is allocated
+    const std::string_view frame(event.frame.constData(), (size_t)event.frame.size());
+    MeetingMindJson::ObjectView obj;
+    const bool parsed = encoding == MeetingMindJson::Encoding::MessagePack ? obj.parse_msgpack(frame)
+                                                                            : obj.parse(frame);
+    if (!parsed) {
+        blog(LOG_WARNING, "MeetingMind: Dropping malformed %s message",
+             encoding == MeetingMindJson::Encoding::MessagePack ? "binary" : "text");
+        return false;
+    }
+
+    event.type = obj.raw_string("type");
+    if (!obj.is_string("type") || event.type.empty()) {
+        blog(LOG_WARNING, "MeetingMind: Dropping message without event type");
+        return false;
+    }
+
+    int64_t sequence = 0;
+    event.sequence = obj.get_int("seq", sequence) && sequence > 0 ? (uint64_t)sequence : 0;
+
+    const int data_index = obj.find("data");
+    if (data_index >= 0 && obj.kind(data_index) != MeetingMindJson::ValueKind::Null) {
+        const std::string_view data = obj.value(data_index);
+        if (obj.kind(data_index) != MeetingMindJson::ValueKind::Object ||
+            !(encoding == MeetingMindJson::Encoding::MessagePack ? event.data.parse_msgpack(data)
+                                                                 : event.data.parse(data))) {
+            blog(LOG_WARNING, "MeetingMind: Dropping '%.*s' event with invalid data",
+                 (int)event.type.size(), event.type.data());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MeetingMindNetworkWorker::handle_control_message(const MeetingEvent &event)
+{
+    // Subscription acknowledgement:
+    // {"type": "subscribed", "data": {"encoding": "msgpack", "session_id": "...", "resumed": true}}
+    if (event.type == "subscribed") {
+        const std::string_view encoding = event.data.raw_string("encoding");
+        char session_id[128];
+        if (!event.data.copy_string("session_id", session_id, sizeof(session_id))) {
+            session_id[0] = '\0';
+        }
+        bool resumed = false;
+        event.data.get_bool("resumed", resumed);
+
+        // A fresh session numbers its events from the start again
+        if (!resumed) {
+            last_sequence_seen.store(0, std::memory_order_release);
+        }
+
+        emit subscribed(encoding.empty() ? QString("json")
+                                         : QString::fromUtf8(encoding.data(), (int)encoding.size()),
+                        QString::fromUtf8(session_id), resumed);
+        return true;
+    }
+
+    return false;
+}
+
+void MeetingMindNetworkWorker::publish_event(MeetingEvent &&event)
+{
+    if (!event_queue.try_push(std::move(event))) {
+        // The UI thread has fallen a full queue behind; later drops only
+        // show in the dock's count
+        if (dropped_count.fetch_add(1, std::memory_order_relaxed) == 0) {
+            blog(LOG_WARNING, "MeetingMind: Event queue full (%zu events), dropping '%.*s'", EVENT_QUEUE_CAPACITY,
+                 (int)event.type.size(), event.type.data());
+        }
+        return;
+    }
+
+    // One wake-up per drain, not per event
+    if (!drain_scheduled.exchange(true, std::memory_order_acq_rel)) {
+        emit events_ready();
+    }
+}
@@ -0,0 +1,121 @@
+/*
+MeetingMind Network Worker
+Owns the MeetingMind WebSocket on a dedicated thread, parses and validates
+inbound frames there and hands typed events to the UI thread
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "event-parser.hpp"
+#include "spsc-queue.hpp"
+#include "trace-file.hpp"
+
+class QWebSocket;
+class QNetworkAccessManager;
+
+// A validated meeting event, ready for dispatch on the UI thread. The type
+// and data views point into frame, which keeps the bytes alive. sequence is
+// the envelope's "seq", or 0 if the backend did not number the event. The
+// timestamps are os_gettime_ns() values taken on the network thread.
+struct MeetingEvent {
+    QByteArray frame;
+    std::string_view type;
+    MeetingMindJson::ObjectView data;
+    MeetingMindJson::Encoding encoding = MeetingMindJson::Encoding::Json;
+    uint64_t sequence = 0;
+    uint64_t received_ns = 0;
+    uint64_t parsed_ns = 0;
+};
+
+// Takes a tagged binary frame on the worker thread; frame is only valid
+// during the call. Returns false if the frame is malformed.
+typedef bool (*BinaryFrameHandler)(const uint8_t *frame, size_t size, uint64_t received_ns);
+
+class MeetingMindNetworkWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
+
+    static constexpr size_t MAX_FRAME_HANDLERS = 4;
+
+    explicit MeetingMindNetworkWorker(QObject *parent = nullptr);
+    ~MeetingMindNetworkWorker();
+
+    // Binary frames that start with tag go to handler instead of the event
+    // parser, and are not traced. Call before the worker's thread starts.
+    void set_binary_frame_handler(const char tag[4], BinaryFrameHandler handler);
+
+    // Thread-safe entry points; the work is queued onto the worker thread.
+    // Unless resuming, the connection starts a new session and forgets the
+    // last sequence seen.
+    void open_async(const QUrl &url, const QByteArray &api_key, bool resuming);
+    void close_async();
+    void send_text_async(const QByteArray &message);
+    void send_binary_async(const QByteArray &message);
+    void check_health_async(const QUrl &url, const QByteArray &api_key);
+
+    // Records every inbound frame, as received, to a trace file until
+    // stopped. Starting again replaces the current trace.
+    void start_trace_async(const QString &path);
+    void stop_trace_async();
+
+    // Consumer side of the event queue, UI thread only. Call begin_drain()
+    // before popping so that events pushed during the drain re-signal.
+    void begin_drain();
+    bool pop_event(MeetingEvent &event);
+
+    uint64_t dropped_events() const { return dropped_count.load(std::memory_order_relaxed); }
+    uint64_t invalid_messages() const { return invalid_count.load(std::memory_order_relaxed); }
+    uint64_t duplicate_events() const { return duplicate_count.load(std::memory_order_relaxed); }
+
+    // Highest event sequence seen in the current session, sent back to the
+    // backend when resuming so that only later events are replayed
+    uint64_t last_sequence() const { return last_sequence_seen.load(std::memory_order_acquire); }
+
+signals:
+    void connected();
+    void disconnected();
+    void events_ready();
+    void subscribed(const QString &encoding, const QString &session_id, bool resumed);
+    void health_checked(bool healthy, const QString &message);
+
+private slots:
+    void on_websocket_message(const QString &message);
+    void on_websocket_binary_message(const QByteArray &message);
+
+private:
+    void open(const QUrl &url, const QByteArray &api_key, bool resuming);
+    void close();
+    void handle_frame(MeetingEvent &&event, MeetingMindJson::Encoding encoding);
+    bool parse_event(MeetingEvent &event, MeetingMindJson::Encoding encoding);
+    bool handle_control_message(const MeetingEvent &event);
+    void publish_event(MeetingEvent &&event);
+
+    struct FrameHandler {
+        char tag[4];
+        BinaryFrameHandler handler;
+    };
+
+    QWebSocket *websocket;
+    QNetworkAccessManager *network_manager;
+    FrameHandler frame_handlers[MAX_FRAME_HANDLERS];
+    size_t frame_handler_count;
+    MeetingMindTrace::TraceWriter trace_writer;
+
+    SpscQueue<MeetingEvent, EVENT_QUEUE_CAPACITY> event_queue;
+    std::atomic<bool> drain_scheduled;
+    std::atomic<uint64_t> dropped_count;
+    std::atomic<uint64_t> invalid_count;
+    std::atomic<uint64_t> duplicate_count;
+    std::atomic<uint64_t> last_sequence_seen;
+};
@@ -0,0 +1,299 @@
+/*
+MeetingMind Plugin Configuration
+Plugin settings and their persistence in meetingmind.ini
+*/
+
+#include "plugin-config.hpp"
+
+#include <obs-module.h>
+#include <util/config-file.h>
+
+#include <cstring>
+
+namespace MeetingMindConfig {
+
+namespace {
+
+const char *CONFIG_FILE = "meetingmind.ini";
+
+void replace_string(char *&field, const char *value)
+{
+    if (field) bfree(field);
+    field = bstrdup(value ? value : "");
+}
+
+void read_string(config_t *config, const char *section, const char *name, char *&field)
+{
+    if (config_has_user_value(config, section, name)) {
+        replace_string(field, config_get_string(config, section, name));
+    }
+}
+
+void read_int(config_t *config, const char *section, const char *name, int &field)
+{
+    if (config_has_user_value(config, section, name)) {
+        field = (int)config_get_int(config, section, name);
+    }
+}
+
+void read_bool(config_t *config, const char *section, const char *name, bool &field)
+{
+    if (config_has_user_value(config, section, name)) {
+        field = config_get_bool(config, section, name);
+    }
+}
+
+bool same_string(const char *a, const char *b)
+{
+    return strcmp(a ? a : "", b ? b : "") == 0;
+}
+
+// The settings validate_config checks, one by one
+bool valid_server_url(const char *url)
+{
+    return url && *url;
+}
+
+bool valid_server_port(int port)
+{
+    return port > 0 && port <= 65535;
+}
+
+bool valid_connection_timeout(int seconds)
+{
+    return seconds > 0;
+}
+
+bool valid_coalesce_window(int ms)
+{
+    return ms >= 0 && ms <= 2000;
+}
+
+void warn_invalid(const char *section, const char *name)
+{
+    blog(LOG_WARNING, "MeetingMind: %s has an invalid %s.%s, using the default", CONFIG_FILE, section, name);
+}
+
+// Puts each setting validate_config rejects back to its default, so that one
+// bad value does not cost the others
+void reset_invalid_settings(meetingmind_config *config)
+{
+    meetingmind_config defaults = {};
+    apply_default_config(&defaults);
+
+    if (!valid_server_url(config->server_url)) {
+        warn_invalid("connection", "server_url");
+        replace_string(config->server_url, defaults.server_url);
+    }
+    if (!valid_server_port(config->server_port)) {
+        warn_invalid("connection", "server_port");
+        config->server_port = defaults.server_port;
+    }
+    if (!valid_connection_timeout(config->connection_timeout)) {
+        warn_invalid("advanced", "connection_timeout");
+        config->connection_timeout = defaults.connection_timeout;
+    }
+    if (!valid_coalesce_window(config->coalesce_window_ms)) {
+        warn_invalid("advanced", "coalesce_window_ms");
+        config->coalesce_window_ms = defaults.coalesce_window_ms;
+    }
+
+    free_config_strings(&defaults);
+}
+
+} // namespace
+
+void free_config_strings(meetingmind_config *config)
+{
+    if (config->server_url) bfree(config->server_url);
+    if (config->api_key) bfree(config->api_key);
+    if (config->meeting_id) bfree(config->meeting_id);
+    if (config->director_map) bfree(config->director_map);
+    if (config->audio_stream_source) bfree(config->audio_stream_source);
+    if (config->slide_source) bfree(config->slide_source);
+    config->server_url = nullptr;
+    config->api_key = nullptr;
+    config->meeting_id = nullptr;
+    config->director_map = nullptr;
+    config->audio_stream_source = nullptr;
+    config->slide_source = nullptr;
+}
+
+void apply_default_config(meetingmind_config *config)
+{
+    replace_string(config->server_url, "localhost");
+    config->server_port = 8080;
+    replace_string(config->api_key, "");
+    replace_string(config->meeting_id, "");
+    config->auto_scene_switching = true;
+    config->auto_recording = true;
+    config->recording_markers = false;
+    config->auto_start_streaming = false;
+    config->auto_stop_streaming = false;
+    config->audio_management = true;
+    config->meeting_notifications = true;
+    config->voice_switching = false;
+    replace_string(config->director_map, "Microphone=Meeting - Host Camera; Meeting Audio=Meeting - Remote Camera");
+    config->audio_streaming = false;
+    replace_string(config->audio_stream_source, "Meeting Audio");
+    config->slide_detection = false;
+    replace_string(config->slide_source, "Presentation");
+    config->connection_timeout = 10;
+    config->binary_protocol = false;
+    config->record_trace = false;
+    config->coalesce_window_ms = 100;
+    config->connected = false;
+}
+
+bool validate_config(const meetingmind_config *config)
+{
+    return valid_server_url(config->server_url) && valid_server_port(config->server_port) &&
+           valid_connection_timeout(config->connection_timeout) &&
+           valid_coalesce_window(config->coalesce_window_ms);
+}
+
+bool load_config(meetingmind_config *config)
+{
+    apply_default_config(config);
+
+    char *config_path = obs_module_config_path(CONFIG_FILE);
+    config_t *file = nullptr;
+    const int result = config_open(&file, config_path, CONFIG_OPEN_EXISTING);
+    bfree(config_path);
+
+    if (result != CONFIG_SUCCESS) return false;
+
+    read_string(file, "connection", "server_url", config->server_url);
+    read_int(file, "connection", "server_port", config->server_port);
+    read_string(file, "connection", "api_key", config->api_key);
+    read_string(file, "connection", "meeting_id", config->meeting_id);
+
+    read_bool(file, "features", "auto_scene_switching", config->auto_scene_switching);
+    read_bool(file, "features", "auto_recording", config->auto_recording);
+    read_bool(file, "features", "recording_markers", config->recording_markers);
+    read_bool(file, "features", "auto_start_streaming", config->auto_start_streaming);
+    read_bool(file, "features", "auto_stop_streaming", config->auto_stop_streaming);
+    read_bool(file, "features", "audio_management", config->audio_management);
+    read_bool(file, "features", "meeting_notifications", config->meeting_notifications);
+    read_bool(file, "features", "voice_switching", config->voice_switching);
+    read_string(file, "features", "director_map", config->director_map);
+    read_bool(file, "features", "audio_streaming", config->audio_streaming);
+    read_string(file, "features", "audio_stream_source", config->audio_stream_source);
+    read_bool(file, "features", "slide_detection", config->slide_detection);
+    read_string(file, "features", "slide_source", config->slide_source);
+
+    read_int(file, "advanced", "connection_timeout", config->connection_timeout);
+    read_bool(file, "advanced", "binary_protocol", config->binary_protocol);
+    read_bool(file, "advanced", "record_trace", config->record_trace);
+    read_int(file, "advanced", "coalesce_window_ms", config->coalesce_window_ms);
+
+    config_close(file);
+
+    reset_invalid_settings(config);
+    return true;
+}
+
+bool save_config(const meetingmind_config *config)
+{
+    return save_config_fields(config, ALL_FIELDS);
+}
+
+bool save_config_fields(const meetingmind_config *config, uint32_t fields)
+{
+    if (!validate_config(config)) {
+        blog(LOG_WARNING, "MeetingMind: Not saving invalid settings");
+        return false;
+    }
+
+    char *config_path = obs_module_config_path(CONFIG_FILE);
+    config_t *file = nullptr;
+    const int result = config_open(&file, config_path, CONFIG_OPEN_ALWAYS);
+    bfree(config_path);
+    if (result != CONFIG_SUCCESS || !file) return false;
+
+    if (fields & FIELD_SERVER_URL) config_set_string(file, "connection", "server_url", config->server_url);
+    if (fields & FIELD_SERVER_PORT) config_set_int(file, "connection", "server_port", config->server_port);
+    if (fields & FIELD_API_KEY) config_set_string(file, "connection", "api_key", config->api_key);
+    if (fields & FIELD_MEETING_ID) config_set_string(file, "connection", "meeting_id", config->meeting_id);
+
+    if (fields & FIELD_AUTO_SCENE_SWITCHING)
+        config_set_bool(file, "features", "auto_scene_switching", config->auto_scene_switching);
+    if (fields & FIELD_AUTO_RECORDING)
+        config_set_bool(file, "features", "auto_recording", config->auto_recording);
+    if (fields & FIELD_RECORDING_MARKERS)
+        config_set_bool(file, "features", "recording_markers", config->recording_markers);
+    if (fields & FIELD_AUTO_START_STREAMING)
+        config_set_bool(file, "features", "auto_start_streaming", config->auto_start_streaming);
+    if (fields & FIELD_AUTO_STOP_STREAMING)
+        config_set_bool(file, "features", "auto_stop_streaming", config->auto_stop_streaming);
+    if (fields & FIELD_AUDIO_MANAGEMENT)
+        config_set_bool(file, "features", "audio_management", config->audio_management);
+    if (fields & FIELD_MEETING_NOTIFICATIONS)
+        config_set_bool(file, "features", "meeting_notifications", config->meeting_notifications);
+    if (fields & FIELD_VOICE_SWITCHING)
+        config_set_bool(file, "features", "voice_switching", config->voice_switching);
+    if (fields & FIELD_DIRECTOR_MAP)
+        config_set_string(file, "features", "director_map", config->director_map);
+    if (fields & FIELD_AUDIO_STREAMING)
+        config_set_bool(file, "features", "audio_streaming", config->audio_streaming);
+    if (fields & FIELD_AUDIO_STREAM_SOURCE)
+        config_set_string(file, "features", "audio_stream_source", config->audio_stream_source);
+    if (fields & FIELD_SLIDE_DETECTION)
+        config_set_bool(file, "features", "slide_detection", config->slide_detection);
+    if (fields & FIELD_SLIDE_SOURCE)
+        config_set_string(file, "features", "slide_source", config->slide_source);
+
+    if (fields & FIELD_CONNECTION_TIMEOUT)
+        config_set_int(file, "advanced", "connection_timeout", config->connection_timeout);
+    if (fields & FIELD_BINARY_PROTOCOL)
+        config_set_bool(file, "advanced", "binary_protocol", config->binary_protocol);
+    if (fields & FIELD_RECORD_TRACE)
+        config_set_bool(file, "advanced", "record_trace", config->record_trace);
+    if (fields & FIELD_COALESCE_WINDOW)
+        config_set_int(file, "advanced", "coalesce_window_ms", config->coalesce_window_ms);
+
+    const bool saved = config_save_safe(file, "tmp", nullptr) == CONFIG_SUCCESS;
+    config_close(file);
+    return saved;
+}
+
+uint32_t diff_config(const meetingmind_config *a, const meetingmind_config *b)
+{
+    uint32_t fields = 0;
+    if (!same_string(a->server_url, b->server_url)) fields |= FIELD_SERVER_URL;
+    if (a->server_port != b->server_port) fields |= FIELD_SERVER_PORT;
+    if (!same_string(a->api_key, b->api_key)) fields |= FIELD_API_KEY;
+    if (!same_string(a->meeting_id, b->meeting_id)) fields |= FIELD_MEETING_ID;
+    if (a->auto_scene_switching != b->auto_scene_switching) fields |= FIELD_AUTO_SCENE_SWITCHING;
+    if (a->auto_recording != b->auto_recording) fields |= FIELD_AUTO_RECORDING;
+    if (a->recording_markers != b->recording_markers) fields |= FIELD_RECORDING_MARKERS;
+    if (a->auto_start_streaming != b->auto_start_streaming) fields |= FIELD_AUTO_START_STREAMING;
+    if (a->auto_stop_streaming != b->auto_stop_streaming) fields |= FIELD_AUTO_STOP_STREAMING;
+    if (a->audio_management != b->audio_management) fields |= FIELD_AUDIO_MANAGEMENT;
+    if (a->meeting_notifications != b->meeting_notifications) fields |= FIELD_MEETING_NOTIFICATIONS;
+    if (a->voice_switching != b->voice_switching) fields |= FIELD_VOICE_SWITCHING;
+    if (!same_string(a->director_map, b->director_map)) fields |= FIELD_DIRECTOR_MAP;
+    if (a->audio_streaming != b->audio_streaming) fields |= FIELD_AUDIO_STREAMING;
+    if (!same_string(a->audio_stream_source, b->audio_stream_source)) fields |= FIELD_AUDIO_STREAM_SOURCE;
+    if (a->slide_detection != b->slide_detection) fields |= FIELD_SLIDE_DETECTION;
+    if (!same_string(a->slide_source, b->slide_source)) fields |= FIELD_SLIDE_SOURCE;
+    if (a->connection_timeout != b->connection_timeout) fields |= FIELD_CONNECTION_TIMEOUT;
+    if (a->binary_protocol != b->binary_protocol) fields |= FIELD_BINARY_PROTOCOL;
+    if (a->record_trace != b->record_trace) fields |= FIELD_RECORD_TRACE;
+    if (a->coalesce_window_ms != b->coalesce_window_ms) fields |= FIELD_COALESCE_WINDOW;
+    return fields;
+}
+
+void copy_config(meetingmind_config *to, const meetingmind_config *from)
+{
+    free_config_strings(to);
+    *to = *from;
+    to->server_url = from->server_url ? bstrdup(from->server_url) : nullptr;
+    to->api_key = from->api_key ? bstrdup(from->api_key) : nullptr;
+    to->meeting_id = from->meeting_id ? bstrdup(from->meeting_id) : nullptr;
+    to->director_map = from->director_map ? bstrdup(from->director_map) : nullptr;
+    to->audio_stream_source = from->audio_stream_source ? bstrdup(from->audio_stream_source) : nullptr;
+    to->slide_source = from->slide_source ? bstrdup(from->slide_source) : nullptr;
+}
+
+} // namespace MeetingMindConfig
@@ -0,0 +1,86 @@
+/*
+MeetingMind Plugin Configuration
+Plugin settings and their persistence in meetingmind.ini
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Plugin configuration structure. Strings are owned and allocated with
+// bstrdup.
+struct meetingmind_config {
+    char *server_url;
+    int server_port;
+    char *api_key;
+    bool auto_scene_switching;
+    bool auto_recording;
+    bool recording_markers;
+    bool auto_start_streaming;
+    bool auto_stop_streaming;
+    bool audio_management;
+    bool meeting_notifications;
+    bool voice_switching;
+    char *director_map;
+    bool audio_streaming;
+    char *audio_stream_source;
+    bool slide_detection;
+    char *slide_source;
+    int connection_timeout;
+    bool binary_protocol;
+    bool record_trace;
+    int coalesce_window_ms;
+    char *meeting_id;
+    bool connected;
+};
+
+namespace MeetingMindConfig {
+    // One bit per persisted setting, for tracking which ones changed
+    enum ConfigField : uint32_t {
+        FIELD_SERVER_URL = 1u << 0,
+        FIELD_SERVER_PORT = 1u << 1,
+        FIELD_API_KEY = 1u << 2,
+        FIELD_MEETING_ID = 1u << 3,
+        FIELD_AUTO_SCENE_SWITCHING = 1u << 4,
+        FIELD_AUTO_RECORDING = 1u << 5,
+        FIELD_AUDIO_MANAGEMENT = 1u << 6,
+        FIELD_MEETING_NOTIFICATIONS = 1u << 7,
+        FIELD_CONNECTION_TIMEOUT = 1u << 8,
+        FIELD_BINARY_PROTOCOL = 1u << 9,
+        FIELD_RECORD_TRACE = 1u << 10,
+        FIELD_COALESCE_WINDOW = 1u << 11,
+        FIELD_VOICE_SWITCHING = 1u << 12,
+        FIELD_AUDIO_STREAMING = 1u << 13,
+        FIELD_AUDIO_STREAM_SOURCE = 1u << 14,
+        FIELD_DIRECTOR_MAP = 1u << 15,
+        FIELD_SLIDE_DETECTION = 1u << 16,
+        FIELD_SLIDE_SOURCE = 1u << 17,
+        FIELD_RECORDING_MARKERS = 1u << 18,
+        FIELD_AUTO_START_STREAMING = 1u << 19,
+        FIELD_AUTO_STOP_STREAMING = 1u << 20,
+        ALL_FIELDS = (1u << 21) - 1,
+    };
+
+    // Reads meetingmind.ini into config. Keys missing from the file, or
+    // with values validate_config rejects, keep their defaults. Returns
+    // false if the file does not exist yet.
+    bool load_config(meetingmind_config *config);
+    bool save_config(const meetingmind_config *config);
+
+    // Rewrites only the given fields of meetingmind.ini, keeping the rest of
+    // the file, through a temporary file renamed over the original so that
+    // a crash never leaves it half written
+    bool save_config_fields(const meetingmind_config *config, uint32_t fields);
+
+    // Fields whose values differ between a and b
+    uint32_t diff_config(const meetingmind_config *a, const meetingmind_config *b);
+
+    // Deep copy; strings already in to are freed first
+    void copy_config(meetingmind_config *to, const meetingmind_config *from);
+
+    // Replaces every setting with its default; strings already in config
+    // are freed first
+    void apply_default_config(meetingmind_config *config);
+    bool validate_config(const meetingmind_config *config);
+    void free_config_strings(meetingmind_config *config);
+}
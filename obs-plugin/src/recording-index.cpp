@@ -0,0 +1,178 @@
+/*
+MeetingMind Recording Index
+Sidecar files written next to a recording that map times in the recording
+to the meeting events that happened then, for seeking without scanning
+*/
+
+#include "recording-index.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MeetingMindIndex {
+
+namespace {
+
+const char MAGIC[8] = {'M', 'M', 'I', 'N', 'D', 'E', 'X', '1'};
+const char *const INDEX_SUFFIX = ".mmindex";
+const char *const PAYLOAD_SUFFIX = ".mmevents";
+
+void store_le(uint8_t *out, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint64_t load_le(const uint8_t *in, size_t bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+} // namespace
+
+IndexWriter::~IndexWriter()
+{
+    close();
+}
+
+bool IndexWriter::open(const char *recording_path, uint64_t start, uint64_t start_wall_ms, uint32_t fps_num,
+                       uint32_t fps_den)
+{
+    close();
+
+    path = std::string(recording_path) + INDEX_SUFFIX;
+    index_file = fopen(path.c_str(), "wb");
+    payload_file = fopen((std::string(recording_path) + PAYLOAD_SUFFIX).c_str(), "wb");
+    if (!index_file || !payload_file) {
+        close();
+        return false;
+    }
+
+    start_ns = start;
+    paused_ns = 0;
+    pause_start_ns = 0;
+    last_time_ns = 0;
+    payload_end = 0;
+    record_count = 0;
+
+    uint8_t header[HEADER_SIZE] = {};
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    store_le(header + 8, HEADER_SIZE, 4);
+    store_le(header + 12, RECORD_SIZE, 4);
+    store_le(header + 16, start_wall_ms, 8);
+    store_le(header + 24, fps_num, 4);
+    store_le(header + 28, fps_den, 4);
+    if (fwrite(header, sizeof(header), 1, index_file) != 1 || fflush(index_file) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void IndexWriter::close()
+{
+    if (index_file) fclose(index_file);
+    if (payload_file) fclose(payload_file);
+    index_file = nullptr;
+    payload_file = nullptr;
+}
+
+void IndexWriter::pause(uint64_t now_ns)
+{
+    if (!pause_start_ns) pause_start_ns = std::max<uint64_t>(now_ns, 1);
+}
+
+void IndexWriter::resume(uint64_t now_ns)
+{
+    if (!pause_start_ns) return;
+    if (now_ns > pause_start_ns) paused_ns += now_ns - pause_start_ns;
+    pause_start_ns = 0;
+}
+
+bool IndexWriter::append(uint64_t event_ns, uint64_t wall_ms, const char *type, const char *payload, size_t size,
+                         uint32_t flags)
+{
+    if (!index_file || size > UINT32_MAX) return false;
+
+    // Events during a pause land where the recording stopped
+    if (pause_start_ns) {
+        event_ns = std::min(event_ns, pause_start_ns);
+        flags |= FLAG_PAUSED;
+    }
+    const uint64_t elapsed_ns = event_ns > start_ns + paused_ns ? event_ns - start_ns - paused_ns : 0;
+    last_time_ns = std::max(last_time_ns, elapsed_ns);
+
+    // The payload goes out first, so that a reader never finds a record
+    // whose payload is not there yet
+    if (size && (fwrite(payload, 1, size, payload_file) != size || fflush(payload_file) != 0)) return false;
+
+    uint8_t record[RECORD_SIZE] = {};
+    store_le(record, last_time_ns, 8);
+    store_le(record + 8, wall_ms, 8);
+    store_le(record + 16, payload_end, 8);
+    store_le(record + 24, (uint32_t)size, 4);
+    store_le(record + 28, flags, 4);
+    memcpy(record + 32, type, strnlen(type, TYPE_SIZE));
+    payload_end += size;
+
+    if (fwrite(record, sizeof(record), 1, index_file) != 1 || fflush(index_file) != 0) return false;
+    record_count++;
+    return true;
+}
+
+bool IndexView::open(const uint8_t *data, size_t size)
+{
+    records = nullptr;
+    count = 0;
+    if (size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) return false;
+
+    // Later versions may grow the header and the records; the fields read
+    // here stay where they are
+    const size_t header_size = (size_t)load_le(data + 8, 4);
+    record_size = (size_t)load_le(data + 12, 4);
+    if (header_size < HEADER_SIZE || header_size > size || record_size < RECORD_SIZE) return false;
+
+    start_wall = load_le(data + 16, 8);
+    fps_numerator = (uint32_t)load_le(data + 24, 4);
+    fps_denominator = (uint32_t)load_le(data + 28, 4);
+    records = data + header_size;
+    count = (size - header_size) / record_size;
+    return true;
+}
+
+uint64_t IndexView::time_ns(size_t index) const
+{
+    return load_le(records + index * record_size, 8);
+}
+
+IndexRecord IndexView::record(size_t index) const
+{
+    const uint8_t *in = records + index * record_size;
+    IndexRecord record;
+    record.time_ns = load_le(in, 8);
+    record.wall_ms = load_le(in + 8, 8);
+    record.payload_offset = load_le(in + 16, 8);
+    record.payload_size = (uint32_t)load_le(in + 24, 4);
+    record.flags = (uint32_t)load_le(in + 28, 4);
+    const char *type = (const char *)in + 32;
+    record.type.assign(type, strnlen(type, TYPE_SIZE));
+    return record;
+}
+
+size_t IndexView::seek(uint64_t time) const
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (time_ns(mid) < time) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+} // namespace MeetingMindIndex
@@ -0,0 +1,125 @@
+/*
+MeetingMind Recording Index
+Sidecar files written next to a recording that map times in the recording
+to the meeting events that happened then, for seeking without scanning
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace MeetingMindIndex {
+
+// Two files sit next to <recording>, little-endian:
+//
+// <recording>.mmindex
+//   header  "MMINDEX1", uint32 header_size, uint32 record_size,
+//           uint64 start_wall_ms, uint32 fps_num, uint32 fps_den,
+//           zero padding to header_size
+//   record  uint64 time_ns, uint64 wall_ms, uint64 payload_offset,
+//           uint32 payload_size, uint32 flags, char type[32]
+//
+// <recording>.mmevents
+//   the events' messages back to back, each as it was received from or sent
+//   to the backend
+//
+// time_ns is the time into the recording, pauses excluded, so it matches
+// the recording's own timeline; dividing by 1e9 and multiplying by
+// fps_num / fps_den gives the frame. Records never go back in time, so the
+// record for any moment is a binary search away. type is NUL-padded and not
+// terminated when all 32 bytes are used.
+//
+// Each payload is flushed before its record, so a record never points past
+// the end of .mmevents. Readers derive the record count from the file size
+// and ignore a record cut short by a crash; the files can be read, or
+// mapped, while the recording is still running.
+
+static constexpr size_t HEADER_SIZE = 64;
+static constexpr size_t RECORD_SIZE = 64;
+static constexpr size_t TYPE_SIZE = 32;
+
+enum RecordFlags : uint32_t {
+    FLAG_MSGPACK = 1u << 0, // Payload is MessagePack rather than JSON
+    FLAG_LOCAL = 1u << 1,   // Detected by the plugin rather than sent by the backend
+    FLAG_PAUSED = 1u << 2,  // Happened while the recording was paused
+};
+
+struct IndexRecord {
+    uint64_t time_ns = 0;
+    uint64_t wall_ms = 0;
+    uint64_t payload_offset = 0;
+    uint32_t payload_size = 0;
+    uint32_t flags = 0;
+    std::string type;
+};
+
+class IndexWriter {
+public:
+    IndexWriter() = default;
+    ~IndexWriter();
+    IndexWriter(const IndexWriter &) = delete;
+    IndexWriter &operator=(const IndexWriter &) = delete;
+
+    // Creates both files for the recording at recording_path. start is
+    // the os_gettime_ns() time of the recording's first frame.
+    bool open(const char *recording_path, uint64_t start, uint64_t start_wall_ms, uint32_t fps_num,
+              uint32_t fps_den);
+    void close();
+    bool is_open() const { return index_file != nullptr; }
+
+    // The recording's timeline stops between pause and resume
+    void pause(uint64_t now_ns);
+    void resume(uint64_t now_ns);
+
+    // event_ns is an os_gettime_ns() timestamp. Events from before the
+    // recording started, or out of order, are placed at the latest time
+    // already written.
+    bool append(uint64_t event_ns, uint64_t wall_ms, const char *type, const char *payload, size_t size,
+                uint32_t flags);
+
+    uint64_t records() const { return record_count; }
+    const std::string &index_path() const { return path; }
+
+private:
+    FILE *index_file = nullptr;
+    FILE *payload_file = nullptr;
+    std::string path;
+    uint64_t start_ns = 0;
+    uint64_t paused_ns = 0;      // Total of finished pauses
+    uint64_t pause_start_ns = 0; // Non-zero while paused
+    uint64_t last_time_ns = 0;
+    uint64_t payload_end = 0;
+    uint64_t record_count = 0;
+};
+
+// Reads an index from memory, typically the mapped .mmindex file. The
+// buffer must outlive the view.
+class IndexView {
+public:
+    // Fails if the buffer does not start with an index header
+    bool open(const uint8_t *data, size_t size);
+
+    size_t size() const { return count; }
+    uint64_t start_wall_ms() const { return start_wall; }
+    uint32_t fps_num() const { return fps_numerator; }
+    uint32_t fps_den() const { return fps_denominator; }
+
+    uint64_t time_ns(size_t index) const;
+    IndexRecord record(size_t index) const;
+
+    // First record at or after time, or size() if there is none
+    size_t seek(uint64_t time) const;
+
+private:
+    const uint8_t *records = nullptr;
+    size_t count = 0;
+    size_t record_size = RECORD_SIZE;
+    uint64_t start_wall = 0;
+    uint32_t fps_numerator = 0;
+    uint32_t fps_denominator = 0;
+};
+
+} // namespace MeetingMindIndex
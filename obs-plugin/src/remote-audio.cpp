@@ -0,0 +1,246 @@
+/*
+MeetingMind Remote Audio
+OBS audio source that plays a feed of network audio from the backend, such
+as a remote participant or an interpreter, through a jitter buffer
+*/
+
+#include "remote-audio.hpp"
+
+#include "jitter-buffer.hpp"
+
+#include <obs-module.h>
+#include <util/platform.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace MeetingMindRemoteAudio {
+
+namespace {
+
+using MeetingMindAudio::JitterBuffer;
+
+const char *SOURCE_ID = "meetingmind_remote_audio";
+
+// Playout hands OBS 10 ms at a time
+const uint64_t TICK_NS = 10000000;
+const uint32_t TICKS_PER_SECOND = 100;
+
+// Behind by this many ticks, playout stops trying to catch up
+const uint64_t MAX_LAG_TICKS = 10;
+
+struct RemoteAudio {
+    obs_source_t *source = nullptr;
+    int feed = -1;
+    JitterBuffer buffer;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    explicit RemoteAudio(const MeetingMindAudio::JitterParams &params) : buffer(params) {}
+};
+
+// Which source plays each feed; push_frame holds the lock while it inserts,
+// so a source is never destroyed under it
+std::mutex feeds_mutex;
+RemoteAudio *feeds[MAX_FEEDS] = {};
+
+uint32_t load_u32(const uint8_t *in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)in[i] << (8 * i);
+    return value;
+}
+
+uint64_t load_u64(const uint8_t *in)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+MeetingMindAudio::JitterParams params_from_settings(obs_data_t *settings)
+{
+    MeetingMindAudio::JitterParams params;
+    params.min_delay_ms = (uint32_t)obs_data_get_int(settings, "min_delay_ms");
+    params.max_delay_ms = (uint32_t)std::max<long long>(obs_data_get_int(settings, "max_delay_ms"),
+                                                        params.min_delay_ms);
+    params.start_delay_ms = std::min(std::max(params.start_delay_ms, params.min_delay_ms), params.max_delay_ms);
+    return params;
+}
+
+void attach_feed(RemoteAudio *remote, int feed)
+{
+    std::lock_guard<std::mutex> lock(feeds_mutex);
+    if (remote->feed >= 0 && feeds[remote->feed] == remote) feeds[remote->feed] = nullptr;
+    remote->feed = -1;
+    if (feed < 0 || feed >= (int)MAX_FEEDS) return;
+    if (feeds[feed]) {
+        blog(LOG_WARNING, "MeetingMind: Remote audio feed %d already plays through '%s'", feed,
+             obs_source_get_name(feeds[feed]->source));
+        return;
+    }
+    feeds[feed] = remote;
+    remote->feed = feed;
+}
+
+// Playout thread: one block per tick, timestamped by the samples played
+// so far, so OBS sees an unbroken stream at the feed's own rate
+void playout_loop(RemoteAudio *remote)
+{
+    float storage[JitterBuffer::MAX_CHANNELS][JitterBuffer::MAX_PACKET_FRAMES];
+    float *planes[JitterBuffer::MAX_CHANNELS];
+    for (size_t c = 0; c < JitterBuffer::MAX_CHANNELS; c++) planes[c] = storage[c];
+
+    bool playing = false;
+    uint32_t playing_rate = 0;
+    uint64_t base_ts = 0;
+    uint64_t frames_out = 0;
+    uint32_t carry = 0; // Frames owed from earlier ticks, in 1/TICKS_PER_SECOND frames
+    uint64_t next_tick = os_gettime_ns();
+
+    while (remote->running.load(std::memory_order_acquire)) {
+        next_tick += TICK_NS;
+        os_sleepto_ns(next_tick);
+        const uint64_t now = os_gettime_ns();
+        if (now > next_tick + MAX_LAG_TICKS * TICK_NS) next_tick = now;
+
+        const uint32_t rate = remote->buffer.sample_rate();
+        const size_t channels = remote->buffer.channels();
+        // Rates that are not a multiple of the tick rate, such as 22050 and
+        // 11025 Hz, play the odd frame on some ticks so that no time is lost
+        const bool continuing = playing && rate == playing_rate;
+        const uint32_t due = rate + (continuing ? carry : 0);
+        const size_t frames = due / TICKS_PER_SECOND;
+        if (!frames || frames > JitterBuffer::MAX_PACKET_FRAMES || !remote->buffer.read(planes, frames, now)) {
+            playing = false;
+            continue;
+        }
+        carry = due % TICKS_PER_SECOND;
+        if (!continuing) {
+            playing = true;
+            playing_rate = rate;
+            base_ts = now;
+            frames_out = 0;
+        }
+
+        struct obs_source_audio audio = {};
+        for (size_t c = 0; c < channels; c++) audio.data[c] = (const uint8_t *)planes[c];
+        audio.frames = (uint32_t)frames;
+        audio.speakers = channels == 1 ? SPEAKERS_MONO : SPEAKERS_STEREO;
+        audio.format = AUDIO_FORMAT_FLOAT_PLANAR;
+        audio.samples_per_sec = rate;
+        audio.timestamp = base_ts + frames_out * 1000000000ull / rate;
+        obs_source_output_audio(remote->source, &audio);
+        frames_out += frames;
+    }
+}
+
+const char *source_get_name(void *)
+{
+    return "MeetingMind Remote Audio";
+}
+
+void source_get_defaults(obs_data_t *settings)
+{
+    const MeetingMindAudio::JitterParams params;
+    obs_data_set_default_int(settings, "feed", 0);
+    obs_data_set_default_int(settings, "min_delay_ms", params.min_delay_ms);
+    obs_data_set_default_int(settings, "max_delay_ms", params.max_delay_ms);
+}
+
+obs_properties_t *source_get_properties(void *)
+{
+    obs_properties_t *props = obs_properties_create();
+    obs_properties_add_int(props, "feed", "Feed", 0, (int)MAX_FEEDS - 1, 1);
+    obs_properties_add_int(props, "min_delay_ms", "Minimum Delay (ms)", 10, 1000, 10);
+    obs_properties_add_int(props, "max_delay_ms", "Maximum Delay (ms)", 50, 2000, 10);
+    return props;
+}
+
+void *source_create(obs_data_t *settings, obs_source_t *source)
+{
+    RemoteAudio *remote = new RemoteAudio(params_from_settings(settings));
+    remote->source = source;
+    attach_feed(remote, (int)obs_data_get_int(settings, "feed"));
+    remote->running.store(true, std::memory_order_release);
+    remote->thread = std::thread(playout_loop, remote);
+    return remote;
+}
+
+void source_destroy(void *data)
+{
+    RemoteAudio *remote = (RemoteAudio *)data;
+    attach_feed(remote, -1);
+    remote->running.store(false, std::memory_order_release);
+    if (remote->thread.joinable()) remote->thread.join();
+
+    const MeetingMindAudio::JitterStats stats = remote->buffer.stats();
+    blog(LOG_INFO,
+         "MeetingMind: Remote audio '%s' played %llu packets; %llu lost, %llu late, %llu duplicate, "
+         "%llu skipped, %llu underruns, jitter %.1f ms",
+         obs_source_get_name(remote->source), (unsigned long long)stats.packets, (unsigned long long)stats.lost,
+         (unsigned long long)stats.late, (unsigned long long)stats.duplicates, (unsigned long long)stats.discarded,
+         (unsigned long long)stats.underruns, stats.jitter_ms);
+    delete remote;
+}
+
+void source_update(void *data, obs_data_t *settings)
+{
+    RemoteAudio *remote = (RemoteAudio *)data;
+    remote->buffer.set_params(params_from_settings(settings));
+    const int feed = (int)obs_data_get_int(settings, "feed");
+    if (feed != remote->feed) {
+        attach_feed(remote, feed);
+        remote->buffer.reset();
+    }
+}
+
+} // namespace
+
+void register_remote_audio_source()
+{
+    struct obs_source_info info = {};
+    info.id = SOURCE_ID;
+    info.type = OBS_SOURCE_TYPE_INPUT;
+    info.output_flags = OBS_SOURCE_AUDIO;
+    info.get_name = source_get_name;
+    info.create = source_create;
+    info.destroy = source_destroy;
+    info.update = source_update;
+    info.get_defaults = source_get_defaults;
+    info.get_properties = source_get_properties;
+    info.icon_type = OBS_ICON_TYPE_AUDIO_OUTPUT;
+    obs_register_source(&info);
+}
+
+bool push_frame(const uint8_t *frame, size_t size, uint64_t received_ns)
+{
+    if (size < FRAME_HEADER_SIZE || memcmp(frame, FRAME_MAGIC, sizeof(FRAME_MAGIC)) != 0) return false;
+
+    const uint32_t sequence = load_u32(frame + 4);
+    const uint64_t pts = load_u64(frame + 8);
+    const uint32_t sample_rate = load_u32(frame + 16);
+    const size_t channels = frame[20];
+    const size_t feed = frame[21];
+    if (!channels || channels > JitterBuffer::MAX_CHANNELS || feed >= MAX_FEEDS) return false;
+
+    const size_t payload = size - FRAME_HEADER_SIZE;
+    const size_t frames = payload / (channels * sizeof(int16_t));
+    if (payload % (channels * sizeof(int16_t)) || frames > JitterBuffer::MAX_PACKET_FRAMES) return false;
+
+    // The payload follows a 24-byte header in the frame, so copy it out
+    // rather than read it in place
+    int16_t samples[JitterBuffer::MAX_CHANNELS * JitterBuffer::MAX_PACKET_FRAMES];
+    memcpy(samples, frame + FRAME_HEADER_SIZE, payload);
+
+    std::lock_guard<std::mutex> lock(feeds_mutex);
+    RemoteAudio *remote = feeds[feed];
+    if (!remote) return true;
+    return remote->buffer.insert(sequence, pts, sample_rate, channels, samples, frames, received_ns) !=
+           MeetingMindAudio::InsertResult::Invalid;
+}
+
+} // namespace MeetingMindRemoteAudio
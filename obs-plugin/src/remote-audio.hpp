@@ -0,0 +1,37 @@
+/*
+MeetingMind Remote Audio
+OBS audio source that plays a feed of network audio from the backend, such
+as a remote participant or an interpreter, through a jitter buffer
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MeetingMindRemoteAudio {
+
+static constexpr size_t MAX_FEEDS = 8;
+
+// Binary frame: a 24-byte little-endian header followed by interleaved
+// signed 16-bit PCM
+//   0  "MMPA"
+//   4  u32 sequence, consecutive per feed
+//   8  u64 pts, in samples at the frame's sample rate
+//   16 u32 sample rate
+//   20 u8 channels, 1 or 2
+//   21 u8 feed, 0 to MAX_FEEDS - 1
+//   22 u16 reserved, 0
+static constexpr char FRAME_MAGIC[4] = {'M', 'M', 'P', 'A'};
+static constexpr size_t FRAME_HEADER_SIZE = 24;
+
+// Registers the "MeetingMind Remote Audio" source type. Call once from
+// obs_module_load.
+void register_remote_audio_source();
+
+// Network thread. Queues one frame for the source playing its feed; frames
+// for a feed with no source are dropped. Returns false if the frame is
+// malformed.
+bool push_frame(const uint8_t *frame, size_t size, uint64_t received_ns);
+
+} // namespace MeetingMindRemoteAudio
@@ -0,0 +1,398 @@
+/*
+MeetingMind Resampler
+Streaming polyphase downmix and sample rate conversion of planar float
+audio to mono, with vectorized filter kernels
+*/
+
+#include "resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEETINGMIND_RESAMPLER_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MEETINGMIND_RESAMPLER_NEON 1
+#endif
+
+// AVX2 is not part of the baseline the plugin is built for, so its kernel is
+// compiled for that target alone and only chosen after asking the CPU
+#if defined(MEETINGMIND_RESAMPLER_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MEETINGMIND_RESAMPLER_AVX2 1
+#define MEETINGMIND_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#elif defined(MEETINGMIND_RESAMPLER_SSE2) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#define MEETINGMIND_RESAMPLER_AVX2 1
+#define MEETINGMIND_TARGET_AVX2
+#endif
+
+namespace MeetingMindAudio {
+
+namespace {
+
+constexpr size_t TAPS = Resampler::TAPS_PER_PHASE;
+
+// Filter edge as a fraction of the lower of the two rates: the response is
+// half way down at 6.9 kHz for a 16 kHz output and fully down by 8 kHz
+constexpr double CUTOFF = 0.43;
+// Kaiser window shape for about 70 dB of stopband attenuation
+constexpr double KAISER_BETA = 6.76;
+
+uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b) {
+        const uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function of the first kind, by its series
+double bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++) {
+        const double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+// Designs the up * TAPS tap prototype at the upsampled rate and deals it
+// into up rows, each reversed to run oldest input first
+std::vector<float> design_filter(uint32_t up, uint32_t down)
+{
+    const size_t length = TAPS * up;
+    const double center = (length - 1) / 2.0;
+    const double cutoff = CUTOFF / std::max(up, down); // Cycles per upsampled sample
+    const double pi = 3.14159265358979323846;
+
+    std::vector<double> prototype(length);
+    double sum = 0.0;
+    for (size_t n = 0; n < length; n++) {
+        const double t = n - center;
+        const double x = 2.0 * cutoff * t;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(pi * x) / (pi * x);
+        const double r = t / center;
+        const double window = bessel_i0(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(KAISER_BETA);
+        prototype[n] = 2.0 * cutoff * sinc * window;
+        sum += prototype[n];
+    }
+
+    // Unity gain at DC through every phase
+    const double gain = up / sum;
+    std::vector<float> rows(length);
+    for (uint32_t phase = 0; phase < up; phase++) {
+        for (size_t j = 0; j < TAPS; j++) {
+            rows[phase * TAPS + j] = (float)(prototype[(TAPS - 1 - j) * up + phase] * gain);
+        }
+    }
+    return rows;
+}
+
+// Where the kernels are in the stream. Output n reads the TAPS inputs
+// ending at position with the taps of phase; each output moves position on
+// by down / up inputs and phase by the remainder.
+struct FilterState {
+    const float *rows;
+    const float *inputs;
+    size_t fill;
+    size_t position;
+    uint32_t phase;
+    uint32_t up;
+    uint32_t step;
+    uint32_t remainder;
+};
+
+inline void advance(FilterState &state)
+{
+    state.position += state.step;
+    state.phase += state.remainder;
+    if (state.phase >= state.up) {
+        state.phase -= state.up;
+        state.position++;
+    }
+}
+
+size_t filter_scalar(FilterState &state, float *out)
+{
+    size_t count = 0;
+    while (state.position < state.fill) {
+        const float *x = state.inputs + state.position + 1 - TAPS;
+        const float *h = state.rows + state.phase * TAPS;
+        float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+        for (size_t i = 0; i < TAPS; i += 4) {
+            sum0 += h[i] * x[i];
+            sum1 += h[i + 1] * x[i + 1];
+            sum2 += h[i + 2] * x[i + 2];
+            sum3 += h[i + 3] * x[i + 3];
+        }
+        out[count++] = (sum0 + sum1) + (sum2 + sum3);
+        advance(state);
+    }
+    return count;
+}
+
+#if defined(MEETINGMIND_RESAMPLER_SSE2)
+
+size_t filter_sse2(FilterState &state, float *out)
+{
+    size_t count = 0;
+    while (state.position < state.fill) {
+        const float *x = state.inputs + state.position + 1 - TAPS;
+        const float *h = state.rows + state.phase * TAPS;
+        // Four accumulators keep four adds in flight
+        __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+        __m128 sum2 = _mm_setzero_ps(), sum3 = _mm_setzero_ps();
+        for (size_t i = 0; i < TAPS; i += 16) {
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(h + i), _mm_loadu_ps(x + i)));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(h + i + 4), _mm_loadu_ps(x + i + 4)));
+            sum2 = _mm_add_ps(sum2, _mm_mul_ps(_mm_loadu_ps(h + i + 8), _mm_loadu_ps(x + i + 8)));
+            sum3 = _mm_add_ps(sum3, _mm_mul_ps(_mm_loadu_ps(h + i + 12), _mm_loadu_ps(x + i + 12)));
+        }
+        __m128 sum = _mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        out[count++] = _mm_cvtss_f32(sum);
+        advance(state);
+    }
+    return count;
+}
+
+#endif
+
+#if defined(MEETINGMIND_RESAMPLER_AVX2)
+
+MEETINGMIND_TARGET_AVX2 size_t filter_avx2(FilterState &state, float *out)
+{
+    size_t count = 0;
+    while (state.position < state.fill) {
+        const float *x = state.inputs + state.position + 1 - TAPS;
+        const float *h = state.rows + state.phase * TAPS;
+        __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps(), sum3 = _mm256_setzero_ps();
+        for (size_t i = 0; i < TAPS; i += 32) {
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(h + i), _mm256_loadu_ps(x + i), sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(h + i + 8), _mm256_loadu_ps(x + i + 8), sum1);
+            sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(h + i + 16), _mm256_loadu_ps(x + i + 16), sum2);
+            sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(h + i + 24), _mm256_loadu_ps(x + i + 24), sum3);
+        }
+        const __m256 sum8 = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        out[count++] = _mm_cvtss_f32(sum);
+        advance(state);
+    }
+    return count;
+}
+
+bool cpu_has_avx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!fma || !osxsave || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif
+
+#if defined(MEETINGMIND_RESAMPLER_NEON)
+
+size_t filter_neon(FilterState &state, float *out)
+{
+    size_t count = 0;
+    while (state.position < state.fill) {
+        const float *x = state.inputs + state.position + 1 - TAPS;
+        const float *h = state.rows + state.phase * TAPS;
+        float32x4_t sum0 = vdupq_n_f32(0.0f), sum1 = vdupq_n_f32(0.0f);
+        float32x4_t sum2 = vdupq_n_f32(0.0f), sum3 = vdupq_n_f32(0.0f);
+        for (size_t i = 0; i < TAPS; i += 16) {
+            sum0 = vfmaq_f32(sum0, vld1q_f32(h + i), vld1q_f32(x + i));
+            sum1 = vfmaq_f32(sum1, vld1q_f32(h + i + 4), vld1q_f32(x + i + 4));
+            sum2 = vfmaq_f32(sum2, vld1q_f32(h + i + 8), vld1q_f32(x + i + 8));
+            sum3 = vfmaq_f32(sum3, vld1q_f32(h + i + 12), vld1q_f32(x + i + 12));
+        }
+        out[count++] = vaddvq_f32(vaddq_f32(vaddq_f32(sum0, sum1), vaddq_f32(sum2, sum3)));
+        advance(state);
+    }
+    return count;
+}
+
+#endif
+
+} // namespace
+
+Resampler::Resampler(uint32_t input_rate, uint32_t output_rate, size_t channels)
+    : Resampler(input_rate, output_rate, channels, best_kernel())
+{
+}
+
+Resampler::Resampler(uint32_t input_rate, uint32_t output_rate, size_t channels, ResamplerKernel kernel)
+    : input_rate_(std::max<uint32_t>(input_rate, 1)),
+      channels_(std::min(std::max<size_t>(channels, 1), MAX_CHANNELS)),
+      kernel_(kernel_supported(kernel) ? kernel : ResamplerKernel::Scalar),
+      history_(TAPS - 1 + MAX_BLOCK_FRAMES)
+{
+    // One output advances at most down / up inputs, which must stay within
+    // the history kept between blocks
+    const uint32_t divisor = gcd(input_rate_, std::max<uint32_t>(output_rate, 1));
+    up_ = std::max<uint32_t>(output_rate, 1) / divisor;
+    down_ = std::min<uint32_t>(input_rate_ / divisor, up_ * (uint32_t)TAPS);
+    coefficients_ = design_filter(up_, down_);
+    reset();
+}
+
+size_t Resampler::process(const float *const *planes, size_t frames, float *out)
+{
+    size_t produced = 0;
+    for (size_t done = 0; done < frames;) {
+        const size_t count = std::min(frames - done, MAX_BLOCK_FRAMES);
+        const float *block[MAX_CHANNELS];
+        for (size_t c = 0; c < channels_; c++) block[c] = planes[c] + done;
+        produced += process_block(block, count, out + produced);
+        done += count;
+    }
+    return produced;
+}
+
+size_t Resampler::process_block(const float *const *planes, size_t frames, float *out)
+{
+    // Downmix after the history; the average keeps a full-scale mono source
+    // at full scale whatever the channel count
+    float *mono = history_.data() + fill_;
+    if (channels_ == 1) {
+        memcpy(mono, planes[0], frames * sizeof(float));
+    } else {
+        const float scale = 1.0f / channels_;
+        for (size_t i = 0; i < frames; i++) {
+            float sum = planes[0][i];
+            for (size_t c = 1; c < channels_; c++) sum += planes[c][i];
+            mono[i] = sum * scale;
+        }
+    }
+    fill_ += frames;
+
+    FilterState state = {coefficients_.data(), history_.data(), fill_, position_, phase_,
+                         up_,                  down_ / up_,     down_ % up_};
+    size_t produced = 0;
+    switch (kernel_) {
+#if defined(MEETINGMIND_RESAMPLER_AVX2)
+    case ResamplerKernel::Avx2:
+        produced = filter_avx2(state, out);
+        break;
+#endif
+#if defined(MEETINGMIND_RESAMPLER_SSE2)
+    case ResamplerKernel::Sse2:
+        produced = filter_sse2(state, out);
+        break;
+#endif
+#if defined(MEETINGMIND_RESAMPLER_NEON)
+    case ResamplerKernel::Neon:
+        produced = filter_neon(state, out);
+        break;
+#endif
+    default:
+        produced = filter_scalar(state, out);
+        break;
+    }
+
+    // Keep only what the next output still reads
+    const size_t start = state.position + 1 - TAPS;
+    memmove(history_.data(), history_.data() + start, (fill_ - start) * sizeof(float));
+    fill_ -= start;
+    position_ = state.position - start;
+    phase_ = state.phase;
+    return produced;
+}
+
+size_t Resampler::max_output(size_t frames) const
+{
+    return (frames * up_ + down_ - 1) / down_ + 1;
+}
+
+uint64_t Resampler::latency_ns() const
+{
+    // The prototype's centre, (TAPS * up - 1) / 2 upsampled samples in
+    return (uint64_t)((TAPS * up_ - 1) * 1000000000ull / (2ull * up_ * input_rate_));
+}
+
+void Resampler::reset()
+{
+    // Silence before the first input, which lands at position
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    fill_ = TAPS - 1;
+    position_ = TAPS - 1;
+    phase_ = 0;
+}
+
+ResamplerKernel Resampler::best_kernel()
+{
+    for (ResamplerKernel kernel : {ResamplerKernel::Avx2, ResamplerKernel::Sse2, ResamplerKernel::Neon}) {
+        if (kernel_supported(kernel)) return kernel;
+    }
+    return ResamplerKernel::Scalar;
+}
+
+bool Resampler::kernel_supported(ResamplerKernel kernel)
+{
+    switch (kernel) {
+    case ResamplerKernel::Scalar:
+        return true;
+    case ResamplerKernel::Sse2:
+#if defined(MEETINGMIND_RESAMPLER_SSE2)
+        return true;
+#else
+        return false;
+#endif
+    case ResamplerKernel::Avx2:
+#if defined(MEETINGMIND_RESAMPLER_AVX2)
+    {
+        static const bool has_avx2 = cpu_has_avx2();
+        return has_avx2;
+    }
+#else
+        return false;
+#endif
+    case ResamplerKernel::Neon:
+#if defined(MEETINGMIND_RESAMPLER_NEON)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+const char *Resampler::kernel_name(ResamplerKernel kernel)
+{
+    switch (kernel) {
+    case ResamplerKernel::Scalar:
+        return "scalar";
+    case ResamplerKernel::Sse2:
+        return "sse2";
+    case ResamplerKernel::Avx2:
+        return "avx2";
+    case ResamplerKernel::Neon:
+        return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace MeetingMindAudio
@@ -0,0 +1,79 @@
+/*
+MeetingMind Resampler
+Streaming polyphase downmix and sample rate conversion of planar float
+audio to mono, with vectorized filter kernels
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MeetingMindAudio {
+
+enum class ResamplerKernel {
+    Scalar,
+    Sse2,
+    Avx2, // With FMA; picked at run time when the CPU has it
+    Neon,
+};
+
+// Converts any number of planar float channels at input_rate to mono at
+// output_rate through a Kaiser-windowed sinc filter split into one phase
+// per output position. The ratio is reduced to L/M; 48 kHz to 16 kHz is a
+// single phase taking every third input. State carries across calls, so a
+// stream can be fed in blocks of any size, and every output lags its input
+// by the same latency_ns(). All buffers are sized in the constructor.
+class Resampler {
+public:
+    static constexpr size_t TAPS_PER_PHASE = 96;
+    static constexpr size_t MAX_BLOCK_FRAMES = 1024;
+    static constexpr size_t MAX_CHANNELS = 8;
+
+    Resampler(uint32_t input_rate, uint32_t output_rate, size_t channels);
+    Resampler(uint32_t input_rate, uint32_t output_rate, size_t channels, ResamplerKernel kernel);
+
+    Resampler(const Resampler &) = delete;
+    Resampler &operator=(const Resampler &) = delete;
+
+    // Converts frames frames, one pointer per channel, into out, which must
+    // have room for max_output(frames) samples. Returns the samples written.
+    size_t process(const float *const *planes, size_t frames, float *out);
+
+    size_t max_output(size_t frames) const;
+
+    // Delay of the filter's centre, in nanoseconds
+    uint64_t latency_ns() const;
+
+    // Forgets the stream so far, as if newly constructed
+    void reset();
+
+    ResamplerKernel kernel() const { return kernel_; }
+
+    // The fastest kernel this CPU runs
+    static ResamplerKernel best_kernel();
+    static bool kernel_supported(ResamplerKernel kernel);
+    static const char *kernel_name(ResamplerKernel kernel);
+
+private:
+    size_t process_block(const float *const *planes, size_t frames, float *out);
+
+    const uint32_t input_rate_;
+    const size_t channels_;
+    ResamplerKernel kernel_;
+    uint32_t up_;   // L: phases
+    uint32_t down_; // M: input step per output, in phases
+
+    // Row p holds phase p's taps, reversed so that each output is a dot
+    // product with TAPS_PER_PHASE consecutive inputs
+    std::vector<float> coefficients_;
+
+    // The last TAPS_PER_PHASE - 1 mono inputs, then the current block
+    std::vector<float> history_;
+    size_t fill_;
+    size_t position_; // Newest input used by the next output
+    uint32_t phase_;
+};
+
+} // namespace MeetingMindAudio
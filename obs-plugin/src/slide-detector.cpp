@@ -0,0 +1,392 @@
+/*
+MeetingMind Slide Detector
+Reduces captured frames of a presentation source to small luma thumbnails
+and finds where the slides change, with vectorized reduction and block
+difference kernels
+*/
+
+#include "slide-detector.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEETINGMIND_SLIDES_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MEETINGMIND_SLIDES_NEON 1
+#endif
+
+namespace MeetingMindVideo {
+
+namespace {
+
+// BT.601 luma in 8-bit fixed point; the weights sum to 256
+const uint32_t LUMA_R = 77;
+const uint32_t LUMA_G = 150;
+const uint32_t LUMA_B = 29;
+
+// A thumbnail pixel sums 16 weighted pixels, so 256 * 16 in all
+const uint32_t REDUCE_SHIFT = 12;
+const uint32_t REDUCE_ROUND = 1u << (REDUCE_SHIFT - 1);
+
+void reduce_scalar(const uint8_t *rgba, uint32_t linesize, uint8_t *thumbnail)
+{
+    for (uint32_t y = 0; y < THUMB_HEIGHT; y++) {
+        const uint8_t *rows = rgba + (size_t)y * THUMB_SCALE * linesize;
+        for (uint32_t x = 0; x < THUMB_WIDTH; x++) {
+            uint32_t sum = 0;
+            for (uint32_t r = 0; r < THUMB_SCALE; r++) {
+                const uint8_t *pixel = rows + (size_t)r * linesize + (size_t)x * THUMB_SCALE * 4;
+                for (uint32_t c = 0; c < THUMB_SCALE; c++, pixel += 4) {
+                    sum += LUMA_R * pixel[0] + LUMA_G * pixel[1] + LUMA_B * pixel[2];
+                }
+            }
+            thumbnail[(size_t)y * THUMB_WIDTH + x] = (uint8_t)((sum + REDUCE_ROUND) >> REDUCE_SHIFT);
+        }
+    }
+}
+
+void block_differences_scalar(const uint8_t *a, const uint8_t *b, uint16_t *sums)
+{
+    for (uint32_t by = 0; by < BLOCKS_Y; by++) {
+        for (uint32_t bx = 0; bx < BLOCKS_X; bx++) {
+            uint32_t sum = 0;
+            for (uint32_t r = 0; r < BLOCK; r++) {
+                const size_t offset = (size_t)(by * BLOCK + r) * THUMB_WIDTH + bx * BLOCK;
+                for (uint32_t c = 0; c < BLOCK; c++) {
+                    sum += (uint32_t)std::abs((int)a[offset + c] - (int)b[offset + c]);
+                }
+            }
+            sums[by * BLOCKS_X + bx] = (uint16_t)sum;
+        }
+    }
+}
+
+#if defined(MEETINGMIND_SLIDES_SSE2)
+// Four thumbnail pixels at a time. Masking each RGBA pixel's 16-bit halves
+// gives R and B, and shifting gives G and A, as 16-bit lanes summed down the
+// four rows; one multiply-add per pair then weights them into a 32-bit luma
+// sum per source column, and a transpose adds the columns of each square.
+void reduce_sse2(const uint8_t *rgba, uint32_t linesize, uint8_t *thumbnail)
+{
+    const __m128i low_bytes = _mm_set1_epi16(0x00ff);
+    const __m128i weights_rb = _mm_set1_epi32((int)(LUMA_R | (LUMA_B << 16)));
+    const __m128i weights_ga = _mm_set1_epi32((int)LUMA_G);
+    const __m128i round = _mm_set1_epi32((int)REDUCE_ROUND);
+
+    for (uint32_t y = 0; y < THUMB_HEIGHT; y++) {
+        const uint8_t *rows = rgba + (size_t)y * THUMB_SCALE * linesize;
+        uint8_t *out = thumbnail + (size_t)y * THUMB_WIDTH;
+        for (uint32_t x = 0; x < THUMB_WIDTH; x += 4) {
+            __m128i rb[4];
+            __m128i ga[4];
+            for (int j = 0; j < 4; j++) {
+                rb[j] = _mm_setzero_si128();
+                ga[j] = _mm_setzero_si128();
+            }
+            for (uint32_t r = 0; r < THUMB_SCALE; r++) {
+                const uint8_t *row = rows + (size_t)r * linesize + (size_t)x * THUMB_SCALE * 4;
+                for (int j = 0; j < 4; j++) {
+                    const __m128i pixels = _mm_loadu_si128((const __m128i *)(row + 16 * j));
+                    rb[j] = _mm_add_epi16(rb[j], _mm_and_si128(pixels, low_bytes));
+                    ga[j] = _mm_add_epi16(ga[j], _mm_srli_epi16(pixels, 8));
+                }
+            }
+
+            __m128i luma[4];
+            for (int j = 0; j < 4; j++) {
+                luma[j] = _mm_add_epi32(_mm_madd_epi16(rb[j], weights_rb), _mm_madd_epi16(ga[j], weights_ga));
+            }
+            const __m128i ab =
+                _mm_add_epi32(_mm_unpacklo_epi32(luma[0], luma[1]), _mm_unpackhi_epi32(luma[0], luma[1]));
+            const __m128i cd =
+                _mm_add_epi32(_mm_unpacklo_epi32(luma[2], luma[3]), _mm_unpackhi_epi32(luma[2], luma[3]));
+            __m128i sums = _mm_add_epi32(_mm_unpacklo_epi64(ab, cd), _mm_unpackhi_epi64(ab, cd));
+            sums = _mm_srli_epi32(_mm_add_epi32(sums, round), REDUCE_SHIFT);
+
+            const __m128i words = _mm_packs_epi32(sums, sums);
+            const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+            memcpy(out + x, &bytes, 4);
+        }
+    }
+}
+
+// Two blocks per 16-byte row; the SAD instruction sums each 8-byte half
+// into its own 64-bit lane
+void block_differences_sse2(const uint8_t *a, const uint8_t *b, uint16_t *sums)
+{
+    for (uint32_t by = 0; by < BLOCKS_Y; by++) {
+        for (uint32_t bx = 0; bx < BLOCKS_X; bx += 2) {
+            __m128i sum = _mm_setzero_si128();
+            for (uint32_t r = 0; r < BLOCK; r++) {
+                const size_t offset = (size_t)(by * BLOCK + r) * THUMB_WIDTH + bx * BLOCK;
+                const __m128i va = _mm_loadu_si128((const __m128i *)(a + offset));
+                const __m128i vb = _mm_loadu_si128((const __m128i *)(b + offset));
+                sum = _mm_add_epi64(sum, _mm_sad_epu8(va, vb));
+            }
+            sums[by * BLOCKS_X + bx] = (uint16_t)_mm_cvtsi128_si32(sum);
+            sums[by * BLOCKS_X + bx + 1] = (uint16_t)_mm_extract_epi16(sum, 4);
+        }
+    }
+}
+#endif
+
+#if defined(MEETINGMIND_SLIDES_NEON)
+// Four thumbnail pixels at a time: a de-interleaving load splits 16 pixels
+// into channels, pairwise adds fold each square's columns and rows, and the
+// weighted sum is narrowed with rounding
+void reduce_neon(const uint8_t *rgba, uint32_t linesize, uint8_t *thumbnail)
+{
+    for (uint32_t y = 0; y < THUMB_HEIGHT; y++) {
+        const uint8_t *rows = rgba + (size_t)y * THUMB_SCALE * linesize;
+        uint8_t *out = thumbnail + (size_t)y * THUMB_WIDTH;
+        for (uint32_t x = 0; x < THUMB_WIDTH; x += 4) {
+            uint16x8_t red = vdupq_n_u16(0);
+            uint16x8_t green = vdupq_n_u16(0);
+            uint16x8_t blue = vdupq_n_u16(0);
+            for (uint32_t r = 0; r < THUMB_SCALE; r++) {
+                const uint8x16x4_t pixels = vld4q_u8(rows + (size_t)r * linesize + (size_t)x * THUMB_SCALE * 4);
+                red = vpadalq_u8(red, pixels.val[0]);
+                green = vpadalq_u8(green, pixels.val[1]);
+                blue = vpadalq_u8(blue, pixels.val[2]);
+            }
+            const uint16x4_t red4 = vget_low_u16(vpaddq_u16(red, red));
+            const uint16x4_t green4 = vget_low_u16(vpaddq_u16(green, green));
+            const uint16x4_t blue4 = vget_low_u16(vpaddq_u16(blue, blue));
+
+            uint32x4_t luma = vmull_n_u16(red4, (uint16_t)LUMA_R);
+            luma = vmlal_n_u16(luma, green4, (uint16_t)LUMA_G);
+            luma = vmlal_n_u16(luma, blue4, (uint16_t)LUMA_B);
+            const uint16x4_t words = vrshrn_n_u32(luma, REDUCE_SHIFT);
+            const uint8x8_t bytes = vmovn_u16(vcombine_u16(words, words));
+            vst1_lane_u32((uint32_t *)(out + x), vreinterpret_u32_u8(bytes), 0);
+        }
+    }
+}
+
+void block_differences_neon(const uint8_t *a, const uint8_t *b, uint16_t *sums)
+{
+    for (uint32_t by = 0; by < BLOCKS_Y; by++) {
+        for (uint32_t bx = 0; bx < BLOCKS_X; bx += 2) {
+            uint16x8_t sum = vdupq_n_u16(0);
+            for (uint32_t r = 0; r < BLOCK; r++) {
+                const size_t offset = (size_t)(by * BLOCK + r) * THUMB_WIDTH + bx * BLOCK;
+                sum = vpadalq_u8(sum, vabdq_u8(vld1q_u8(a + offset), vld1q_u8(b + offset)));
+            }
+            const uint64x2_t halves = vpaddlq_u32(vpaddlq_u16(sum));
+            sums[by * BLOCKS_X + bx] = (uint16_t)vgetq_lane_u64(halves, 0);
+            sums[by * BLOCKS_X + bx + 1] = (uint16_t)vgetq_lane_u64(halves, 1);
+        }
+    }
+}
+#endif
+
+} // namespace
+
+SlideDetector::SlideDetector(const SlideParams &params) : SlideDetector(params, best_kernel()) {}
+
+SlideDetector::SlideDetector(const SlideParams &params, SlideKernel kernel)
+    : params_(params),
+      kernel_(kernel_supported(kernel) ? kernel : SlideKernel::Scalar),
+      previous_(THUMB_SIZE),
+      current_slide_(THUMB_SIZE)
+{
+}
+
+void SlideDetector::reduce(const uint8_t *rgba, uint32_t linesize, uint8_t *thumbnail) const
+{
+    switch (kernel_) {
+#if defined(MEETINGMIND_SLIDES_SSE2)
+    case SlideKernel::Sse2:
+        reduce_sse2(rgba, linesize, thumbnail);
+        return;
+#endif
+#if defined(MEETINGMIND_SLIDES_NEON)
+    case SlideKernel::Neon:
+        reduce_neon(rgba, linesize, thumbnail);
+        return;
+#endif
+    default:
+        reduce_scalar(rgba, linesize, thumbnail);
+        return;
+    }
+}
+
+void SlideDetector::block_differences(const uint8_t *a, const uint8_t *b, uint16_t *sums) const
+{
+    switch (kernel_) {
+#if defined(MEETINGMIND_SLIDES_SSE2)
+    case SlideKernel::Sse2:
+        block_differences_sse2(a, b, sums);
+        return;
+#endif
+#if defined(MEETINGMIND_SLIDES_NEON)
+    case SlideKernel::Neon:
+        block_differences_neon(a, b, sums);
+        return;
+#endif
+    default:
+        block_differences_scalar(a, b, sums);
+        return;
+    }
+}
+
+uint32_t SlideDetector::changed_blocks(const uint8_t *a, const uint8_t *b) const
+{
+    uint16_t sums[BLOCK_COUNT];
+    block_differences(a, b, sums);
+    const uint32_t limit = params_.block_threshold * BLOCK * BLOCK;
+    return (uint32_t)std::count_if(std::begin(sums), std::end(sums), [limit](uint16_t sum) { return sum > limit; });
+}
+
+bool SlideDetector::blank(const uint8_t *thumbnail) const
+{
+    uint64_t sum = 0;
+    uint64_t squares = 0;
+    for (size_t i = 0; i < THUMB_SIZE; i++) {
+        sum += thumbnail[i];
+        squares += (uint32_t)thumbnail[i] * thumbnail[i];
+    }
+    // Variance times THUMB_SIZE squared, against the contrast squared
+    const uint64_t variance = squares * THUMB_SIZE - sum * sum;
+    const uint64_t contrast = params_.blank_contrast;
+    return variance < contrast * contrast * THUMB_SIZE * THUMB_SIZE;
+}
+
+SlideEvent SlideDetector::process(const uint8_t *thumbnail, uint64_t timestamp_ns)
+{
+    SlideEvent event;
+    if (!have_previous_) {
+        memcpy(previous_.data(), thumbnail, THUMB_SIZE);
+        have_previous_ = true;
+        still_since_ns_ = timestamp_ns;
+        return event;
+    }
+
+    const uint32_t motion = changed_blocks(thumbnail, previous_.data());
+    memcpy(previous_.data(), thumbnail, THUMB_SIZE);
+    if (motion > params_.still_blocks) {
+        still_since_ns_ = timestamp_ns;
+        return event;
+    }
+    const uint64_t still_ns = timestamp_ns - still_since_ns_;
+
+    if (blank(thumbnail)) {
+        // A short fade to black between slides is not the end
+        if (presenting_ && still_ns >= params_.blank_ms * 1000000ull) {
+            presenting_ = false;
+            event.type = SlideEventType::PresentationEnded;
+            event.slide = slide_;
+            event.timestamp_ns = still_since_ns_;
+        }
+        return event;
+    }
+    if (still_ns < params_.settle_ms * 1000000ull) return event;
+
+    uint32_t changed = (uint32_t)BLOCK_COUNT;
+    if (presenting_) {
+        changed = changed_blocks(thumbnail, current_slide_.data());
+        if (changed < params_.change_blocks) return event;
+        event.type = SlideEventType::SlideChanged;
+        slide_++;
+    } else {
+        event.type = SlideEventType::PresentationStarted;
+        presenting_ = true;
+        slide_ = 1;
+    }
+    memcpy(current_slide_.data(), thumbnail, THUMB_SIZE);
+    event.slide = slide_;
+    event.hash = difference_hash(thumbnail);
+    event.changed_blocks = changed;
+    event.timestamp_ns = still_since_ns_;
+    return event;
+}
+
+void SlideDetector::reset()
+{
+    have_previous_ = false;
+    still_since_ns_ = 0;
+    presenting_ = false;
+    slide_ = 0;
+}
+
+uint64_t SlideDetector::difference_hash(const uint8_t *thumbnail)
+{
+    const uint32_t columns = 9;
+    const uint32_t rows = 8;
+    uint32_t cells[rows][columns];
+    for (uint32_t r = 0; r < rows; r++) {
+        const uint32_t y0 = r * THUMB_HEIGHT / rows;
+        const uint32_t y1 = (r + 1) * THUMB_HEIGHT / rows;
+        for (uint32_t c = 0; c < columns; c++) {
+            const uint32_t x0 = c * THUMB_WIDTH / columns;
+            const uint32_t x1 = (c + 1) * THUMB_WIDTH / columns;
+            uint32_t sum = 0;
+            for (uint32_t y = y0; y < y1; y++) {
+                for (uint32_t x = x0; x < x1; x++) sum += thumbnail[(size_t)y * THUMB_WIDTH + x];
+            }
+            cells[r][c] = sum / ((y1 - y0) * (x1 - x0));
+        }
+    }
+
+    uint64_t hash = 0;
+    for (uint32_t r = 0; r < rows; r++) {
+        for (uint32_t c = 0; c + 1 < columns; c++) hash = (hash << 1) | (cells[r][c] < cells[r][c + 1] ? 1u : 0u);
+    }
+    return hash;
+}
+
+int SlideDetector::hash_distance(uint64_t a, uint64_t b)
+{
+    uint64_t bits = a ^ b;
+    int count = 0;
+    for (; bits; bits &= bits - 1) count++;
+    return count;
+}
+
+SlideKernel SlideDetector::best_kernel()
+{
+    for (SlideKernel kernel : {SlideKernel::Sse2, SlideKernel::Neon}) {
+        if (kernel_supported(kernel)) return kernel;
+    }
+    return SlideKernel::Scalar;
+}
+
+bool SlideDetector::kernel_supported(SlideKernel kernel)
+{
+    switch (kernel) {
+    case SlideKernel::Scalar:
+        return true;
+    case SlideKernel::Sse2:
+#if defined(MEETINGMIND_SLIDES_SSE2)
+        return true;
+#else
+        return false;
+#endif
+    case SlideKernel::Neon:
+#if defined(MEETINGMIND_SLIDES_NEON)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+const char *SlideDetector::kernel_name(SlideKernel kernel)
+{
+    switch (kernel) {
+    case SlideKernel::Scalar:
+        return "scalar";
+    case SlideKernel::Sse2:
+        return "sse2";
+    case SlideKernel::Neon:
+        return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace MeetingMindVideo
@@ -0,0 +1,117 @@
+/*
+MeetingMind Slide Detector
+Reduces captured frames of a presentation source to small luma thumbnails
+and finds where the slides change, with vectorized reduction and block
+difference kernels
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MeetingMindVideo {
+
+enum class SlideKernel {
+    Scalar,
+    Sse2,
+    Neon,
+};
+
+// Captured frames are RGBA at CAPTURE_WIDTH x CAPTURE_HEIGHT and reduce to
+// a THUMB_WIDTH x THUMB_HEIGHT luma thumbnail, each pixel the average of a
+// 4x4 square, compared in BLOCK x BLOCK blocks
+static constexpr uint32_t CAPTURE_WIDTH = 512;
+static constexpr uint32_t CAPTURE_HEIGHT = 288;
+static constexpr uint32_t THUMB_SCALE = 4;
+static constexpr uint32_t THUMB_WIDTH = CAPTURE_WIDTH / THUMB_SCALE;
+static constexpr uint32_t THUMB_HEIGHT = CAPTURE_HEIGHT / THUMB_SCALE;
+static constexpr size_t THUMB_SIZE = (size_t)THUMB_WIDTH * THUMB_HEIGHT;
+static constexpr uint32_t BLOCK = 8;
+static constexpr uint32_t BLOCKS_X = THUMB_WIDTH / BLOCK;
+static constexpr uint32_t BLOCKS_Y = THUMB_HEIGHT / BLOCK;
+static constexpr size_t BLOCK_COUNT = (size_t)BLOCKS_X * BLOCKS_Y;
+
+struct SlideParams {
+    uint32_t interval_ms = 250;   // Between captured frames
+    uint32_t settle_ms = 750;     // Content must hold still this long to count as a slide
+    uint32_t blank_ms = 2000;     // A blank source for this long ends the presentation
+    uint32_t block_threshold = 8; // Mean difference per pixel that marks a block as changed
+    uint32_t still_blocks = 2;    // Changed blocks tolerated between frames, for the pointer
+    uint32_t change_blocks = 3;   // Changed blocks against the current slide that make a new one
+    uint32_t blank_contrast = 6;  // Luma standard deviation below which the source is blank
+};
+
+enum class SlideEventType {
+    None,
+    PresentationStarted,
+    SlideChanged,
+    PresentationEnded,
+};
+
+struct SlideEvent {
+    SlideEventType type = SlideEventType::None;
+    uint32_t slide = 0;          // Counts slides from 1 for each presentation
+    uint64_t hash = 0;           // Difference hash of the slide, for matching it later
+    uint32_t changed_blocks = 0; // Against the previous slide
+    uint64_t timestamp_ns = 0;   // When the content first appeared, not when it settled
+};
+
+// Watches a stream of thumbnails sampled every interval_ms. A slide is
+// content that has held still for settle_ms; it is a new slide when enough
+// blocks differ from the last one. Video, scrolling and transitions never
+// hold still, so they make no events until they stop, and a moving pointer
+// stays under still_blocks.
+class SlideDetector {
+public:
+    explicit SlideDetector(const SlideParams &params = SlideParams());
+    SlideDetector(const SlideParams &params, SlideKernel kernel);
+
+    // Averages a CAPTURE_WIDTH x CAPTURE_HEIGHT RGBA frame, rows linesize
+    // bytes apart, into a thumbnail of THUMB_SIZE bytes
+    void reduce(const uint8_t *rgba, uint32_t linesize, uint8_t *thumbnail) const;
+
+    // Sums of absolute differences between two thumbnails, per block, row by
+    // row, into BLOCK_COUNT entries
+    void block_differences(const uint8_t *a, const uint8_t *b, uint16_t *sums) const;
+
+    SlideEvent process(const uint8_t *thumbnail, uint64_t timestamp_ns);
+
+    void set_params(const SlideParams &params) { params_ = params; }
+    const SlideParams &params() const { return params_; }
+
+    bool presenting() const { return presenting_; }
+    uint32_t slide() const { return slide_; }
+
+    // Forgets the frames so far; the next one starts over
+    void reset();
+
+    SlideKernel kernel() const { return kernel_; }
+
+    // 64-bit difference hash: each bit compares neighbouring cells of a 9x8
+    // grid of averages. Near-identical slides differ in few bits.
+    static uint64_t difference_hash(const uint8_t *thumbnail);
+    static int hash_distance(uint64_t a, uint64_t b);
+
+    // The fastest kernel this CPU runs
+    static SlideKernel best_kernel();
+    static bool kernel_supported(SlideKernel kernel);
+    static const char *kernel_name(SlideKernel kernel);
+
+private:
+    uint32_t changed_blocks(const uint8_t *a, const uint8_t *b) const;
+    bool blank(const uint8_t *thumbnail) const;
+
+    SlideParams params_;
+    SlideKernel kernel_;
+
+    std::vector<uint8_t> previous_;
+    std::vector<uint8_t> current_slide_;
+    bool have_previous_ = false;
+    uint64_t still_since_ns_ = 0;
+    bool presenting_ = false;
+    uint32_t slide_ = 0;
+};
+
+} // namespace MeetingMindVideo
@@ -0,0 +1,292 @@
+/*
+MeetingMind Slide Watch
+Renders one OBS source into a small texture a few times a second, reads it
+back and runs the slide detector on it, reporting new slides as they settle
+*/
+
+#include "slide-watch.hpp"
+
+#include <obs-module.h>
+#include <graphics/vec4.h>
+#include <util/platform.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MeetingMindSlides {
+
+namespace {
+
+using MeetingMindVideo::CAPTURE_HEIGHT;
+using MeetingMindVideo::CAPTURE_WIDTH;
+using MeetingMindVideo::SlideEvent;
+using MeetingMindVideo::SlideEventType;
+
+struct Watch {
+    // Guarded by watch_mutex
+    std::string source_name;
+    obs_weak_source_t *weak = nullptr;
+
+    SlideCallback callback = nullptr;
+    void *param = nullptr;
+
+    // Graphics thread only. Each sample is staged for reading back at the
+    // next one, by when the GPU has long finished the copy, so mapping it
+    // never stalls the render.
+    gs_texrender_t *texrender = nullptr;
+    gs_stagesurf_t *stage = nullptr;
+    bool staged = false;
+    uint64_t staged_ns = 0;
+    uint64_t next_sample_ns = 0;
+    MeetingMindVideo::SlideDetector detector;
+    std::vector<uint8_t> thumbnail = std::vector<uint8_t>(MeetingMindVideo::THUMB_SIZE);
+};
+
+Watch watch;
+std::mutex watch_mutex;
+std::atomic<bool> active{false};
+bool signals_connected = false;
+
+std::atomic<uint64_t> sample_count{0};
+std::atomic<uint64_t> busy_total_ns{0};
+std::atomic<uint64_t> event_count{0};
+
+// Caller holds watch_mutex. Showing the source keeps sources that only
+// render while visible rendering outside the program scene.
+void attach(obs_source_t *source)
+{
+    if (watch.weak) return;
+    watch.weak = obs_source_get_weak_source(source);
+    obs_source_inc_showing(source);
+}
+
+// Caller holds watch_mutex
+void detach(obs_source_t *source)
+{
+    obs_source_dec_showing(source);
+    obs_weak_source_release(watch.weak);
+    watch.weak = nullptr;
+}
+
+bool attached_to(obs_source_t *source)
+{
+    return watch.weak && obs_weak_source_references_source(watch.weak, source);
+}
+
+void on_source_create(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    if (watch.source_name == obs_source_get_name(source)) attach(source);
+}
+
+// The source is going away with its showing count, so only the handle is
+// dropped
+void on_source_destroy(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    if (!attached_to(source)) return;
+    obs_weak_source_release(watch.weak);
+    watch.weak = nullptr;
+}
+
+void on_source_remove(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    if (attached_to(source)) detach(source);
+}
+
+void on_source_rename(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    if (!source) return;
+
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    if (attached_to(source)) detach(source);
+    const char *new_name = calldata_string(cd, "new_name");
+    if (new_name && watch.source_name == new_name) attach(source);
+}
+
+void connect_signals(bool connect)
+{
+    signal_handler_t *handler = obs_get_signal_handler();
+    if (connect) {
+        signal_handler_connect(handler, "source_create", on_source_create, nullptr);
+        signal_handler_connect(handler, "source_destroy", on_source_destroy, nullptr);
+        signal_handler_connect(handler, "source_remove", on_source_remove, nullptr);
+        signal_handler_connect(handler, "source_rename", on_source_rename, nullptr);
+    } else {
+        signal_handler_disconnect(handler, "source_create", on_source_create, nullptr);
+        signal_handler_disconnect(handler, "source_destroy", on_source_destroy, nullptr);
+        signal_handler_disconnect(handler, "source_remove", on_source_remove, nullptr);
+        signal_handler_disconnect(handler, "source_rename", on_source_rename, nullptr);
+    }
+    signals_connected = connect;
+}
+
+void analyse(const uint8_t *thumbnail, uint64_t timestamp_ns)
+{
+    const SlideEvent event = watch.detector.process(thumbnail, timestamp_ns);
+    sample_count.fetch_add(1, std::memory_order_relaxed);
+    if (event.type == SlideEventType::None) return;
+    event_count.fetch_add(1, std::memory_order_relaxed);
+    if (watch.callback) watch.callback(watch.param, event);
+}
+
+// Graphics thread, once per rendered frame, inside the graphics context
+void on_main_render(void *, uint32_t, uint32_t)
+{
+    const uint64_t now = os_gettime_ns();
+    if (now < watch.next_sample_ns) return;
+    watch.next_sample_ns = now + watch.detector.params().interval_ms * 1000000ull;
+
+    if (watch.staged) {
+        uint8_t *data = nullptr;
+        uint32_t linesize = 0;
+        if (gs_stagesurface_map(watch.stage, &data, &linesize)) {
+            watch.detector.reduce(data, linesize, watch.thumbnail.data());
+            gs_stagesurface_unmap(watch.stage);
+            analyse(watch.thumbnail.data(), watch.staged_ns);
+        }
+        watch.staged = false;
+    }
+
+    obs_source_t *source = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex);
+        if (watch.weak) source = obs_weak_source_get_source(watch.weak);
+    }
+    const uint32_t width = source ? obs_source_get_width(source) : 0;
+    const uint32_t height = source ? obs_source_get_height(source) : 0;
+    if (!width || !height) {
+        // A missing or empty source shows nothing, which is how a
+        // presentation ends
+        if (source) obs_source_release(source);
+        memset(watch.thumbnail.data(), 0, watch.thumbnail.size());
+        analyse(watch.thumbnail.data(), now);
+        busy_total_ns.fetch_add(os_gettime_ns() - now, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!watch.texrender) watch.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+    if (!watch.stage) watch.stage = gs_stagesurface_create(CAPTURE_WIDTH, CAPTURE_HEIGHT, GS_RGBA);
+    if (watch.texrender && watch.stage) {
+        // The whole source, stretched to the capture size; the GPU does the
+        // first reduction and the detector the rest
+        gs_texrender_reset(watch.texrender);
+        if (gs_texrender_begin(watch.texrender, CAPTURE_WIDTH, CAPTURE_HEIGHT)) {
+            struct vec4 clear;
+            vec4_zero(&clear);
+            gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+            gs_ortho(0.0f, (float)width, 0.0f, (float)height, -100.0f, 100.0f);
+            gs_blend_state_push();
+            gs_blend_function(GS_BLEND_ONE, GS_BLEND_ZERO);
+            obs_source_video_render(source);
+            gs_blend_state_pop();
+            gs_texrender_end(watch.texrender);
+
+            gs_stage_texture(watch.stage, gs_texrender_get_texture(watch.texrender));
+            watch.staged = true;
+            watch.staged_ns = now;
+        }
+    }
+    obs_source_release(source);
+    busy_total_ns.fetch_add(os_gettime_ns() - now, std::memory_order_relaxed);
+}
+
+} // namespace
+
+void start_watch(const char *source_name, SlideCallback callback, void *param)
+{
+    stop_watch();
+
+    watch.callback = callback;
+    watch.param = param;
+    watch.detector.reset();
+    watch.staged = false;
+    watch.next_sample_ns = 0;
+    sample_count.store(0, std::memory_order_relaxed);
+    busy_total_ns.store(0, std::memory_order_relaxed);
+    event_count.store(0, std::memory_order_relaxed);
+
+    connect_signals(true);
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex);
+        watch.source_name = source_name;
+        obs_source_t *source = obs_get_source_by_name(source_name);
+        if (source) {
+            attach(source);
+            obs_source_release(source);
+        }
+    }
+
+    obs_add_main_render_callback(on_main_render, nullptr);
+    active.store(true, std::memory_order_release);
+    blog(LOG_INFO, "MeetingMind: Watching '%s' for slides (%ux%u capture, %s kernels)", source_name, CAPTURE_WIDTH,
+         CAPTURE_HEIGHT, MeetingMindVideo::SlideDetector::kernel_name(watch.detector.kernel()));
+}
+
+void stop_watch()
+{
+    if (!active.exchange(false, std::memory_order_acq_rel)) return;
+
+    // Once removed, the render callback is not running and will not run
+    // again, so its state is ours
+    obs_remove_main_render_callback(on_main_render, nullptr);
+    connect_signals(false);
+    {
+        std::lock_guard<std::mutex> lock(watch_mutex);
+        if (watch.weak) {
+            obs_source_t *source = obs_weak_source_get_source(watch.weak);
+            if (source) {
+                detach(source);
+                obs_source_release(source);
+            } else {
+                obs_weak_source_release(watch.weak);
+                watch.weak = nullptr;
+            }
+        }
+    }
+
+    obs_enter_graphics();
+    gs_stagesurface_destroy(watch.stage);
+    gs_texrender_destroy(watch.texrender);
+    obs_leave_graphics();
+    watch.stage = nullptr;
+    watch.texrender = nullptr;
+    watch.staged = false;
+    watch.callback = nullptr;
+    watch.param = nullptr;
+
+    const WatchStats stats = get_watch_stats();
+    blog(LOG_INFO, "MeetingMind: Slide watch of '%s' stopped after %llu frames, %llu events, %.1f us per frame",
+         watch.source_name.c_str(), (unsigned long long)stats.samples, (unsigned long long)stats.events,
+         stats.samples ? stats.busy_ns / 1000.0 / stats.samples : 0.0);
+}
+
+bool watch_active()
+{
+    return active.load(std::memory_order_acquire);
+}
+
+WatchStats get_watch_stats()
+{
+    WatchStats stats;
+    stats.samples = sample_count.load(std::memory_order_relaxed);
+    stats.busy_ns = busy_total_ns.load(std::memory_order_relaxed);
+    stats.events = event_count.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace MeetingMindSlides
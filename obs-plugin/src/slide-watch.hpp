@@ -0,0 +1,34 @@
+/*
+MeetingMind Slide Watch
+Renders one OBS source into a small texture a few times a second, reads it
+back and runs the slide detector on it, reporting new slides as they settle
+*/
+
+#pragma once
+
+#include "slide-detector.hpp"
+
+#include <cstdint>
+
+namespace MeetingMindSlides {
+
+struct WatchStats {
+    uint64_t samples = 0; // Frames read back and analysed
+    uint64_t busy_ns = 0; // Time spent on them in the render thread
+    uint64_t events = 0;
+};
+
+// Runs on the OBS graphics thread for every event. The event's timestamp is
+// on the os_gettime_ns clock.
+typedef void (*SlideCallback)(void *param, const MeetingMindVideo::SlideEvent &event);
+
+// Watches the named source, now or as soon as a source with that name
+// appears. The source is kept showing, so it renders even while it is not
+// in the program scene. A running watch is stopped first.
+void start_watch(const char *source_name, SlideCallback callback, void *param);
+void stop_watch();
+bool watch_active();
+
+WatchStats get_watch_stats();
+
+} // namespace MeetingMindSlides
@@ -0,0 +1,218 @@
+/*
+MeetingMind Source Cache
+Weak source and scene handles keyed by interned name, kept current by the
+global OBS source signals
+*/
+
+#include "source-cache.hpp"
+#include "event-registry.hpp"
+
+#include <util/platform.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MeetingMindSourceCache {
+
+namespace {
+
+struct CacheEntry {
+    std::string name;
+    obs_weak_source_t *weak = nullptr;
+    bool known_missing = false;
+};
+
+// Entries are only added, so an interned id stays valid for the lifetime of
+// the cache. The index maps the name hash to candidate ids.
+std::mutex cache_mutex;
+std::vector<CacheEntry> entries;
+std::unordered_multimap<uint64_t, uint32_t> name_index;
+bool signals_connected = false;
+
+std::atomic<uint64_t> hit_count{0};
+std::atomic<uint64_t> miss_count{0};
+std::atomic<uint64_t> total_lookup_ns{0};
+std::atomic<uint64_t> max_lookup_ns{0};
+
+// Caller holds cache_mutex
+int find_entry(std::string_view name)
+{
+    auto range = name_index.equal_range(MeetingMindDispatch::hash_name(name));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (entries[it->second].name == name) return (int)it->second;
+    }
+    return -1;
+}
+
+// Caller holds cache_mutex
+uint32_t intern(std::string_view name)
+{
+    const int existing = find_entry(name);
+    if (existing >= 0) return (uint32_t)existing;
+
+    const uint32_t id = (uint32_t)entries.size();
+    entries.push_back(CacheEntry{std::string(name)});
+    name_index.emplace(MeetingMindDispatch::hash_name(name), id);
+    return id;
+}
+
+// Caller holds cache_mutex
+void forget(CacheEntry &entry)
+{
+    if (entry.weak) {
+        obs_weak_source_release(entry.weak);
+        entry.weak = nullptr;
+    }
+    entry.known_missing = false;
+}
+
+void record_lookup(uint64_t start_ns, bool hit)
+{
+    const uint64_t elapsed = os_gettime_ns() - start_ns;
+    (hit ? hit_count : miss_count).fetch_add(1, std::memory_order_relaxed);
+    total_lookup_ns.fetch_add(elapsed, std::memory_order_relaxed);
+
+    uint64_t max = max_lookup_ns.load(std::memory_order_relaxed);
+    while (elapsed > max && !max_lookup_ns.compare_exchange_weak(max, elapsed, std::memory_order_relaxed)) {
+    }
+}
+
+// Signal callbacks can run on any thread. Only names the plugin has already
+// looked up are tracked, so unrelated sources cost one hash probe.
+
+void on_source_create(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    const char *name = source ? obs_source_get_name(source) : nullptr;
+    if (!name) return;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    const int id = find_entry(name);
+    if (id < 0) return;
+
+    forget(entries[id]);
+    entries[id].weak = obs_source_get_weak_source(source);
+}
+
+void on_source_destroy(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    const char *name = source ? obs_source_get_name(source) : nullptr;
+    if (!name) return;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    const int id = find_entry(name);
+    if (id < 0) return;
+
+    CacheEntry &entry = entries[id];
+    if (entry.weak && obs_weak_source_references_source(entry.weak, source)) {
+        forget(entry);
+    }
+}
+
+void on_source_rename(void *, calldata_t *cd)
+{
+    obs_source_t *source = (obs_source_t *)calldata_ptr(cd, "source");
+    const char *new_name = calldata_string(cd, "new_name");
+    const char *prev_name = calldata_string(cd, "prev_name");
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (prev_name) {
+        const int id = find_entry(prev_name);
+        if (id >= 0) forget(entries[id]);
+    }
+    if (new_name && source) {
+        const int id = find_entry(new_name);
+        if (id >= 0) {
+            forget(entries[id]);
+            entries[id].weak = obs_source_get_weak_source(source);
+        }
+    }
+}
+
+} // namespace
+
+void init()
+{
+    signal_handler_t *handler = obs_get_signal_handler();
+    signal_handler_connect(handler, "source_create", on_source_create, nullptr);
+    signal_handler_connect(handler, "source_destroy", on_source_destroy, nullptr);
+    signal_handler_connect(handler, "source_remove", on_source_destroy, nullptr);
+    signal_handler_connect(handler, "source_rename", on_source_rename, nullptr);
+    signals_connected = true;
+}
+
+void shutdown()
+{
+    if (signals_connected) {
+        signal_handler_t *handler = obs_get_signal_handler();
+        signal_handler_disconnect(handler, "source_create", on_source_create, nullptr);
+        signal_handler_disconnect(handler, "source_destroy", on_source_destroy, nullptr);
+        signal_handler_disconnect(handler, "source_remove", on_source_destroy, nullptr);
+        signal_handler_disconnect(handler, "source_rename", on_source_rename, nullptr);
+        signals_connected = false;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    for (CacheEntry &entry : entries) forget(entry);
+    entries.clear();
+    name_index.clear();
+}
+
+obs_source_t *acquire(const char *name)
+{
+    if (!name || !*name) return nullptr;
+
+    const uint64_t start = os_gettime_ns();
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        id = intern(name);
+        CacheEntry &entry = entries[id];
+
+        if (entry.weak) {
+            if (obs_source_t *source = obs_weak_source_get_source(entry.weak)) {
+                record_lookup(start, true);
+                return source;
+            }
+            forget(entry);
+        } else if (entry.known_missing) {
+            record_lookup(start, true);
+            return nullptr;
+        }
+    }
+
+    // The global lookup takes the OBS source list lock, which may be held
+    // while source signals fire, so it must not run under cache_mutex
+    obs_source_t *source = obs_get_source_by_name(name);
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        CacheEntry &entry = entries[id];
+        if (source) {
+            forget(entry);
+            entry.weak = obs_source_get_weak_source(source);
+        } else if (!entry.weak) {
+            entry.known_missing = true;
+        }
+    }
+
+    record_lookup(start, false);
+    return source;
+}
+
+Stats get_stats()
+{
+    Stats stats;
+    stats.hits = hit_count.load(std::memory_order_relaxed);
+    stats.misses = miss_count.load(std::memory_order_relaxed);
+    stats.lookups = stats.hits + stats.misses;
+    stats.total_ns = total_lookup_ns.load(std::memory_order_relaxed);
+    stats.max_ns = max_lookup_ns.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace MeetingMindSourceCache
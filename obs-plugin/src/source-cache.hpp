@@ -0,0 +1,30 @@
+/*
+MeetingMind Source Cache
+Weak source and scene handles keyed by interned name, kept current by the
+global OBS source signals
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <cstdint>
+
+namespace MeetingMindSourceCache {
+    struct Stats {
+        uint64_t lookups;
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t total_ns;
+        uint64_t max_ns;
+    };
+
+    void init();
+    void shutdown();
+
+    // Returns a new strong reference (release with obs_source_release) or
+    // nullptr if no source has this name. Names that were looked up and not
+    // found are remembered until a source with that name appears.
+    obs_source_t *acquire(const char *name);
+
+    Stats get_stats();
+}
@@ -0,0 +1,66 @@
+/*
+MeetingMind SPSC Queue
+Bounded lock-free single-producer/single-consumer queue
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#define MEETINGMIND_CACHE_LINE 64
+
+// Head and tail live on separate cache lines, and each side keeps a private
+// copy of the other side's index so that the shared atomics are only touched
+// when the cached view says the queue is full or empty.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer side
+    bool try_push(T &&item)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == Capacity) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == Capacity) return false;
+        }
+        slots_[tail & (Capacity - 1)] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool try_pop(T &item)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+        item = std::move(slots_[head & (Capacity - 1)]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently with either side
+    std::size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    alignas(MEETINGMIND_CACHE_LINE) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+
+    alignas(MEETINGMIND_CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+
+    alignas(MEETINGMIND_CACHE_LINE) std::array<T, Capacity> slots_{};
+};
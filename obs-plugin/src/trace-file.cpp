@@ -0,0 +1,129 @@
+/*
+MeetingMind Event Traces
+Append-only recordings of inbound WebSocket frames with their arrival times,
+for replaying real meeting traffic offline
+*/
+
+#include "trace-file.hpp"
+
+#include <cstring>
+
+namespace MeetingMindTrace {
+
+namespace {
+
+const char MAGIC[8] = {'M', 'M', 'T', 'R', 'A', 'C', 'E', '1'};
+const size_t RECORD_HEADER_SIZE = 16;
+
+// Largest frame a reader will accept; guards against reading garbage as a
+// multi-gigabyte allocation
+const uint32_t MAX_RECORD_SIZE = 64u << 20;
+
+void store_le(uint8_t *out, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+uint64_t load_le(const uint8_t *in, size_t bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+} // namespace
+
+TraceWriter::~TraceWriter()
+{
+    close();
+}
+
+bool TraceWriter::open(const char *path)
+{
+    close();
+
+    file = fopen(path, "wb");
+    if (!file) return false;
+
+    // Frames arrive in bursts; a large buffer keeps the write cost to a
+    // memcpy for all but one frame per burst
+    setvbuf(file, nullptr, _IOFBF, 1 << 16);
+
+    origin_ns = 0;
+    record_count = 0;
+    if (fwrite(MAGIC, sizeof(MAGIC), 1, file) != 1) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TraceWriter::close()
+{
+    if (!file) return;
+    fclose(file);
+    file = nullptr;
+}
+
+bool TraceWriter::append(uint64_t now_ns, bool binary, const char *data, size_t size)
+{
+    if (!file || size > MAX_RECORD_SIZE) return false;
+
+    if (record_count == 0) origin_ns = now_ns;
+
+    uint8_t header[RECORD_HEADER_SIZE] = {};
+    store_le(header, now_ns - origin_ns, 8);
+    store_le(header + 8, (uint32_t)size, 4);
+    header[12] = binary ? 1 : 0;
+
+    if (fwrite(header, sizeof(header), 1, file) != 1 || fwrite(data, 1, size, file) != size) {
+        return false;
+    }
+    record_count++;
+    return true;
+}
+
+TraceReader::~TraceReader()
+{
+    close();
+}
+
+bool TraceReader::open(const char *path)
+{
+    close();
+
+    file = fopen(path, "rb");
+    if (!file) return false;
+
+    char magic[sizeof(MAGIC)];
+    if (fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TraceReader::close()
+{
+    if (!file) return;
+    fclose(file);
+    file = nullptr;
+}
+
+bool TraceReader::next(TraceRecord &record)
+{
+    if (!file) return false;
+
+    uint8_t header[RECORD_HEADER_SIZE];
+    if (fread(header, sizeof(header), 1, file) != 1) return false;
+
+    const uint32_t size = (uint32_t)load_le(header + 8, 4);
+    if (size > MAX_RECORD_SIZE) return false;
+
+    record.arrival_ns = load_le(header, 8);
+    record.binary = header[12] != 0;
+    record.payload.resize(size);
+    return size == 0 || fread(&record.payload[0], 1, size, file) == size;
+}
+
+} // namespace MeetingMindTrace
@@ -0,0 +1,70 @@
+/*
+MeetingMind Event Traces
+Append-only recordings of inbound WebSocket frames with their arrival times,
+for replaying real meeting traffic offline
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace MeetingMindTrace {
+
+// File layout, little-endian:
+//   header  "MMTRACE1" (8 bytes)
+//   record  uint64 arrival_ns, uint32 size, uint8 binary, uint8[3] reserved,
+//           followed by size payload bytes
+// arrival_ns counts from the first frame of the trace. A record cut short by
+// a crash is ignored by the reader, so a trace is always readable up to the
+// last complete frame.
+
+struct TraceRecord {
+    uint64_t arrival_ns = 0;
+    bool binary = false;
+    std::string payload;
+};
+
+class TraceWriter {
+public:
+    TraceWriter() = default;
+    ~TraceWriter();
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    bool open(const char *path);
+    void close();
+    bool is_open() const { return file != nullptr; }
+
+    // now_ns is an os_gettime_ns() timestamp; the first append sets the
+    // trace's time origin
+    bool append(uint64_t now_ns, bool binary, const char *data, size_t size);
+
+    uint64_t records() const { return record_count; }
+
+private:
+    FILE *file = nullptr;
+    uint64_t origin_ns = 0;
+    uint64_t record_count = 0;
+};
+
+class TraceReader {
+public:
+    TraceReader() = default;
+    ~TraceReader();
+    TraceReader(const TraceReader &) = delete;
+    TraceReader &operator=(const TraceReader &) = delete;
+
+    // Fails if the file is missing or is not a trace
+    bool open(const char *path);
+    void close();
+
+    // False at the end of the trace or at a truncated record
+    bool next(TraceRecord &record);
+
+private:
+    FILE *file = nullptr;
+};
+
+} // namespace MeetingMindTrace
@@ -0,0 +1,170 @@
+/*
+MeetingMind Voice Activity
+Energy and spectral tilt voice activity detection per audio block, with an
+adaptive noise floor, onset/release hysteresis and a hangover
+*/
+
+#include "voice-activity.hpp"
+
+#include "audio-meter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MEETINGMIND_VOICE_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MEETINGMIND_VOICE_NEON 1
+#endif
+
+namespace MeetingMindAudio {
+
+namespace {
+
+float differences_scalar(const float *samples, size_t count, float previous, float sum)
+{
+    for (size_t i = 0; i < count; i++) {
+        const float difference = samples[i] - previous;
+        sum += difference * difference;
+        previous = samples[i];
+    }
+    return sum;
+}
+
+} // namespace
+
+#if defined(MEETINGMIND_VOICE_SSE2)
+
+float sum_squared_differences(const float *samples, size_t count, float previous)
+{
+    if (count == 0) return 0.0f;
+
+    // The first difference needs the previous block's last sample; after
+    // that each vector pairs samples[i..] with the unaligned samples[i - 1..]
+    const float first = samples[0] - previous;
+    __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+
+    size_t i = 1;
+    for (; i + 8 <= count; i += 8) {
+        const __m128 a = _mm_sub_ps(_mm_loadu_ps(samples + i), _mm_loadu_ps(samples + i - 1));
+        const __m128 b = _mm_sub_ps(_mm_loadu_ps(samples + i + 4), _mm_loadu_ps(samples + i + 3));
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(a, a));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(b, b));
+    }
+
+    alignas(16) float sums[4];
+    _mm_store_ps(sums, _mm_add_ps(sum0, sum1));
+    const float sum = first * first + (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    return differences_scalar(samples + i, count - i, samples[i - 1], sum);
+}
+
+#elif defined(MEETINGMIND_VOICE_NEON)
+
+float sum_squared_differences(const float *samples, size_t count, float previous)
+{
+    if (count == 0) return 0.0f;
+
+    const float first = samples[0] - previous;
+    float32x4_t sum0 = vdupq_n_f32(0.0f), sum1 = vdupq_n_f32(0.0f);
+
+    size_t i = 1;
+    for (; i + 8 <= count; i += 8) {
+        const float32x4_t a = vsubq_f32(vld1q_f32(samples + i), vld1q_f32(samples + i - 1));
+        const float32x4_t b = vsubq_f32(vld1q_f32(samples + i + 4), vld1q_f32(samples + i + 3));
+        sum0 = vmlaq_f32(sum0, a, a);
+        sum1 = vmlaq_f32(sum1, b, b);
+    }
+
+    const float sum = first * first + vaddvq_f32(vaddq_f32(sum0, sum1));
+    return differences_scalar(samples + i, count - i, samples[i - 1], sum);
+}
+
+#else
+
+float sum_squared_differences(const float *samples, size_t count, float previous)
+{
+    return differences_scalar(samples, count, previous, 0.0f);
+}
+
+#endif
+
+VoiceDetector::VoiceDetector(const VoiceParams &params)
+    : params_(params)
+{
+    reset();
+}
+
+void VoiceDetector::reset()
+{
+    active_ = false;
+    level_db_ = SILENCE_DB;
+    noise_floor_db_ = params_.min_level_db;
+    tilt_ = 0.0f;
+    hangover_left_ms_ = 0.0f;
+    stationary_ref_db_ = SILENCE_DB;
+    stationary_ms_ = 0.0f;
+}
+
+bool VoiceDetector::process(float mean_square, float mean_square_diff, float duration_ms, bool muted)
+{
+    if (muted || mean_square <= 0.0f) {
+        level_db_ = SILENCE_DB;
+        tilt_ = 0.0f;
+        stationary_ref_db_ = SILENCE_DB;
+        stationary_ms_ = 0.0f;
+    } else {
+        level_db_ = std::max(SILENCE_DB, 10.0f * std::log10(mean_square));
+        tilt_ = mean_square_diff / mean_square;
+
+        // Speech rises and falls with every syllable; a hum or a fan holds
+        // its level
+        if (std::fabs(level_db_ - stationary_ref_db_) <= params_.stationary_db) {
+            stationary_ms_ += duration_ms;
+        } else {
+            stationary_ref_db_ = level_db_;
+            stationary_ms_ = 0.0f;
+        }
+
+        // The floor follows quiet blocks down at once and creeps up slowly,
+        // more slowly still while someone is talking, so a steady background
+        // becomes the new floor without speech being absorbed into it. A
+        // background that appeared while the floor was low would take
+        // minutes to creep up to, so once it has held steady for long enough
+        // it becomes the floor outright.
+        if (level_db_ < noise_floor_db_) {
+            noise_floor_db_ = level_db_;
+        } else if (active_ && stationary_ms_ >= params_.max_stationary_ms) {
+            noise_floor_db_ = level_db_;
+        } else {
+            const float rate = active_ ? params_.active_floor_rise_db_per_s : params_.floor_rise_db_per_s;
+            noise_floor_db_ = std::min(level_db_, noise_floor_db_ + rate * duration_ms / 1000.0f);
+        }
+    }
+
+    const bool audible = level_db_ >= params_.min_level_db;
+    const float snr_db = level_db_ - noise_floor_db_;
+
+    if (!active_) {
+        if (audible && snr_db >= params_.onset_snr_db && tilt_ <= params_.max_tilt) {
+            active_ = true;
+            hangover_left_ms_ = params_.hangover_ms;
+            return true;
+        }
+        return false;
+    }
+
+    if (audible && snr_db >= params_.release_snr_db) {
+        hangover_left_ms_ = params_.hangover_ms;
+        return false;
+    }
+
+    hangover_left_ms_ -= duration_ms;
+    if (hangover_left_ms_ > 0.0f) return false;
+
+    active_ = false;
+    return true;
+}
+
+} // namespace MeetingMindAudio
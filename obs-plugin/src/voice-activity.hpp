@@ -0,0 +1,62 @@
+/*
+MeetingMind Voice Activity
+Energy and spectral tilt voice activity detection per audio block, with an
+adaptive noise floor, onset/release hysteresis and a hangover
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MeetingMindAudio {
+
+struct VoiceParams {
+    float onset_snr_db = 12.0f;   // Above the noise floor to start speaking
+    float release_snr_db = 6.0f;  // Below this the hangover starts counting
+    float min_level_db = -60.0f;  // Quieter blocks are never speech
+    float max_tilt = 1.0f;        // Noise-like spectra above this never start speech
+    float hangover_ms = 300.0f;   // Kept active this long after the level drops
+    float floor_rise_db_per_s = 3.0f;
+    float active_floor_rise_db_per_s = 0.3f;
+    float stationary_db = 3.0f;   // Level swings within this are not speech
+    float max_stationary_ms = 2000.0f; // Held this long while active, the level becomes the floor
+};
+
+// Sum of (x[i] - x[i - 1])^2 over the block, with previous as x[-1]. Uses
+// SSE2 or NEON where available.
+float sum_squared_differences(const float *samples, size_t count, float previous);
+
+// Tracks one source. Fed once per audio block from the thread that delivers
+// the source's audio; not thread safe.
+class VoiceDetector {
+public:
+    explicit VoiceDetector(const VoiceParams &params = VoiceParams());
+
+    void reset();
+
+    // mean_square and mean_square_diff are per sample, averaged over the
+    // block's channels. Muted blocks count as silence. Returns true when the
+    // block changed the active state.
+    bool process(float mean_square, float mean_square_diff, float duration_ms, bool muted);
+
+    bool active() const { return active_; }
+    float level_db() const { return level_db_; }
+    float noise_floor_db() const { return noise_floor_db_; }
+
+    // Difference energy over energy: near 0 for low voiced sounds, 2 for
+    // white noise
+    float tilt() const { return tilt_; }
+
+private:
+    VoiceParams params_;
+    bool active_;
+    float level_db_;
+    float noise_floor_db_;
+    float tilt_;
+    float hangover_left_ms_;
+    float stationary_ref_db_;
+    float stationary_ms_;
+};
+
+} // namespace MeetingMindAudio